@@ -42,6 +42,16 @@ BENCHMARK_DEFINE_F(AddArray, Value_Scalar)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(AddArray, Value_SIMD)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::add1, true);
+        sfz::add1<float>(1.1f, absl::MakeSpan(output));
+    }
+}
+
+BENCHMARK_DEFINE_F(AddArray, Value_AVX)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::add1, true);
@@ -58,6 +68,16 @@ BENCHMARK_DEFINE_F(AddArray, Value_Scalar_Unaligned)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(AddArray, Value_SIMD_Unaligned)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::add1, true);
+        sfz::add1<float>(1.1f, absl::MakeSpan(output).subspan(1));
+    }
+}
+
+BENCHMARK_DEFINE_F(AddArray, Value_AVX_Unaligned)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::add1, true);
@@ -74,6 +94,16 @@ BENCHMARK_DEFINE_F(AddArray, Scalar)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(AddArray, SIMD)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::add, true);
+        sfz::add<float>(input, absl::MakeSpan(output));
+    }
+}
+
+BENCHMARK_DEFINE_F(AddArray, AVX)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::add, true);
@@ -90,6 +120,16 @@ BENCHMARK_DEFINE_F(AddArray, Scalar_Unaligned)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(AddArray, SIMD_Unaligned)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::add, true);
+        sfz::add<float>(absl::MakeSpan(input).subspan(1), absl::MakeSpan(output).subspan(1));
+    }
+}
+
+BENCHMARK_DEFINE_F(AddArray, AVX_Unaligned)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::add, true);
@@ -99,10 +139,14 @@ BENCHMARK_DEFINE_F(AddArray, SIMD_Unaligned)(benchmark::State& state) {
 
 BENCHMARK_REGISTER_F(AddArray, Value_Scalar)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(AddArray, Value_SIMD)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(AddArray, Value_AVX)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(AddArray, Value_Scalar_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(AddArray, Value_SIMD_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(AddArray, Value_AVX_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(AddArray, Scalar)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(AddArray, SIMD)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(AddArray, AVX)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(AddArray, Scalar_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(AddArray, SIMD_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(AddArray, AVX_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_MAIN();
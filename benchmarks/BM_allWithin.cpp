@@ -39,6 +39,16 @@ BENCHMARK_DEFINE_F(WithinArray, ScalarFalse)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(WithinArray, SIMDFalse)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::allWithin, true);
+        sfz::allWithin<float>(input, 1.2f, 3.8f);
+    }
+}
+
+BENCHMARK_DEFINE_F(WithinArray, AVXFalse)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::allWithin, true);
@@ -55,6 +65,16 @@ BENCHMARK_DEFINE_F(WithinArray, ScalarTrue)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(WithinArray, SIMDTrue)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::allWithin, true);
+        sfz::allWithin<float>(input, 0.0f, 11.0f);
+    }
+}
+
+BENCHMARK_DEFINE_F(WithinArray, AVXTrue)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::allWithin, true);
@@ -65,6 +85,8 @@ BENCHMARK_DEFINE_F(WithinArray, SIMDTrue)(benchmark::State& state) {
 
 BENCHMARK_REGISTER_F(WithinArray, ScalarFalse)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(WithinArray, SIMDFalse)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(WithinArray, AVXFalse)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(WithinArray, ScalarTrue)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(WithinArray, SIMDTrue)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(WithinArray, AVXTrue)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_MAIN();
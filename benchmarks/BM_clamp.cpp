@@ -39,6 +39,16 @@ BENCHMARK_DEFINE_F(ClampArray, Scalar)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(ClampArray, SIMD)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::clampAll, true);
+        sfz::clampAll<float>(absl::MakeSpan(input), 1.2f, 3.8f);
+    }
+}
+
+BENCHMARK_DEFINE_F(ClampArray, AVX)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::clampAll, true);
@@ -49,4 +59,5 @@ BENCHMARK_DEFINE_F(ClampArray, SIMD)(benchmark::State& state) {
 
 BENCHMARK_REGISTER_F(ClampArray, Scalar)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(ClampArray, SIMD)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(ClampArray, AVX)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_MAIN();
@@ -49,6 +49,16 @@ BENCHMARK_DEFINE_F(CopyArray, Scalar)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(CopyArray, SIMD)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::copy, true);
+        sfz::copy<float>(input, absl::MakeSpan(output));
+    }
+}
+
+BENCHMARK_DEFINE_F(CopyArray, AVX)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::copy, true);
@@ -72,6 +82,16 @@ BENCHMARK_DEFINE_F(CopyArray, Scalar_Unaligned)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(CopyArray, SIMD_Unaligned)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::copy, true);
+        sfz::copy<float>(absl::MakeSpan(input).subspan(1), absl::MakeSpan(output).subspan(1));
+    }
+}
+
+BENCHMARK_DEFINE_F(CopyArray, AVX_Unaligned)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::copy, true);
@@ -82,7 +102,9 @@ BENCHMARK_DEFINE_F(CopyArray, SIMD_Unaligned)(benchmark::State& state) {
 BENCHMARK_REGISTER_F(CopyArray, StdCopy)->RangeMultiplier(4)->Range(1 << 4, 1 << 16);
 BENCHMARK_REGISTER_F(CopyArray, Scalar)->RangeMultiplier(4)->Range(1 << 4, 1 << 16);
 BENCHMARK_REGISTER_F(CopyArray, SIMD)->RangeMultiplier(4)->Range(1 << 4, 1 << 16);
+BENCHMARK_REGISTER_F(CopyArray, AVX)->RangeMultiplier(4)->Range(1 << 4, 1 << 16);
 BENCHMARK_REGISTER_F(CopyArray, StdCopy_Unaligned)->RangeMultiplier(4)->Range(1 << 4, 1 << 16);
 BENCHMARK_REGISTER_F(CopyArray, Scalar_Unaligned)->RangeMultiplier(4)->Range(1 << 4, 1 << 16);
 BENCHMARK_REGISTER_F(CopyArray, SIMD_Unaligned)->RangeMultiplier(4)->Range(1 << 4, 1 << 16);
+BENCHMARK_REGISTER_F(CopyArray, AVX_Unaligned)->RangeMultiplier(4)->Range(1 << 4, 1 << 16);
 BENCHMARK_MAIN();
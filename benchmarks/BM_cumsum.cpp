@@ -41,6 +41,16 @@ BENCHMARK_DEFINE_F(CumArray, Sum_Scalar)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(CumArray, Sum_SIMD)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::cumsum, true);
+        sfz::cumsum<float>(input, absl::MakeSpan(output));
+    }
+}
+
+BENCHMARK_DEFINE_F(CumArray, Sum_AVX)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::cumsum, true);
@@ -57,6 +67,16 @@ BENCHMARK_DEFINE_F(CumArray, Sum_Scalar_Unaligned)(benchmark::State& state) {
 }
 
 BENCHMARK_DEFINE_F(CumArray, Sum_SIMD_Unaligned)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::cumsum, true);
+        sfz::cumsum<float>(absl::MakeSpan(input).subspan(1), absl::MakeSpan(output).subspan(1));
+    }
+}
+
+BENCHMARK_DEFINE_F(CumArray, Sum_AVX_Unaligned)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state)
     {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::cumsum, true);
@@ -67,6 +87,8 @@ BENCHMARK_DEFINE_F(CumArray, Sum_SIMD_Unaligned)(benchmark::State& state) {
 
 BENCHMARK_REGISTER_F(CumArray, Sum_Scalar)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(CumArray, Sum_SIMD)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(CumArray, Sum_AVX)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(CumArray, Sum_Scalar_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(CumArray, Sum_SIMD_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(CumArray, Sum_AVX_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_MAIN();
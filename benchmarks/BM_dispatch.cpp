@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+// Measures the dispatch of dense MIDI streams to an engine holding many
+// voices: expression and pedal controllers at about 1 kHz, repeated note-offs,
+// and notes of groups which turn off other groups. The voices are not
+// rendered, so that only the dispatch is measured.
+
+#include "Synth.h"
+#include "Resources.h"
+#include "MidiState.h"
+#include <benchmark/benchmark.h>
+#include <ghc/fs_std.hpp>
+#include <string>
+
+// number of events per block of 1024 frames, close to 1 kHz at 48 kHz
+constexpr int eventsPerBlock { 32 };
+constexpr int blockSize { 1024 };
+
+class DispatchFixture : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) {
+        numVoices = static_cast<int>(state.range(0));
+        synth.setNumVoices(numVoices);
+        synth.setSamplesPerBlock(blockSize);
+
+        // two layers per key, in groups which turn each other off
+        std::string sfzText;
+        for (int layer = 0; layer < 2; ++layer) {
+            for (int group = 1; group <= 8; ++group) {
+                sfzText += "<group> group=" + std::to_string(group + 8 * layer)
+                    + " off_by=" + std::to_string(100 + group) + "\n";
+                for (int key = group - 1; key < 128; key += 8)
+                    sfzText += "<region> key=" + std::to_string(key) + " sample=*sine\n";
+            }
+        }
+        sfzText += "<group> group=101 <region> key=0 hikey=127 lovel=127 sample=*saw\n";
+        synth.loadSfzString(fs::current_path() / "dispatch.sfz", sfzText);
+
+        for (int key = 0; key < numVoices / 2 && key < 128; ++key)
+            synth.noteOn(0, key, 64);
+    }
+
+    void TearDown(const ::benchmark::State& /* state */) {
+    }
+
+    // Clear the events of the block, as rendering would
+    void endBlock() {
+        synth.getResources().getMidiState().advanceTime(blockSize);
+    }
+
+    sfz::Synth synth;
+    int numVoices { 0 };
+};
+
+BENCHMARK_DEFINE_F(DispatchFixture, ControlChanges)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (int i = 0; i < eventsPerBlock; ++i) {
+            const int delay = i * blockSize / eventsPerBlock;
+            synth.cc(delay, 11, i * 4);
+            synth.cc(delay, 1, 127 - i * 4);
+        }
+        synth.cc(0, 64, 127);
+        synth.cc(blockSize / 2, 64, 0);
+        endBlock();
+    }
+    state.counters["events/s"] = benchmark::Counter(
+        2 * eventsPerBlock + 2, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_DEFINE_F(DispatchFixture, NoteOffs)(benchmark::State& state) {
+    int key = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < eventsPerBlock; ++i) {
+            const int delay = i * blockSize / eventsPerBlock;
+            synth.noteOff(delay, key, 64);
+            key = (key + 1) % 128;
+        }
+        endBlock();
+    }
+    state.counters["events/s"] = benchmark::Counter(
+        eventsPerBlock, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Each note of the last group checks the off groups of all the voices;
+// the voices are turned off on the first iteration, but remain active since
+// they are not rendered
+BENCHMARK_DEFINE_F(DispatchFixture, OffGroups)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (int i = 0; i < eventsPerBlock; ++i) {
+            const int delay = i * blockSize / eventsPerBlock;
+            synth.noteOff(delay, 127, 127);
+            synth.noteOn(delay, 127, 127);
+        }
+        endBlock();
+    }
+    state.counters["events/s"] = benchmark::Counter(
+        2 * eventsPerBlock, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_REGISTER_F(DispatchFixture, ControlChanges)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK_REGISTER_F(DispatchFixture, NoteOffs)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK_REGISTER_F(DispatchFixture, OffGroups)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK_MAIN();
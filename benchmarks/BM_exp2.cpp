@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "SIMDHelpers.h"
+#include "SfzHelpers.h"
+#include "utility/Macros.h"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include <cmath>
+
+class Exp2Array : public benchmark::Fixture {
+public:
+  void SetUp(const ::benchmark::State& state) {
+    std::random_device rd { };
+    std::mt19937 gen { rd() };
+    // pitch envelopes of a couple of octaves, in cents
+    std::uniform_real_distribution<float> dist { -2400, 2400 };
+    input = std::vector<float>(state.range(0));
+    output = std::vector<float>(state.range(0));
+    std::generate(input.begin(), input.end(), [&]() { return dist(gen); });
+  }
+
+  void TearDown(const ::benchmark::State& state) {
+      UNUSED(state);
+  }
+
+  std::vector<float> input;
+  std::vector<float> output;
+};
+
+// The former per-sample conversion of the voices
+BENCHMARK_DEFINE_F(Exp2Array, CentsFactor)(benchmark::State& state) {
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < input.size(); ++i)
+            output[i] = 1.5f * sfz::centsFactor(input[i]);
+        benchmark::DoNotOptimize(output);
+    }
+}
+
+BENCHMARK_DEFINE_F(Exp2Array, Scalar)(benchmark::State& state) {
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::exp2, false);
+        sfz::applyGain1<float>(1.0f / 1200.0f, input, absl::MakeSpan(output));
+        sfz::exp2<float>(output, absl::MakeSpan(output));
+        sfz::applyGain1<float>(1.5f, output, absl::MakeSpan(output));
+        benchmark::DoNotOptimize(output);
+    }
+}
+
+BENCHMARK_DEFINE_F(Exp2Array, SIMD)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::exp2, true);
+        sfz::applyGain1<float>(1.0f / 1200.0f, input, absl::MakeSpan(output));
+        sfz::exp2<float>(output, absl::MakeSpan(output));
+        sfz::applyGain1<float>(1.5f, output, absl::MakeSpan(output));
+        benchmark::DoNotOptimize(output);
+    }
+}
+
+BENCHMARK_DEFINE_F(Exp2Array, AVX)(benchmark::State& state) {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
+    for (auto _ : state)
+    {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::exp2, true);
+        sfz::applyGain1<float>(1.0f / 1200.0f, input, absl::MakeSpan(output));
+        sfz::exp2<float>(output, absl::MakeSpan(output));
+        sfz::applyGain1<float>(1.5f, output, absl::MakeSpan(output));
+        benchmark::DoNotOptimize(output);
+    }
+}
+
+BENCHMARK_REGISTER_F(Exp2Array, CentsFactor)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(Exp2Array, Scalar)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(Exp2Array, SIMD)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(Exp2Array, AVX)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_MAIN();
@@ -141,9 +141,26 @@ BENCHMARK_DEFINE_F(FilterFixture, TwoPoleShelf_Faust)(benchmark::State& state) {
     }
 }
 
+// Modulated cutoff and Q, with the coefficients computed every N frames
+BENCHMARK_DEFINE_F(FilterFixture, TwoPoleModulated_Faust)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    sfz::Filter filter;
+    filter.init(sampleRate);
+    filter.setType(sfz::FilterType::kFilterLpf2p);
+    filter.setControlInterval(static_cast<unsigned>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto inputPtr = input.data();
+        auto outputPtr = output.data();
+        filter.processModulated(&inputPtr, &outputPtr, cutoff.data(), q.data(), pksh.data(), blockSize);
+    }
+    state.SetItemsProcessed(state.iterations() * blockSize);
+}
+
 BENCHMARK_REGISTER_F(FilterFixture, OnePole_VA)->RangeMultiplier(2)->Range(1, 1 << 8);
 BENCHMARK_REGISTER_F(FilterFixture, OnePole_Faust)->RangeMultiplier(2)->Range(1, 1 << 8);
 BENCHMARK_REGISTER_F(FilterFixture, TwoPole_Faust)->RangeMultiplier(2)->Range(1, 1 << 8);
 BENCHMARK_REGISTER_F(FilterFixture, TwoPoleShelf_Faust)->RangeMultiplier(2)->Range(1, 1 << 8);
+BENCHMARK_REGISTER_F(FilterFixture, TwoPoleModulated_Faust)->Arg(1)->Arg(4)->Arg(16);
 BENCHMARK_MAIN();
 
@@ -25,51 +25,98 @@ public:
         std::uniform_real_distribution<float> dist { -1.0f, 1.0f };
 
         const size_t numFramesIn = state.range(0);
-        inputBuffer = std::vector<float>(numFramesIn + 2 * sfz::config::excessFileFrames);
+        leftBuffer = std::vector<float>(numFramesIn + 2 * sfz::config::excessFileFrames);
+        rightBuffer = std::vector<float>(leftBuffer.size());
 
         // any ratio will do, compute time will be proportional
         static constexpr float ratio = 1.234;
 
         const size_t numFramesOut = static_cast<size_t>(std::ceil(numFramesIn * ratio));
-        input = absl::MakeSpan(inputBuffer).subspan(sfz::config::excessFileFrames, numFramesIn);
-        output = std::vector<float>(numFramesOut);
-        std::generate(input.begin(), input.end(), [&]() { return dist(gen); });
+        left = absl::MakeSpan(leftBuffer).subspan(sfz::config::excessFileFrames, numFramesIn);
+        right = absl::MakeSpan(rightBuffer).subspan(sfz::config::excessFileFrames, numFramesIn);
+        leftOutput = std::vector<float>(numFramesOut);
+        rightOutput = std::vector<float>(numFramesOut);
+        std::generate(left.begin(), left.end(), [&]() { return dist(gen); });
+        std::generate(right.begin(), right.end(), [&]() { return dist(gen); });
+
+        const float kOutToIn = static_cast<float>(numFramesIn) / numFramesOut;
+        indices = std::vector<int>(numFramesOut);
+        coeffs = std::vector<float>(numFramesOut);
+        for (size_t iOut = 0; iOut < numFramesOut; ++iOut) {
+            float posIn = iOut * kOutToIn;
+            indices[iOut] = static_cast<int>(posIn);
+            coeffs[iOut] = posIn - indices[iOut];
+        }
     }
 
     void TearDown(const ::benchmark::State& /* state */)
     {
     }
 
-    std::vector<float> inputBuffer;
-    absl::Span<float> input;
-    std::vector<float> output;
-
-    enum { excessFrames = 8 };
+    const bool avx2 { sfz::interpolatorsUseAVX2() };
+    std::vector<float> leftBuffer;
+    std::vector<float> rightBuffer;
+    absl::Span<float> left;
+    absl::Span<float> right;
+    std::vector<float> leftOutput;
+    std::vector<float> rightOutput;
+    std::vector<int> indices;
+    std::vector<float> coeffs;
 };
 
 template <sfz::InterpolatorModel M>
-static void doInterpolation(absl::Span<const float> input, absl::Span<float> output)
+static void doInterpolation(
+    absl::Span<const float> input, absl::Span<float> output,
+    absl::Span<const int> indices, absl::Span<const float> coeffs)
 {
-    const float kOutToIn = static_cast<float>(input.size()) / output.size();
-
-    for (size_t iOut = 0; iOut < output.size(); ++iOut) {
-        float posIn = iOut * kOutToIn;
-        unsigned dec = static_cast<int>(posIn);
-        float frac = posIn - dec;
-        output[iOut] = sfz::interpolate<M>(&input[dec], frac);
-    }
+    for (size_t iOut = 0; iOut < output.size(); ++iOut)
+        output[iOut] = sfz::interpolate<M>(&input[indices[iOut]], coeffs[iOut], 1.0f);
 }
 
-#define ADD_INTERPOLATOR_BENCHMARK(Type)                                \
-    BENCHMARK_DEFINE_F(Interpolators, Type)(benchmark::State& state)    \
-    {                                                                   \
-        ScopedFTZ ftz;                                                  \
-        for (auto _ : state) {                                          \
-            absl::Span<float> span = absl::MakeSpan(output);            \
-            doInterpolation<sfz::kInterpolator##Type>(input, span);     \
-        }                                                               \
-    }                                                                   \
-    BENCHMARK_REGISTER_F(Interpolators, Type)                           \
+#define ADD_INTERPOLATOR_BENCHMARK(Type)                                        \
+    BENCHMARK_DEFINE_F(Interpolators, Type)(benchmark::State& state)            \
+    {                                                                           \
+        ScopedFTZ ftz;                                                          \
+        for (auto _ : state) {                                                  \
+            doInterpolation<sfz::kInterpolator##Type>(                          \
+                left, absl::MakeSpan(leftOutput), indices, coeffs);             \
+        }                                                                       \
+    }                                                                           \
+    BENCHMARK_DEFINE_F(Interpolators, Type##_Block)(benchmark::State& state)    \
+    {                                                                           \
+        ScopedFTZ ftz;                                                          \
+        for (auto _ : state) {                                                  \
+            sfz::interpolateBlock<sfz::kInterpolator##Type, false>(             \
+                left.data(), nullptr, leftOutput.data(), nullptr,               \
+                indices.data(), coeffs.data(), nullptr, indices.size(), 1.0f, avx2); \
+        }                                                                       \
+    }                                                                           \
+    BENCHMARK_DEFINE_F(Interpolators, Type##_Stereo)(benchmark::State& state)   \
+    {                                                                           \
+        ScopedFTZ ftz;                                                          \
+        for (auto _ : state) {                                                  \
+            doInterpolation<sfz::kInterpolator##Type>(                          \
+                left, absl::MakeSpan(leftOutput), indices, coeffs);             \
+            doInterpolation<sfz::kInterpolator##Type>(                          \
+                right, absl::MakeSpan(rightOutput), indices, coeffs);           \
+        }                                                                       \
+    }                                                                           \
+    BENCHMARK_DEFINE_F(Interpolators, Type##_StereoBlock)(benchmark::State& state) \
+    {                                                                           \
+        ScopedFTZ ftz;                                                          \
+        for (auto _ : state) {                                                  \
+            sfz::interpolateBlock<sfz::kInterpolator##Type, false>(             \
+                left.data(), right.data(), leftOutput.data(), rightOutput.data(), \
+                indices.data(), coeffs.data(), nullptr, indices.size(), 1.0f, avx2); \
+        }                                                                       \
+    }                                                                           \
+    BENCHMARK_REGISTER_F(Interpolators, Type)                                   \
+        ->RangeMultiplier(4)->Range(1 << 4, 1 << 12);                           \
+    BENCHMARK_REGISTER_F(Interpolators, Type##_Block)                           \
+        ->RangeMultiplier(4)->Range(1 << 4, 1 << 12);                           \
+    BENCHMARK_REGISTER_F(Interpolators, Type##_Stereo)                          \
+        ->RangeMultiplier(4)->Range(1 << 4, 1 << 12);                           \
+    BENCHMARK_REGISTER_F(Interpolators, Type##_StereoBlock)                     \
         ->RangeMultiplier(4)->Range(1 << 4, 1 << 12);
 
 ADD_INTERPOLATOR_BENCHMARK(Nearest)
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+// Measures the time to load an instrument made of many distinct sample files,
+// depending on the number of files preloaded at once. The files are generated
+// in the temporary directory on the first run, and are likely to be served
+// from the system cache afterwards.
+
+#include "Synth.h"
+#include "Resources.h"
+#include "FilePool.h"
+#include "Config.h"
+#include <benchmark/benchmark.h>
+#include <ghc/fs_std.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+constexpr int sampleFrames { 16384 };
+constexpr int sampleChannels { 2 };
+constexpr float sampleRate { 48000.0f };
+
+static void writeLE(std::ofstream& stream, uint32_t value, int numBytes)
+{
+    for (int i = 0; i < numBytes; ++i)
+        stream.put(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+static void writeSineWav(const fs::path& path, float frequency)
+{
+    constexpr uint32_t bytesPerFrame = 2 * sampleChannels;
+    constexpr uint32_t dataSize = sampleFrames * bytesPerFrame;
+
+    std::ofstream stream(path.string(), std::ios::binary);
+    stream.write("RIFF", 4);
+    writeLE(stream, 36 + dataSize, 4);
+    stream.write("WAVEfmt ", 8);
+    writeLE(stream, 16, 4);
+    writeLE(stream, 1, 2); // PCM
+    writeLE(stream, sampleChannels, 2);
+    writeLE(stream, static_cast<uint32_t>(sampleRate), 4);
+    writeLE(stream, static_cast<uint32_t>(sampleRate) * bytesPerFrame, 4);
+    writeLE(stream, bytesPerFrame, 2);
+    writeLE(stream, 16, 2);
+    stream.write("data", 4);
+    writeLE(stream, dataSize, 4);
+
+    for (int i = 0; i < sampleFrames; ++i) {
+        const float value = std::sin(2.0f * static_cast<float>(M_PI) * frequency * i / sampleRate);
+        const auto sample = static_cast<int16_t>(value * 16384.0f);
+        for (int c = 0; c < sampleChannels; ++c)
+            writeLE(stream, static_cast<uint16_t>(sample), 2);
+    }
+}
+
+class LoadFixture : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) {
+        numFiles = static_cast<int>(state.range(0));
+        directory = fs::temp_directory_path() / "sfizz_bm_loadInstrument";
+        std::error_code ec;
+        fs::create_directories(directory, ec);
+
+        sfzText.clear();
+        for (int i = 0; i < numFiles; ++i) {
+            const std::string filename = "sample_" + std::to_string(i) + ".wav";
+            const fs::path path = directory / filename;
+            if (!fs::exists(path, ec))
+                writeSineWav(path, 100.0f + i);
+            sfzText += "<region> key=" + std::to_string(i % 128) + " sample=" + filename + "\n";
+        }
+    }
+
+    void TearDown(const ::benchmark::State& /* state */) {
+    }
+
+    int numFiles { 0 };
+    fs::path directory;
+    std::string sfzText;
+};
+
+BENCHMARK_DEFINE_F(LoadFixture, Preload)(benchmark::State& state) {
+    sfz::Synth synth;
+    sfz::FilePool& filePool = synth.getResources().getFilePool();
+    filePool.setMaxPreloadingJobs(static_cast<unsigned>(state.range(1)));
+
+    for (auto _ : state) {
+        synth.loadSfzString(directory / "instrument.sfz", sfzText);
+        benchmark::DoNotOptimize(synth.getNumRegions());
+    }
+
+    const int preloadedFrames = std::min<int>(sampleFrames, static_cast<int>(filePool.getPreloadSize()));
+    const double bytesPerFile = double(preloadedFrames) * sampleChannels * 2;
+    state.counters["files/s"] = benchmark::Counter(
+        numFiles, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["MB/s"] = benchmark::Counter(
+        numFiles * bytesPerFile * 1e-6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_REGISTER_F(LoadFixture, Preload)
+    ->Args({ 256, 1 })
+    ->Args({ 256, 2 })
+    ->Args({ 256, 4 })
+    ->Args({ 256, 8 })
+    ->Args({ 256, 16 })
+    ->Args({ 1024, 1 })
+    ->Args({ 1024, 16 })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Another synth of the process already holds the instrument, whose sample
+// data is then shared rather than read again
+BENCHMARK_DEFINE_F(LoadFixture, SharedPreload)(benchmark::State& state) {
+    sfz::Synth otherSynth;
+    otherSynth.loadSfzString(directory / "instrument.sfz", sfzText);
+
+    sfz::Synth synth;
+    sfz::FilePool& filePool = synth.getResources().getFilePool();
+    filePool.setMaxPreloadingJobs(static_cast<unsigned>(state.range(1)));
+
+    for (auto _ : state) {
+        synth.loadSfzString(directory / "instrument.sfz", sfzText);
+        benchmark::DoNotOptimize(synth.getNumRegions());
+    }
+
+    state.counters["files/s"] = benchmark::Counter(
+        numFiles, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_REGISTER_F(LoadFixture, SharedPreload)
+    ->Args({ 256, 1 })
+    ->Args({ 1024, 1 })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
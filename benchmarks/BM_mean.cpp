@@ -43,6 +43,18 @@ BENCHMARK_DEFINE_F(MeanArray, Scalar)
 BENCHMARK_DEFINE_F(MeanArray, SIMD)
 (benchmark::State& state)
 {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state) {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::mean, true);
+        auto result = sfz::mean<float>(input);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK_DEFINE_F(MeanArray, AVX)
+(benchmark::State& state)
+{
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state) {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::mean, true);
         auto result = sfz::mean<float>(input);
@@ -63,6 +75,18 @@ BENCHMARK_DEFINE_F(MeanArray, Scalar_Unaligned)
 BENCHMARK_DEFINE_F(MeanArray, SIMD_Unaligned)
 (benchmark::State& state)
 {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state) {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::mean, true);
+        auto result = sfz::mean<float>(absl::MakeSpan(input).subspan(1));
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK_DEFINE_F(MeanArray, AVX_Unaligned)
+(benchmark::State& state)
+{
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state) {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::mean, true);
         auto result = sfz::mean<float>(absl::MakeSpan(input).subspan(1));
@@ -72,6 +96,8 @@ BENCHMARK_DEFINE_F(MeanArray, SIMD_Unaligned)
 
 BENCHMARK_REGISTER_F(MeanArray, Scalar)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MeanArray, SIMD)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(MeanArray, AVX)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MeanArray, Scalar_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MeanArray, SIMD_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(MeanArray, AVX_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_MAIN();
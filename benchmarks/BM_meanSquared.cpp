@@ -43,6 +43,18 @@ BENCHMARK_DEFINE_F(MeanSquaredArray, Scalar)
 BENCHMARK_DEFINE_F(MeanSquaredArray, SIMD)
 (benchmark::State& state)
 {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state) {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::sumSquares, true);
+        auto result = sfz::meanSquared<float>(input);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK_DEFINE_F(MeanSquaredArray, AVX)
+(benchmark::State& state)
+{
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state) {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::sumSquares, true);
         auto result = sfz::meanSquared<float>(input);
@@ -63,6 +75,18 @@ BENCHMARK_DEFINE_F(MeanSquaredArray, Scalar_Unaligned)
 BENCHMARK_DEFINE_F(MeanSquaredArray, SIMD_Unaligned)
 (benchmark::State& state)
 {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state) {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::sumSquares, true);
+        auto result = sfz::meanSquared<float>(absl::MakeSpan(input).subspan(1));
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK_DEFINE_F(MeanSquaredArray, AVX_Unaligned)
+(benchmark::State& state)
+{
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state) {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::sumSquares, true);
         auto result = sfz::meanSquared<float>(absl::MakeSpan(input).subspan(1));
@@ -72,6 +96,8 @@ BENCHMARK_DEFINE_F(MeanSquaredArray, SIMD_Unaligned)
 
 BENCHMARK_REGISTER_F(MeanSquaredArray, Scalar)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MeanSquaredArray, SIMD)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(MeanSquaredArray, AVX)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MeanSquaredArray, Scalar_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MeanSquaredArray, SIMD_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(MeanSquaredArray, AVX_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_MAIN();
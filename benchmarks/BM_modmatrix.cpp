@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+// Measures the rendering of held voices whose regions each have about 20
+// modulation connections: LFOs and envelopes on the pitch, filter, volume and
+// pan, with controllers on their depths and frequencies, a velocity-dependent
+// pitch envelope, and direct controller modulations. The same voices rendered
+// with only the default connections give the cost of the rest of the voice.
+
+#include "Synth.h"
+#include "AudioBuffer.h"
+#include <benchmark/benchmark.h>
+#include <ghc/fs_std.hpp>
+#include <string>
+
+constexpr int blockSize { 256 };
+constexpr int firstKey { 24 };
+
+// 17 connections, in addition to the 4 default ones of each region
+static const char modulatedRegion[] =
+    " fil_type=lpf_2p cutoff=2000"
+    " lfo1_freq=5 lfo1_pitch=20 lfo1_pitch_oncc1=30 lfo1_freq_oncc2=2"
+    " lfo2_freq=0.5 lfo2_cutoff=600 lfo2_cutoff_oncc3=1200"
+    " lfo3_freq=3 lfo3_volume=2 lfo3_pan=20"
+    " eg1_time1=0.1 eg1_level1=1 eg1_time2=0.5 eg1_level2=0.2 eg1_sustain=2"
+    " eg1_cutoff=2400 eg1_pitch=100"
+    " cutoff_oncc4=1200 resonance_oncc5=6 pitch_oncc6=100 amplitude_oncc8=50"
+    " pitcheg_decay=0.5 pitcheg_depth=200 pitcheg_vel2depth=300"
+    " fileg_decay=1 fileg_depth=1200 fileg_depth_oncc12=-600\n";
+
+static const char plainRegion[] =
+    " fil_type=lpf_2p cutoff=2000\n";
+
+class ModMatrixFixture : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) {
+        numVoices = static_cast<int>(state.range(0));
+        synth.setSamplesPerBlock(blockSize);
+        synth.setNumVoices(numVoices);
+    }
+
+    void TearDown(const ::benchmark::State& /* state */) {
+    }
+
+    // One region and one held voice per key
+    void play(const char* regionOpcodes) {
+        std::string sfzText;
+        for (int key = firstKey; key < firstKey + numVoices; ++key)
+            sfzText += "<region> sample=*saw key=" + std::to_string(key) + regionOpcodes;
+        synth.loadSfzString(fs::current_path() / "modmatrix.sfz", sfzText);
+
+        for (int cc = 1; cc <= 12; ++cc)
+            synth.hdcc(0, cc, 0.5f);
+        for (int key = firstKey; key < firstKey + numVoices; ++key)
+            synth.noteOn(0, key, 32 + (key % 96));
+    }
+
+    void render(benchmark::State& state) {
+        for (auto _ : state) {
+            synth.renderBlock(buffer);
+            benchmark::DoNotOptimize(buffer.getSpan(0).data());
+        }
+        state.counters["voices"] = synth.getNumActiveVoices();
+    }
+
+    sfz::Synth synth;
+    sfz::AudioBuffer<float> buffer { 2, blockSize };
+    int numVoices { 0 };
+};
+
+BENCHMARK_DEFINE_F(ModMatrixFixture, Modulated)(benchmark::State& state) {
+    play(modulatedRegion);
+    render(state);
+}
+
+BENCHMARK_DEFINE_F(ModMatrixFixture, Plain)(benchmark::State& state) {
+    play(plainRegion);
+    render(state);
+}
+
+BENCHMARK_REGISTER_F(ModMatrixFixture, Modulated)->RangeMultiplier(4)->Range(4, 64);
+BENCHMARK_REGISTER_F(ModMatrixFixture, Plain)->RangeMultiplier(4)->Range(4, 64);
+BENCHMARK_MAIN();
@@ -56,6 +56,17 @@ BENCHMARK_DEFINE_F(MultiplyMulFixedGain, Scalar)
 BENCHMARK_DEFINE_F(MultiplyMulFixedGain, SIMD)
 (benchmark::State& state)
 {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state) {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::multiplyMul1, true);
+        sfz::multiplyMul1<float>(gain, input, absl::MakeSpan(output));
+    }
+}
+
+BENCHMARK_DEFINE_F(MultiplyMulFixedGain, AVX)
+(benchmark::State& state)
+{
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state) {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::multiplyMul1, true);
         sfz::multiplyMul1<float>(gain, input, absl::MakeSpan(output));
@@ -74,6 +85,17 @@ BENCHMARK_DEFINE_F(MultiplyMulFixedGain, Scalar_Unaligned)
 BENCHMARK_DEFINE_F(MultiplyMulFixedGain, SIMD_Unaligned)
 (benchmark::State& state)
 {
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state) {
+        sfz::setSIMDOpStatus<float>(sfz::SIMDOps::multiplyMul1, true);
+        sfz::multiplyMul1<float>(gain, absl::MakeSpan(input).subspan(1), absl::MakeSpan(output).subspan(1));
+    }
+}
+
+BENCHMARK_DEFINE_F(MultiplyMulFixedGain, AVX_Unaligned)
+(benchmark::State& state)
+{
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
     for (auto _ : state) {
         sfz::setSIMDOpStatus<float>(sfz::SIMDOps::multiplyMul1, true);
         sfz::multiplyMul1<float>(gain, absl::MakeSpan(input).subspan(1), absl::MakeSpan(output).subspan(1));
@@ -83,6 +105,8 @@ BENCHMARK_DEFINE_F(MultiplyMulFixedGain, SIMD_Unaligned)
 BENCHMARK_REGISTER_F(MultiplyMulFixedGain, Straight)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MultiplyMulFixedGain, Scalar)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MultiplyMulFixedGain, SIMD)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(MultiplyMulFixedGain, AVX)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MultiplyMulFixedGain, Scalar_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_REGISTER_F(MultiplyMulFixedGain, SIMD_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
+BENCHMARK_REGISTER_F(MultiplyMulFixedGain, AVX_Unaligned)->RangeMultiplier(4)->Range(1 << 2, 1 << 12);
 BENCHMARK_MAIN();
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "NoiseGenerator.h"
+#include "MathHelpers.h"
+#include <benchmark/benchmark.h>
+#include <absl/algorithm/container.h>
+#include <vector>
+#include <random>
+#include <cmath>
+
+// Fill a stereo pair of buffers with noise, as the generator regions do
+class NoiseFill : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) {
+        left = std::vector<float>(state.range(0));
+        right = std::vector<float>(state.range(0));
+    }
+
+    void TearDown(const ::benchmark::State& state) {
+        UNUSED(state);
+    }
+
+    // Report the moments of the last output, as a check of the distribution
+    void setMoments(benchmark::State& state) {
+        double mean = 0.0;
+        for (float x : left)
+            mean += x;
+        mean /= left.size();
+
+        double m2 = 0.0;
+        double m4 = 0.0;
+        for (float x : left) {
+            const double d = x - mean;
+            m2 += d * d;
+            m4 += d * d * d * d;
+        }
+        m2 /= left.size();
+        m4 /= left.size();
+
+        state.counters["mean"] = mean;
+        state.counters["stddev"] = std::sqrt(m2);
+        state.counters["kurtosis"] = (m2 > 0.0) ? (m4 / (m2 * m2) - 3.0) : 0.0;
+        state.SetItemsProcessed(state.iterations() * 2 * left.size());
+    }
+
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+BENCHMARK_DEFINE_F(NoiseFill, StdUniform)(benchmark::State& state) {
+    std::minstd_rand prng;
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    auto gen = [&]() { return dist(prng); };
+
+    for (auto _ : state)
+    {
+        absl::c_generate(left, gen);
+        absl::c_generate(right, gen);
+        benchmark::DoNotOptimize(left);
+        benchmark::DoNotOptimize(right);
+    }
+    setMoments(state);
+}
+
+BENCHMARK_DEFINE_F(NoiseFill, FastUniform)(benchmark::State& state) {
+    fast_rand prng;
+    fast_real_distribution<float> dist(-1.0f, 1.0f);
+    auto gen = [&]() { return dist(prng); };
+
+    for (auto _ : state)
+    {
+        absl::c_generate(left, gen);
+        absl::c_generate(right, gen);
+        benchmark::DoNotOptimize(left);
+        benchmark::DoNotOptimize(right);
+    }
+    setMoments(state);
+}
+
+BENCHMARK_DEFINE_F(NoiseFill, NoiseGeneratorUniform)(benchmark::State& state) {
+    sfz::NoiseGenerator generator;
+
+    for (auto _ : state)
+    {
+        generator.fillUniform(absl::MakeSpan(left), 1.0f);
+        generator.fillUniform(absl::MakeSpan(right), 1.0f);
+        benchmark::DoNotOptimize(left);
+        benchmark::DoNotOptimize(right);
+    }
+    setMoments(state);
+}
+
+BENCHMARK_DEFINE_F(NoiseFill, StdNormal)(benchmark::State& state) {
+    std::minstd_rand prng;
+    std::normal_distribution<float> dist(0.0f, 0.25f);
+    auto gen = [&]() { return dist(prng); };
+
+    for (auto _ : state)
+    {
+        absl::c_generate(left, gen);
+        absl::c_generate(right, gen);
+        benchmark::DoNotOptimize(left);
+        benchmark::DoNotOptimize(right);
+    }
+    setMoments(state);
+}
+
+BENCHMARK_DEFINE_F(NoiseFill, FastNormal)(benchmark::State& state) {
+    fast_gaussian_generator<float, 4> generator(0.0f, 0.25f);
+    auto gen = [&]() { return generator(); };
+
+    for (auto _ : state)
+    {
+        absl::c_generate(left, gen);
+        absl::c_generate(right, gen);
+        benchmark::DoNotOptimize(left);
+        benchmark::DoNotOptimize(right);
+    }
+    setMoments(state);
+}
+
+BENCHMARK_DEFINE_F(NoiseFill, NoiseGeneratorNormal)(benchmark::State& state) {
+    sfz::NoiseGenerator generator;
+
+    for (auto _ : state)
+    {
+        generator.fillGaussian(absl::MakeSpan(left), 0.0f, 0.25f);
+        generator.fillGaussian(absl::MakeSpan(right), 0.0f, 0.25f);
+        benchmark::DoNotOptimize(left);
+        benchmark::DoNotOptimize(right);
+    }
+    setMoments(state);
+}
+
+BENCHMARK_REGISTER_F(NoiseFill, StdUniform)->RangeMultiplier(4)->Range(1 << 4, 1 << 12);
+BENCHMARK_REGISTER_F(NoiseFill, FastUniform)->RangeMultiplier(4)->Range(1 << 4, 1 << 12);
+BENCHMARK_REGISTER_F(NoiseFill, NoiseGeneratorUniform)->RangeMultiplier(4)->Range(1 << 4, 1 << 12);
+BENCHMARK_REGISTER_F(NoiseFill, StdNormal)->RangeMultiplier(4)->Range(1 << 4, 1 << 12);
+BENCHMARK_REGISTER_F(NoiseFill, FastNormal)->RangeMultiplier(4)->Range(1 << 4, 1 << 12);
+BENCHMARK_REGISTER_F(NoiseFill, NoiseGeneratorNormal)->RangeMultiplier(4)->Range(1 << 4, 1 << 12);
+BENCHMARK_MAIN();
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+// Measures the latency of a note-on on a deeply layered instrument of about
+// 50k regions: each of the 104 keys has 480 regions, made of velocity layers
+// times 4 microphone positions times a number of articulations selected by key
+// switches. The voices are reset after each note, which is included in the
+// measurement.
+
+#include "Synth.h"
+#include <benchmark/benchmark.h>
+#include <ghc/fs_std.hpp>
+#include <string>
+
+constexpr int regionsPerKey { 480 };
+constexpr int numMicrophones { 4 };
+constexpr int firstKeyswitch { 0 };
+constexpr int firstKey { 24 };
+constexpr int numKeys { 104 };
+
+class NoteOnFixture : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) {
+        const int numArticulations = static_cast<int>(state.range(0));
+        const int numVelocityLayers = regionsPerKey / (numMicrophones * numArticulations);
+        const int layerWidth = 128 / numVelocityLayers;
+
+        std::string sfzText;
+        sfzText += "<global> sw_lokey=" + std::to_string(firstKeyswitch)
+            + " sw_hikey=" + std::to_string(firstKeyswitch + numArticulations - 1)
+            + " sw_default=" + std::to_string(firstKeyswitch) + "\n";
+        for (int articulation = 0; articulation < numArticulations; ++articulation) {
+            sfzText += "<master> sw_last=" + std::to_string(firstKeyswitch + articulation) + "\n";
+            for (int mic = 0; mic < numMicrophones; ++mic) {
+                sfzText += "<group> sample=*sine amplitude=" + std::to_string(100 - mic * 20) + "\n";
+                for (int key = firstKey; key < firstKey + numKeys; ++key) {
+                    for (int layer = 0; layer < numVelocityLayers; ++layer) {
+                        const int lovel = layer * layerWidth;
+                        const int hivel = (layer == numVelocityLayers - 1) ? 127 : lovel + layerWidth - 1;
+                        sfzText += "<region> key=" + std::to_string(key)
+                            + " lovel=" + std::to_string(lovel)
+                            + " hivel=" + std::to_string(hivel) + "\n";
+                    }
+                }
+            }
+        }
+        synth.loadSfzString(fs::current_path() / "noteon.sfz", sfzText);
+        synth.noteOn(0, firstKeyswitch + numArticulations - 1, 64);
+    }
+
+    void TearDown(const ::benchmark::State& /* state */) {
+    }
+
+    sfz::Synth synth;
+};
+
+BENCHMARK_DEFINE_F(NoteOnFixture, NoteOn)(benchmark::State& state) {
+    int key = firstKey;
+    int velocity = 1;
+    for (auto _ : state) {
+        synth.noteOn(0, key, velocity);
+        synth.allSoundOff();
+        key = firstKey + (key - firstKey + 7) % numKeys;
+        velocity = 1 + (velocity + 36) % 127;
+    }
+    state.counters["regions"] = static_cast<double>(synth.getNumRegions());
+}
+
+BENCHMARK_REGISTER_F(NoteOnFixture, NoteOn)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond);
+BENCHMARK_MAIN();
@@ -5,12 +5,18 @@
 // If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
 
 #include "Panning.h"
+#include "SIMDHelpers.h"
+#include "SIMDConfig.h"
+#include "ScopedFTZ.h"
 #include "simd/Common.h"
 #include <benchmark/benchmark.h>
 #include <random>
+#include <iostream>
 #include <absl/algorithm/container.h>
 #include "absl/types/span.h"
+#if SFIZZ_HAVE_NEON
 #include <arm_neon.h>
+#endif
 
 #include <jsl/allocator>
 template <class T, std::size_t A = 16>
@@ -53,6 +59,7 @@ void panScalar(const float* panEnvelope, float* leftBuffer, float* rightBuffer,
     }
 }
 
+#if SFIZZ_HAVE_NEON
 void panSIMD(const float* panEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
 {
     const auto sentinel = panEnvelope + size;
@@ -79,6 +86,7 @@ void panSIMD(const float* panEnvelope, float* leftBuffer, float* rightBuffer, un
         incrementAll<4>(panEnvelope, leftBuffer, rightBuffer);
     }
 }
+#endif
 
 class PanFixture : public benchmark::Fixture {
 public:
@@ -107,28 +115,106 @@ public:
 };
 
 BENCHMARK_DEFINE_F(PanFixture, PanScalar)(benchmark::State& state) {
+    ScopedFTZ ftz;
     for (auto _ : state)
     {
         panScalar(pan.data(), left.data(), right.data(), state.range(0));
     }
 }
 
+#if SFIZZ_HAVE_NEON
 BENCHMARK_DEFINE_F(PanFixture, PanSIMD)(benchmark::State& state) {
+    ScopedFTZ ftz;
     for (auto _ : state)
     {
         panSIMD(pan.data(), left.data(), right.data(), state.range(0));
     }
 }
+#endif
+
+BENCHMARK_DEFINE_F(PanFixture, PanSfizzScalar)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::pan, false);
+    for (auto _ : state)
+    {
+        sfz::pan(pan.data(), left.data(), right.data(), state.range(0));
+    }
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::pan, true);
+}
+
+BENCHMARK_DEFINE_F(PanFixture, PanSfizzSSE)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::pan(pan.data(), left.data(), right.data(), state.range(0));
+    }
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
+}
 
 BENCHMARK_DEFINE_F(PanFixture, PanSfizz)(benchmark::State& state) {
+    ScopedFTZ ftz;
     for (auto _ : state)
     {
         sfz::pan(pan.data(), left.data(), right.data(), state.range(0));
     }
 }
 
+BENCHMARK_DEFINE_F(PanFixture, PanSfizzConstant)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    for (auto _ : state)
+    {
+        sfz::pan1(0.3f, left.data(), right.data(), state.range(0));
+    }
+}
+
+BENCHMARK_DEFINE_F(PanFixture, WidthSfizzScalar)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::width, false);
+    for (auto _ : state)
+    {
+        sfz::width(pan.data(), left.data(), right.data(), state.range(0));
+    }
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::width, true);
+}
+
+BENCHMARK_DEFINE_F(PanFixture, WidthSfizzSSE)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    for (auto _ : state)
+    {
+        sfz::width(pan.data(), left.data(), right.data(), state.range(0));
+    }
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
+}
+
+BENCHMARK_DEFINE_F(PanFixture, WidthSfizz)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    for (auto _ : state)
+    {
+        sfz::width(pan.data(), left.data(), right.data(), state.range(0));
+    }
+}
+
+BENCHMARK_DEFINE_F(PanFixture, WidthSfizzConstant)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    for (auto _ : state)
+    {
+        sfz::width1(0.3f, left.data(), right.data(), state.range(0));
+    }
+}
+
 // Register the function as a benchmark
 BENCHMARK_REGISTER_F(PanFixture, PanScalar)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
+#if SFIZZ_HAVE_NEON
 BENCHMARK_REGISTER_F(PanFixture, PanSIMD)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
+#endif
+BENCHMARK_REGISTER_F(PanFixture, PanSfizzScalar)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
+BENCHMARK_REGISTER_F(PanFixture, PanSfizzSSE)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
 BENCHMARK_REGISTER_F(PanFixture, PanSfizz)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
+BENCHMARK_REGISTER_F(PanFixture, PanSfizzConstant)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
+BENCHMARK_REGISTER_F(PanFixture, WidthSfizzScalar)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
+BENCHMARK_REGISTER_F(PanFixture, WidthSfizzSSE)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
+BENCHMARK_REGISTER_F(PanFixture, WidthSfizz)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
+BENCHMARK_REGISTER_F(PanFixture, WidthSfizzConstant)->RangeMultiplier(4)->Range((1 << 4), (1 << 12));
 BENCHMARK_MAIN();
@@ -29,6 +29,20 @@ static void SSE(benchmark::State& state) {
   sfz::Buffer<float> outputRight (state.range(0));
   std::iota(input.begin(), input.end(), 1.0f);
 
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+  for (auto _ : state) {
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::readInterleaved, true);
+    sfz::readInterleaved(input, absl::MakeSpan(outputLeft), absl::MakeSpan(outputRight));
+  }
+}
+
+static void AVX(benchmark::State& state) {
+  sfz::Buffer<float> input (state.range(0) * 2);
+  sfz::Buffer<float> outputLeft (state.range(0));
+  sfz::Buffer<float> outputRight (state.range(0));
+  std::iota(input.begin(), input.end(), 1.0f);
+
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
   for (auto _ : state) {
     sfz::setSIMDOpStatus<float>(sfz::SIMDOps::readInterleaved, true);
     sfz::readInterleaved(input, absl::MakeSpan(outputLeft), absl::MakeSpan(outputRight));
@@ -55,6 +69,23 @@ static void SSE_Unaligned(benchmark::State& state) {
   sfz::Buffer<float> outputLeft (state.range(0));
   sfz::Buffer<float> outputRight (state.range(0));
   std::iota(input.begin(), input.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+  for (auto _ : state) {
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::readInterleaved, true);
+    sfz::readInterleaved(
+        absl::MakeSpan(input).subspan(2),
+        absl::MakeSpan(outputLeft),
+        absl::MakeSpan(outputRight)
+    );
+  }
+}
+
+static void AVX_Unaligned(benchmark::State& state) {
+  sfz::Buffer<float> input (state.range(0) * 2);
+  sfz::Buffer<float> outputLeft (state.range(0));
+  sfz::Buffer<float> outputRight (state.range(0));
+  std::iota(input.begin(), input.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
   for (auto _ : state) {
     sfz::setSIMDOpStatus<float>(sfz::SIMDOps::readInterleaved, true);
     sfz::readInterleaved(
@@ -85,6 +116,23 @@ static void SSE_Unaligned_2(benchmark::State& state) {
   sfz::Buffer<float> outputLeft (state.range(0));
   sfz::Buffer<float> outputRight (state.range(0));
   std::iota(input.begin(), input.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+  for (auto _ : state) {
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::readInterleaved, true);
+    sfz::readInterleaved(
+        absl::MakeSpan(input).subspan(2),
+        absl::MakeSpan(outputLeft).subspan(1),
+        absl::MakeSpan(outputRight).subspan(3)
+    );
+  }
+}
+
+static void AVX_Unaligned_2(benchmark::State& state) {
+  sfz::Buffer<float> input (state.range(0) * 2);
+  sfz::Buffer<float> outputLeft (state.range(0));
+  sfz::Buffer<float> outputRight (state.range(0));
+  std::iota(input.begin(), input.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
   for (auto _ : state) {
     sfz::setSIMDOpStatus<float>(sfz::SIMDOps::readInterleaved, true);
     sfz::readInterleaved(
@@ -97,8 +145,11 @@ static void SSE_Unaligned_2(benchmark::State& state) {
 
 BENCHMARK(Scalar)->Range((8<<10), (8<<20));
 BENCHMARK(SSE)->Range((8<<10), (8<<20));
+BENCHMARK(AVX)->Range((8<<10), (8<<20));
 BENCHMARK(Scalar_Unaligned)->Range((8<<10), (8<<20));
 BENCHMARK(SSE_Unaligned)->Range((8<<10), (8<<20));
+BENCHMARK(AVX_Unaligned)->Range((8<<10), (8<<20));
 BENCHMARK(Scalar_Unaligned_2)->Range((8<<10), (8<<20));
 BENCHMARK(SSE_Unaligned_2)->Range((8<<10), (8<<20));
+BENCHMARK(AVX_Unaligned_2)->Range((8<<10), (8<<20));
 BENCHMARK_MAIN();
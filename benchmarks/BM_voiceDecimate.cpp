@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+// Compares the voice decimation stage with the filter and boxcar average
+// which it replaced.
+
+#include "VoiceDecimator.h"
+#include "SfzFilter.h"
+#include "AudioBuffer.h"
+#include "AudioSpan.h"
+#include "ScopedFTZ.h"
+#include "SIMDHelpers.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+
+constexpr int blockSize { 256 };
+constexpr float sampleRate { 48000.0f };
+
+class DecimateFixture : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) {
+        factor = static_cast<int>(state.range(0));
+        input.resize(blockSize * factor);
+        work.resize(blockSize * factor);
+        output.resize(blockSize);
+        for (size_t c = 0; c < input.getNumChannels(); ++c) {
+            auto channel = input.getSpan(c);
+            std::generate(channel.begin(), channel.end(), [&]() { return dist(gen); });
+        }
+    }
+
+    void TearDown(const ::benchmark::State& /* state */) {
+    }
+
+    std::random_device rd { };
+    std::mt19937 gen { rd() };
+    std::uniform_real_distribution<float> dist { -1.0f, 1.0f };
+    int factor { 1 };
+    sfz::AudioBuffer<float> input { 2, blockSize };
+    sfz::AudioBuffer<float> work { 2, blockSize };
+    sfz::AudioBuffer<float> output { 2, blockSize };
+};
+
+BENCHMARK_DEFINE_F(DecimateFixture, FilterAndAverage)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    sfz::Filter filter;
+    filter.setType(sfz::FilterType::kFilterLpf6p);
+    filter.setChannels(2);
+    filter.init(sampleRate);
+    const float cutoff = 0.48f * sampleRate / float(factor);
+    filter.prepare(cutoff, 0.0, 0.0);
+
+    for (auto _ : state) {
+        sfz::AudioSpan<float> in { work };
+        sfz::copy<float>(input.getConstSpan(0), work.getSpan(0));
+        sfz::copy<float>(input.getConstSpan(1), work.getSpan(1));
+        filter.process(in, in, cutoff, 0.0, 0.0, in.getNumFrames());
+        for (size_t c = 0; c < output.getNumChannels(); ++c) {
+            for (size_t i = 0; i < output.getNumFrames(); ++i) {
+                float sum = in[c][i * factor];
+                for (int k = 1; k < factor; ++k)
+                    sum += in[c][i * factor + k];
+                output(c, i) = sum / float(factor);
+            }
+        }
+        benchmark::DoNotOptimize(output.getSpan(0).data());
+    }
+}
+
+BENCHMARK_DEFINE_F(DecimateFixture, HalfbandCascade)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    sfz::VoiceDecimator decimator;
+    decimator.setFactor(factor);
+
+    for (auto _ : state) {
+        sfz::copy<float>(input.getConstSpan(0), work.getSpan(0));
+        sfz::copy<float>(input.getConstSpan(1), work.getSpan(1));
+        decimator.process(work, output);
+        benchmark::DoNotOptimize(output.getSpan(0).data());
+    }
+}
+
+BENCHMARK_REGISTER_F(DecimateFixture, FilterAndAverage)->RangeMultiplier(2)->Range(2, 128);
+BENCHMARK_REGISTER_F(DecimateFixture, HalfbandCascade)->RangeMultiplier(2)->Range(2, 128);
+BENCHMARK_MAIN();
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "Wavetables.h"
+#include "SIMDHelpers.h"
+#include "SfzHelpers.h"
+#include "ScopedFTZ.h"
+#include "utility/Macros.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <cmath>
+
+constexpr int blockSize { 256 };
+constexpr float sampleRate { 48000.0f };
+
+// A unison of detuned oscillators, one at a time or as a bank
+class UnisonFixture : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State& state) {
+        unisonSize = static_cast<unsigned>(state.range(0));
+        frequencies = std::vector<float>(blockSize);
+        ratios = std::vector<float>(blockSize);
+        temp = std::vector<float>(blockSize);
+        left = std::vector<float>(blockSize);
+        right = std::vector<float>(blockSize);
+        for (int i = 0; i < blockSize; ++i)
+            frequencies[i] = 440.0f * std::exp2(0.1f * std::sin(0.01f * i));
+
+        detuneRatios.resize(unisonSize);
+        leftGains.resize(unisonSize);
+        rightGains.resize(unisonSize);
+        for (unsigned u = 0; u < unisonSize; ++u) {
+            detuneRatios[u] = sfz::centsFactor(5.0f * u - 20.0f);
+            leftGains[u] = 1.0f - u / float(unisonSize);
+            rightGains[u] = u / float(unisonSize);
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state) {
+        UNUSED(state);
+    }
+
+    unsigned unisonSize = 0;
+    std::vector<float> frequencies;
+    std::vector<float> ratios;
+    std::vector<float> temp;
+    std::vector<float> left;
+    std::vector<float> right;
+    std::vector<float> detuneRatios;
+    std::vector<float> leftGains;
+    std::vector<float> rightGains;
+};
+
+BENCHMARK_DEFINE_F(UnisonFixture, Oscillators)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    const int quality = static_cast<int>(state.range(1));
+    std::vector<sfz::WavetableOscillator> oscillators(unisonSize);
+    for (auto& osc : oscillators) {
+        osc.init(sampleRate);
+        osc.setWavetable(sfz::WavetablePool::getWaveSaw());
+        osc.setQuality(quality);
+    }
+
+    for (auto _ : state)
+    {
+        for (unsigned u = 0; u < unisonSize; ++u) {
+            sfz::fill<float>(absl::MakeSpan(ratios), detuneRatios[u]);
+            oscillators[u].processModulated(frequencies.data(), ratios.data(), temp.data(), blockSize);
+            if (u == 0) {
+                sfz::applyGain1<float>(leftGains[u], temp, absl::MakeSpan(left));
+                sfz::applyGain1<float>(rightGains[u], temp, absl::MakeSpan(right));
+            }
+            else {
+                sfz::multiplyAdd1<float>(leftGains[u], temp, absl::MakeSpan(left));
+                sfz::multiplyAdd1<float>(rightGains[u], temp, absl::MakeSpan(right));
+            }
+        }
+        benchmark::DoNotOptimize(left);
+        benchmark::DoNotOptimize(right);
+    }
+    state.SetItemsProcessed(state.iterations() * blockSize);
+}
+
+BENCHMARK_DEFINE_F(UnisonFixture, Bank)(benchmark::State& state) {
+    ScopedFTZ ftz;
+    sfz::WavetableUnison unison;
+    unison.init(sampleRate);
+    unison.setWavetable(sfz::WavetablePool::getWaveSaw());
+    unison.setQuality(static_cast<int>(state.range(1)));
+    unison.resize(unisonSize);
+    for (unsigned u = 0; u < unisonSize; ++u) {
+        unison.setDetuneRatio(u, detuneRatios[u]);
+        unison.setGains(u, leftGains[u], rightGains[u]);
+    }
+
+    for (auto _ : state)
+    {
+        unison.processModulated(frequencies.data(), nullptr, left.data(), right.data(), blockSize);
+        benchmark::DoNotOptimize(left);
+        benchmark::DoNotOptimize(right);
+    }
+    state.SetItemsProcessed(state.iterations() * blockSize);
+}
+
+BENCHMARK_REGISTER_F(UnisonFixture, Oscillators)
+    ->Args({ 3, 1 })
+    ->Args({ 3, 2 })
+    ->Args({ 3, 3 })
+    ->Args({ 5, 1 })
+    ->Args({ 5, 2 })
+    ->Args({ 5, 3 })
+    ->Args({ 9, 1 })
+    ->Args({ 9, 2 })
+    ->Args({ 9, 3 });
+BENCHMARK_REGISTER_F(UnisonFixture, Bank)
+    ->Args({ 3, 1 })
+    ->Args({ 3, 2 })
+    ->Args({ 3, 3 })
+    ->Args({ 5, 1 })
+    ->Args({ 5, 2 })
+    ->Args({ 5, 3 })
+    ->Args({ 9, 1 })
+    ->Args({ 9, 2 })
+    ->Args({ 9, 3 });
+BENCHMARK_MAIN();
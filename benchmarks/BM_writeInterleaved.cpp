@@ -30,6 +30,20 @@ static void Interleaved_Write_SSE(benchmark::State& state) {
   sfz::Buffer<float> output (state.range(0) * 2);
   std::iota(inputLeft.begin(), inputLeft.end(), 1.0f);
   std::iota(inputRight.begin(), inputRight.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+  for (auto _ : state) {
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::writeInterleaved, true);
+    sfz::writeInterleaved(inputLeft, inputRight, absl::MakeSpan(output));
+  }
+}
+
+static void Interleaved_Write_AVX(benchmark::State& state) {
+  sfz::Buffer<float> inputLeft (state.range(0));
+  sfz::Buffer<float> inputRight (state.range(0));
+  sfz::Buffer<float> output (state.range(0) * 2);
+  std::iota(inputLeft.begin(), inputLeft.end(), 1.0f);
+  std::iota(inputRight.begin(), inputRight.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
   for (auto _ : state) {
     sfz::setSIMDOpStatus<float>(sfz::SIMDOps::writeInterleaved, true);
     sfz::writeInterleaved(inputLeft, inputRight, absl::MakeSpan(output));
@@ -58,6 +72,24 @@ static void Unaligned_Interleaved_Write_SSE(benchmark::State& state) {
   sfz::Buffer<float> output (state.range(0) * 2);
   std::iota(inputLeft.begin(), inputLeft.end(), 1.0f);
   std::iota(inputRight.begin(), inputRight.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+  for (auto _ : state) {
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::writeInterleaved, true);
+    sfz::writeInterleaved(
+        absl::MakeSpan(inputLeft).subspan(1),
+        absl::MakeSpan(inputRight).subspan(1),
+        absl::MakeSpan(output).subspan(2)
+    );
+  }
+}
+
+static void Unaligned_Interleaved_Write_AVX(benchmark::State& state) {
+  sfz::Buffer<float> inputLeft (state.range(0));
+  sfz::Buffer<float> inputRight (state.range(0));
+  sfz::Buffer<float> output (state.range(0) * 2);
+  std::iota(inputLeft.begin(), inputLeft.end(), 1.0f);
+  std::iota(inputRight.begin(), inputRight.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
   for (auto _ : state) {
     sfz::setSIMDOpStatus<float>(sfz::SIMDOps::writeInterleaved, true);
     sfz::writeInterleaved(
@@ -90,6 +122,24 @@ static void Unaligned_Interleaved_Write_SSE_2(benchmark::State& state) {
   sfz::Buffer<float> output (state.range(0) * 2);
   std::iota(inputLeft.begin(), inputLeft.end(), 1.0f);
   std::iota(inputRight.begin(), inputRight.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+  for (auto _ : state) {
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::writeInterleaved, true);
+    sfz::writeInterleaved(
+        absl::MakeSpan(inputLeft),
+        absl::MakeSpan(inputRight).subspan(1),
+        absl::MakeSpan(output).subspan(2)
+    );
+  }
+}
+
+static void Unaligned_Interleaved_Write_AVX_2(benchmark::State& state) {
+  sfz::Buffer<float> inputLeft (state.range(0));
+  sfz::Buffer<float> inputRight (state.range(0));
+  sfz::Buffer<float> output (state.range(0) * 2);
+  std::iota(inputLeft.begin(), inputLeft.end(), 1.0f);
+  std::iota(inputRight.begin(), inputRight.end(), 1.0f);
+  sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
   for (auto _ : state) {
     sfz::setSIMDOpStatus<float>(sfz::SIMDOps::writeInterleaved, true);
     sfz::writeInterleaved(
@@ -102,8 +152,11 @@ static void Unaligned_Interleaved_Write_SSE_2(benchmark::State& state) {
 
 BENCHMARK(Interleaved_Write)->Range((8<<10), (8<<20));
 BENCHMARK(Interleaved_Write_SSE)->Range((8<<10), (8<<20));
+BENCHMARK(Interleaved_Write_AVX)->Range((8<<10), (8<<20));
 BENCHMARK(Unaligned_Interleaved_Write)->Range((8<<10), (8<<20));
 BENCHMARK(Unaligned_Interleaved_Write_SSE)->Range((8<<10), (8<<20));
+BENCHMARK(Unaligned_Interleaved_Write_AVX)->Range((8<<10), (8<<20));
 BENCHMARK(Unaligned_Interleaved_Write_2)->Range((8<<10), (8<<20));
 BENCHMARK(Unaligned_Interleaved_Write_SSE_2)->Range((8<<10), (8<<20));
+BENCHMARK(Unaligned_Interleaved_Write_AVX_2)->Range((8<<10), (8<<20));
 BENCHMARK_MAIN();
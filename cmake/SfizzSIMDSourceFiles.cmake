@@ -5,7 +5,8 @@ macro(sfizz_add_simd_sources SOURCES_VAR PREFIX)
         ${PREFIX}/sfizz/SIMDHelpers.cpp
         ${PREFIX}/sfizz/simd/HelpersNEON.cpp
         ${PREFIX}/sfizz/simd/HelpersSSE.cpp
-        ${PREFIX}/sfizz/simd/HelpersAVX.cpp)
+        ${PREFIX}/sfizz/simd/HelpersAVX.cpp
+        ${PREFIX}/sfizz/simd/InterpolatorsAVX2.cpp)
 
     # For CPU-dispatched X86 sources
     # Always build them for all X86 targets.
@@ -18,6 +19,20 @@ macro(sfizz_add_simd_sources SOURCES_VAR PREFIX)
                 ${PREFIX}/sfizz/effects/impl/ResonantArrayAVX.cpp
                 ${PREFIX}/sfizz/simd/HelpersAVX.cpp
                 PROPERTIES COMPILE_FLAGS "-mavx")
+            set_source_files_properties(
+                ${PREFIX}/sfizz/simd/InterpolatorsAVX2.cpp
+                PROPERTIES COMPILE_FLAGS "-mavx2")
+        elseif(MSVC AND NOT CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+            # MSVC has the intrinsics always, but defines __AVX__ only
+            # with the matching architecture
+            set_source_files_properties(
+                ${PREFIX}/sfizz/effects/impl/ResonantStringAVX.cpp
+                ${PREFIX}/sfizz/effects/impl/ResonantArrayAVX.cpp
+                ${PREFIX}/sfizz/simd/HelpersAVX.cpp
+                PROPERTIES COMPILE_FLAGS "/arch:AVX")
+            set_source_files_properties(
+                ${PREFIX}/sfizz/simd/InterpolatorsAVX2.cpp
+                PROPERTIES COMPILE_FLAGS "/arch:AVX2")
         endif()
     endif()
 endmacro()
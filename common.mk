@@ -86,7 +86,9 @@ SFIZZ_SOURCES = \
 	src/sfizz/FileId.cpp \
 	src/sfizz/FileMetadata.cpp \
 	src/sfizz/FilePool.cpp \
+	src/sfizz/FileStream.cpp \
 	src/sfizz/FilterPool.cpp \
+	src/sfizz/FilterSubmix.cpp \
 	src/sfizz/FlexEGDescription.cpp \
 	src/sfizz/FlexEnvelope.cpp \
 	src/sfizz/Interpolators.cpp \
@@ -94,9 +96,13 @@ SFIZZ_SOURCES = \
 	src/sfizz/Logger.cpp \
 	src/sfizz/LFO.cpp \
 	src/sfizz/LFODescription.cpp \
+	src/sfizz/MappedFile.cpp \
+	src/sfizz/MappedSample.cpp \
 	src/sfizz/Messaging.cpp \
 	src/sfizz/Metronome.cpp \
 	src/sfizz/MidiState.cpp \
+	src/sfizz/NoiseGenerator.cpp \
+	src/sfizz/NoteActivationIndex.cpp \
 	src/sfizz/OpcodeCleanup.cpp \
 	src/sfizz/Opcode.cpp \
 	src/sfizz/Oversampler.cpp \
@@ -108,8 +114,11 @@ SFIZZ_SOURCES = \
 	src/sfizz/Region.cpp \
 	src/sfizz/RegionSet.cpp \
 	src/sfizz/RegionStateful.cpp \
+	src/sfizz/RenderPool.cpp \
 	src/sfizz/Resources.cpp \
 	src/sfizz/RTSemaphore.cpp \
+	src/sfizz/SampleCache.cpp \
+	src/sfizz/SampleStore.cpp \
 	src/sfizz/ScopedFTZ.cpp \
 	src/sfizz/sfizz.cpp \
 	src/sfizz/sfizz_wrapper.cpp \
@@ -117,12 +126,14 @@ SFIZZ_SOURCES = \
 	src/sfizz/SIMDHelpers.cpp \
 	src/sfizz/simd/HelpersSSE.cpp \
 	src/sfizz/simd/HelpersAVX.cpp \
+	src/sfizz/simd/InterpolatorsAVX2.cpp \
 	src/sfizz/Smoothers.cpp \
 	src/sfizz/Synth.cpp \
 	src/sfizz/SynthMessaging.cpp \
 	src/sfizz/Tuning.cpp \
 	src/sfizz/utility/spin_mutex/SpinMutex.cpp \
 	src/sfizz/Voice.cpp \
+	src/sfizz/VoiceDecimator.cpp \
 	src/sfizz/VoiceManager.cpp \
 	src/sfizz/VoiceStealing.cpp \
 	src/sfizz/Wavetables.cpp \
@@ -81,6 +81,21 @@ typedef enum {
     SFIZZ_PROCESS_FREEWHEELING,
 } sfizz_process_mode_t;
 
+/**
+ * @brief Statistics about the sample data shared by the synths of the process
+ * @since 1.1.0
+ */
+typedef struct {
+    size_t num_users;          //!< Number of synths using the shared sample data
+    size_t num_samples;        //!< Number of samples held
+    size_t num_shared_samples; //!< Number of samples used by more than one synth
+    size_t preloaded_bytes;    //!< Bytes of preloaded sample data
+    size_t loaded_bytes;       //!< Bytes of sample data loaded in the background
+    size_t saved_bytes;        //!< Bytes the synths would hold in addition without sharing
+    size_t num_hits;           //!< Number of samples requested and found shared
+    size_t num_misses;         //!< Number of samples requested and not found shared
+} sfizz_sample_store_stats_t;
+
 /**
  * @brief Creates a sfizz synth.
  *
@@ -874,6 +889,120 @@ SFIZZ_EXPORTED_API void sfizz_set_num_voices(sfizz_synth_t* synth, int num_voice
  */
 SFIZZ_EXPORTED_API int sfizz_get_num_voices(sfizz_synth_t* synth);
 
+/**
+ * @brief Set the number of threads which render the voices.
+ *
+ * With 1 thread, which is the default, the voices are rendered on the
+ * thread which calls @ref sfizz_render_block. With more threads, additional
+ * worker threads are started to render the voices concurrently with it.
+ * @since 1.1.0
+ *
+ * @param synth        The synth.
+ * @param num_threads  The number of render threads, including the calling thread.
+ *
+ * @par Thread-safety constraints
+ * - @b CT: the function must be invoked from the Control thread
+ * - @b OFF: the function cannot be invoked while a thread is calling @b RT functions
+ */
+SFIZZ_EXPORTED_API void sfizz_set_num_render_threads(sfizz_synth_t* synth, int num_threads);
+
+/**
+ * @brief Return the number of threads which render the voices.
+ * @since 1.1.0
+ *
+ * @param synth  The synth.
+ */
+SFIZZ_EXPORTED_API int sfizz_get_num_render_threads(sfizz_synth_t* synth);
+
+/**
+ * @brief Set whether the samples are streamed from disk.
+ *
+ * When enabled, the frames of the samples past the preloaded size are read by
+ * the background loaders into a fixed ring buffer for each voice, instead of
+ * the whole file being loaded in memory when it is played.
+ * The memory used then scales with the polyphony rather than with the length
+ * of the samples. This has no effect on samples loaded with `hint_ram_based`.
+ * @since 1.1.0
+ *
+ * @param synth      The synth.
+ * @param streaming  Whether to stream the samples from disk.
+ *
+ * @par Thread-safety constraints
+ * - @b CT: the function must be invoked from the Control thread
+ * - @b OFF: the function cannot be invoked while a thread is calling @b RT functions
+ */
+SFIZZ_EXPORTED_API void sfizz_set_disk_streaming(sfizz_synth_t* synth, bool streaming);
+
+/**
+ * @brief Return whether the samples are streamed from disk.
+ * @since 1.1.0
+ *
+ * @param synth  The synth.
+ */
+SFIZZ_EXPORTED_API bool sfizz_get_disk_streaming(sfizz_synth_t* synth);
+
+/**
+ * @brief Set whether the uncompressed WAV samples are memory-mapped.
+ *
+ * When enabled, the frames of the 16, 24 or 32-bit PCM and 32-bit float WAV
+ * samples past the preloaded size are read in place from a memory mapping of
+ * the file, instead of the whole file being loaded in memory when it is
+ * played. The system page cache then holds the sample data, and shares it
+ * between the instances which play the same files.
+ * This has no effect on samples loaded with `hint_ram_based`.
+ * @since 1.1.0
+ *
+ * @param synth    The synth.
+ * @param mapping  Whether to memory-map the samples.
+ *
+ * @par Thread-safety constraints
+ * - @b CT: the function must be invoked from the Control thread
+ * - @b OFF: the function cannot be invoked while a thread is calling @b RT functions
+ */
+SFIZZ_EXPORTED_API void sfizz_set_sample_memory_mapping(sfizz_synth_t* synth, bool mapping);
+
+/**
+ * @brief Return whether the uncompressed WAV samples are memory-mapped.
+ * @since 1.1.0
+ *
+ * @param synth  The synth.
+ */
+SFIZZ_EXPORTED_API bool sfizz_get_sample_memory_mapping(sfizz_synth_t* synth);
+
+/**
+ * @brief Set the directory where the sample information and preloaded data
+ * are cached across sessions.
+ *
+ * The cached entries are used on the next loads of the same sample files,
+ * as long as these are not modified. The cache is disabled by default.
+ * @since 1.1.0
+ *
+ * @param synth      The synth.
+ * @param directory  The cache directory, or NULL or an empty string to
+ *                   disable the cache.
+ *
+ * @par Thread-safety constraints
+ * - @b CT: the function must be invoked from the Control thread
+ * - @b OFF: the function cannot be invoked while a thread is calling @b RT functions
+ */
+SFIZZ_EXPORTED_API void sfizz_set_sample_cache_directory(sfizz_synth_t* synth, const char* directory);
+
+/**
+ * @brief Get statistics about the sample data.
+ *
+ * The synths of the process which play the same sample files with the same
+ * preloading settings share their sample data, which is decoded and held
+ * only once.
+ * @since 1.1.0
+ *
+ * @param synth  The synth.
+ * @param stats  The statistics, filled by the function.
+ *
+ * @par Thread-safety constraints
+ * - @b CT: the function must be invoked from the Control thread
+ */
+SFIZZ_EXPORTED_API void sfizz_get_sample_store_stats(sfizz_synth_t* synth, sfizz_sample_store_stats_t* stats);
+
 /**
  * @brief Return the number of allocated buffers from the synth.
  * @since 0.2.0
@@ -771,6 +771,125 @@ public:
      */
     void setNumVoices(int numVoices) noexcept;
 
+    /**
+     * @brief Return the number of threads which render the voices.
+     * @since 1.1.0
+     */
+    int getNumRenderThreads() const noexcept;
+
+    /**
+     * @brief Change the number of threads which render the voices.
+     *
+     * With 1 thread, which is the default, the voices are rendered on the
+     * thread which calls @ref renderBlock. With more threads, additional
+     * worker threads are started to render the voices concurrently with it.
+     *
+     * @since 1.1.0
+     *
+     * @param numThreads The number of render threads, including the calling thread.
+     *
+     * @par Thread-safety constraints
+     * - @b CT: the function must be invoked from the Control thread
+     * - @b OFF: the function cannot be invoked while a thread is calling @b RT functions
+     */
+    void setNumRenderThreads(int numThreads) noexcept;
+
+    /**
+     * @brief Return whether the samples are streamed from disk.
+     * @since 1.1.0
+     */
+    bool isDiskStreaming() const noexcept;
+
+    /**
+     * @brief Change whether the samples are streamed from disk.
+     *
+     * When enabled, the frames of the samples past the preloaded size are read
+     * by the background loaders into a fixed ring buffer for each voice,
+     * instead of the whole file being loaded in memory when it is played.
+     * This has no effect on samples loaded with `hint_ram_based`.
+     *
+     * @since 1.1.0
+     *
+     * @param streaming Whether to stream the samples from disk.
+     *
+     * @par Thread-safety constraints
+     * - @b CT: the function must be invoked from the Control thread
+     * - @b OFF: the function cannot be invoked while a thread is calling @b RT functions
+     */
+    void setDiskStreaming(bool streaming) noexcept;
+
+    /**
+     * @brief Return whether the uncompressed WAV samples are memory-mapped.
+     * @since 1.1.0
+     */
+    bool isSampleMemoryMapping() const noexcept;
+
+    /**
+     * @brief Change whether the uncompressed WAV samples are memory-mapped.
+     *
+     * When enabled, the frames of the 16, 24 or 32-bit PCM and 32-bit float
+     * WAV samples past the preloaded size are read in place from a memory
+     * mapping of the file, instead of the whole file being loaded in memory
+     * when it is played. The system page cache then holds the sample data,
+     * and shares it between the instances which play the same files.
+     * This has no effect on samples loaded with `hint_ram_based`.
+     *
+     * @since 1.1.0
+     *
+     * @param mapping Whether to memory-map the samples.
+     *
+     * @par Thread-safety constraints
+     * - @b CT: the function must be invoked from the Control thread
+     * - @b OFF: the function cannot be invoked while a thread is calling @b RT functions
+     */
+    void setSampleMemoryMapping(bool mapping) noexcept;
+
+    /**
+     * @brief Set the directory where the sample information and preloaded
+     * data are cached across sessions.
+     *
+     * The cached entries are used on the next loads of the same sample files,
+     * as long as these are not modified. The cache is disabled by default.
+     *
+     * @since 1.1.0
+     *
+     * @param directory The cache directory, or an empty string to disable the cache.
+     *
+     * @par Thread-safety constraints
+     * - @b CT: the function must be invoked from the Control thread
+     * - @b OFF: the function cannot be invoked while a thread is calling @b RT functions
+     */
+    void setSampleCacheDirectory(const std::string& directory) noexcept;
+
+    /**
+     * @brief Statistics about the sample data shared by the synths of the process.
+     * @since 1.1.0
+     */
+    struct SampleStoreStats {
+        size_t numUsers; //!< Number of synths using the shared sample data
+        size_t numSamples; //!< Number of samples held
+        size_t numSharedSamples; //!< Number of samples used by more than one synth
+        size_t preloadedBytes; //!< Bytes of preloaded sample data
+        size_t loadedBytes; //!< Bytes of sample data loaded in the background
+        size_t savedBytes; //!< Bytes the synths would hold in addition without sharing
+        size_t numHits; //!< Number of samples requested and found shared
+        size_t numMisses; //!< Number of samples requested and not found shared
+    };
+
+    /**
+     * @brief Get statistics about the sample data.
+     *
+     * The synths of the process which play the same sample files with the
+     * same preloading settings share their sample data, which is decoded and
+     * held only once.
+     *
+     * @since 1.1.0
+     *
+     * @par Thread-safety constraints
+     * - @b CT: the function must be invoked from the Control thread
+     */
+    SampleStoreStats getSampleStoreStats() const noexcept;
+
     /**
      * @brief Set the oversampling factor to a new value.
      *
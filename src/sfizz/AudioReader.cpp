@@ -72,6 +72,7 @@ public:
     explicit ForwardReader(ST_AudioFile handle);
     AudioReaderType type() const override;
     size_t readNextBlock(float* buffer, size_t frames) override;
+    bool seek(uint64_t frame) override;
 };
 
 ForwardReader::ForwardReader(ST_AudioFile handle)
@@ -93,6 +94,11 @@ size_t ForwardReader::readNextBlock(float* buffer, size_t frames)
     return readFrames;
 }
 
+bool ForwardReader::seek(uint64_t frame)
+{
+    return handle_.seek(frame);
+}
+
 //------------------------------------------------------------------------------
 
 template <size_t N, class T = float>
@@ -141,6 +147,7 @@ public:
     explicit ReverseReader(ST_AudioFile handle);
     AudioReaderType type() const override;
     size_t readNextBlock(float* buffer, size_t frames) override;
+    bool seek(uint64_t frame) override;
 
 private:
     uint64_t position_ {};
@@ -157,35 +164,59 @@ AudioReaderType ReverseReader::type() const
     return AudioReaderType::Reverse;
 }
 
-size_t ReverseReader::readNextBlock(float* buffer, size_t frames)
+/**
+ * @brief Read the frames which precede a position of the file, in reverse
+ * order, and move the position back by the number of frames read.
+ */
+static size_t readFramesBefore(ST_AudioFile& handle, uint64_t& position, float* buffer, size_t frames)
 {
-    uint64_t position = position_;
-    const unsigned channels = handle_.get_channels();
+    const unsigned channels = handle.get_channels();
 
     const uint64_t readFrames = std::min<uint64_t>(frames, position);
     if (readFrames <= 0)
         return false;
 
-    position -= readFrames;
-    if (!handle_.seek(position) ||
-        handle_.read_f32(buffer, readFrames) != readFrames)
+    const uint64_t first = position - readFrames;
+    if (!handle.seek(first) ||
+        handle.read_f32(buffer, readFrames) != readFrames)
         return false;
 
-    position_ = position;
+    position = first;
     reverse_frames(buffer, readFrames, channels);
     return readFrames;
 }
 
+size_t ReverseReader::readNextBlock(float* buffer, size_t frames)
+{
+    return readFramesBefore(handle_, position_, buffer, frames);
+}
+
+bool ReverseReader::seek(uint64_t frame)
+{
+    const uint64_t frameCount = handle_.get_frame_count();
+    if (frame > frameCount)
+        return false;
+
+    position_ = frameCount - frame;
+    return true;
+}
+
 //------------------------------------------------------------------------------
 
 /**
  * @brief Audio file reader in reverse direction, for slow-seeking formats
+ *
+ * Reading from the start decodes the whole file once and serves the blocks
+ * from memory. Once the reader is asked to seek, as the streaming loaders do,
+ * it reads chunks before the position instead, so that the memory stays
+ * bounded by the chunk size, at the cost of a seek of the file per block.
  */
 class NoSeekReverseReader : public BasicSndfileReader {
 public:
     explicit NoSeekReverseReader(ST_AudioFile handle);
     AudioReaderType type() const override;
     size_t readNextBlock(float* buffer, size_t frames) override;
+    bool seek(uint64_t frame) override;
 
 private:
     void readWholeFile();
@@ -193,6 +224,7 @@ private:
 private:
     std::unique_ptr<float[]> fileBuffer_;
     uint64_t fileFramesLeft_ { 0 };
+    bool seeking_ { false };
 };
 
 NoSeekReverseReader::NoSeekReverseReader(ST_AudioFile handle)
@@ -207,6 +239,9 @@ AudioReaderType NoSeekReverseReader::type() const
 
 size_t NoSeekReverseReader::readNextBlock(float* buffer, size_t frames)
 {
+    if (seeking_)
+        return readFramesBefore(handle_, fileFramesLeft_, buffer, frames);
+
     float* fileBuffer = fileBuffer_.get();
     if (!fileBuffer) {
         readWholeFile();
@@ -228,6 +263,18 @@ size_t NoSeekReverseReader::readNextBlock(float* buffer, size_t frames)
     return readFrames;
 }
 
+bool NoSeekReverseReader::seek(uint64_t frame)
+{
+    const uint64_t frameCount = handle_.get_frame_count();
+    if (frame > frameCount)
+        return false;
+
+    // a file which was decoded already keeps being read from memory
+    seeking_ = !fileBuffer_;
+    fileFramesLeft_ = frameCount - frame;
+    return true;
+}
+
 void NoSeekReverseReader::readWholeFile()
 {
     const uint64_t frames = handle_.get_frame_count();
@@ -291,6 +338,7 @@ public:
     unsigned channels() const override { return 1; }
     unsigned sampleRate() const override { return 44100; }
     size_t readNextBlock(float*, size_t) override { return 0; }
+    bool seek(uint64_t) override { return false; }
     bool getInstrument(InstrumentInfo* ) override { return false; }
 
 private:
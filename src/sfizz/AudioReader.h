@@ -39,6 +39,13 @@ public:
     virtual unsigned channels() const = 0;
     virtual unsigned sampleRate() const = 0;
     virtual size_t readNextBlock(float* buffer, size_t frames) = 0;
+    /**
+     * @brief Move the read position, in frames from the start in the direction
+     * of reading. The next block will be read from this position.
+     *
+     * @return true if the position was changed
+     */
+    virtual bool seek(uint64_t frame) = 0;
     virtual bool getInstrument(InstrumentInfo* instrument) = 0;
 };
 
@@ -171,6 +171,10 @@ absl::Span<const int> BeatClock::getRunningBeatsPerBar()
 
 void BeatClock::fillBufferUpTo(unsigned delay)
 {
+    // already up to date, do not write anything
+    if (currentCycleFill_ >= delay && !mustApplyHostPos_)
+        return;
+
     int *beatNumberData = runningBeatNumber_.data();
     float *beatNumberPosition = runningBeatPosition_.data();
     int *beatsPerBarData = runningBeatsPerBar_.data();
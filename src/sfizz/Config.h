@@ -35,12 +35,24 @@ namespace config {
     constexpr float defaultSampleRate { 48000 };
     constexpr float maxSampleRate { 192000 };
     constexpr int defaultSamplesPerBlock { 1024 };
-    constexpr int maxBlockSize { 8192 * 128 };
+    /**
+     * @brief Highest oversampling factor of the voices. The synth sizes its
+     *        blocks and buffer pools to hold a block at this factor.
+     */
+    constexpr int maxOversampling { 128 };
+    constexpr int maxBlockSize { 8192 * maxOversampling };
     constexpr int bufferPoolSize { 6 };
     constexpr int stereoBufferPoolSize { 4 };
-    constexpr int indexBufferPoolSize { 4 };
+    constexpr int indexBufferPoolSize { 5 };
     constexpr int preloadSize { 8192 };
     constexpr bool loadInRam { false };
+    constexpr bool diskStreaming { false };
+    constexpr bool sampleMemoryMapping { false };
+    /**
+     * @brief Number of chunks of `chunkSize` frames which a voice keeps
+     *        ahead of its playhead, when streaming from disk.
+     */
+    constexpr int streamingChunks { 32 };
     constexpr int loggerQueueSize { 256 };
     constexpr int voiceLoggerQueueSize { 256 };
     constexpr bool loggingEnabled { false };
@@ -49,6 +61,7 @@ namespace config {
     constexpr unsigned fileClearingPeriod { 5 }; // in seconds
     constexpr int numVoices { 64 };
     constexpr unsigned maxVoices { 256 };
+    constexpr int maxRenderThreads { 16 };
     constexpr unsigned smoothingSteps { 512 };
     constexpr uint16_t xfadeSmoothing { 5 };
     constexpr uint16_t gainSmoothing { 0 };
@@ -115,6 +128,21 @@ namespace config {
        Limit of how many "fxN" buses are accepted (in SFZv2, maximum is 4)
      */
     constexpr int maxEffectBuses { 256 };
+    /**
+       Duration in seconds of the silence of an effect bus, input and output,
+       after which it stops processing. It is longer than the maximum reverb
+       predelay, so the tails are heard entirely.
+     */
+    constexpr float effectBusTailHold { 11.0f };
+    /**
+       Level under which the output of an effect bus is considered silent
+     */
+    constexpr float effectBusSilenceThreshold { 1e-6f };
+    /**
+       Level under which the output of a filter submix without input is
+       considered silent, at which point its filters are reset
+     */
+    constexpr float filterSubmixSilenceThreshold { 1e-6f };
     // Wavetable constants; amplitude values are matched to reference
     static constexpr unsigned tableSize = 1024;
     static constexpr double tableRefSampleRate = 44100.0 * 1.1; // +10% aliasing permissivity
@@ -135,6 +163,11 @@ namespace config {
        Background file loading
      */
     static constexpr int backgroundLoaderPthreadPriority = 50; // expressed in %
+    /**
+       Voice rendering workers, which run in the audio callback
+     */
+    static constexpr int renderWorkerPthreadPriority = 90; // expressed in %
+    static constexpr unsigned renderWorkerSpinCount = 2048; // before blocking
     /**
        @brief Ratio to target under which smoothing is considered as completed
      */
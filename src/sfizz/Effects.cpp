@@ -104,6 +104,20 @@ void EffectBus::clearInputs(unsigned nframes)
 {
     AudioSpan<float>(_inputs).first(nframes).fill(0.0f);
     AudioSpan<float>(_outputs).first(nframes).fill(0.0f);
+    _hasInput = false;
+    _processed = false;
+}
+
+bool EffectBus::isSilent() const
+{
+    if (_hasInput)
+        return false;
+
+    // without effects, there is nothing remaining from the past cycles
+    if (_effects.empty() || !hasNonZeroOutput())
+        return true;
+
+    return _silentFrames >= _tailFrames;
 }
 
 void EffectBus::addToInputs(const float* const addInput[], float addGain, unsigned nframes)
@@ -111,6 +125,8 @@ void EffectBus::addToInputs(const float* const addInput[], float addGain, unsign
     if (addGain == 0)
         return;
 
+    _hasInput = true;
+
     for (unsigned c = 0; c < EffectChannels; ++c) {
         absl::Span<const float> addIn { addInput[c], nframes };
         sfz::multiplyAdd1(addGain, addIn, _inputs.getSpan(c).first(nframes));
@@ -132,16 +148,27 @@ void EffectBus::setSampleRate(double sampleRate)
 {
     for (const auto& effectPtr : _effects)
         effectPtr->setSampleRate(sampleRate);
+
+    _tailFrames = static_cast<unsigned>(config::effectBusTailHold * sampleRate);
 }
 
 void EffectBus::clear()
 {
     for (const auto& effectPtr : _effects)
         effectPtr->clear();
+
+    // the effects have no tail anymore
+    _silentFrames = _tailFrames;
 }
 
 void EffectBus::process(unsigned nframes)
 {
+    // the outputs are left cleared
+    if (isSilent())
+        return;
+
+    _processed = true;
+
     size_t numEffects = _effects.size();
 
     if (numEffects > 0 && hasNonZeroOutput()) {
@@ -153,10 +180,20 @@ void EffectBus::process(unsigned nframes)
     } else
         fx::Nothing().process(
             AudioSpan<float>(_inputs), AudioSpan<float>(_outputs), nframes);
+
+    bool silent = !_hasInput;
+    for (unsigned c = 0; c < EffectChannels && silent; ++c) {
+        const float threshold = config::effectBusSilenceThreshold;
+        silent = allWithin(_outputs.getConstSpan(c).first(nframes), -threshold, threshold);
+    }
+    _silentFrames = silent ? std::min(_silentFrames + nframes, _tailFrames) : 0;
 }
 
 void EffectBus::mixOutputsTo(float* const mainOutput[], float* const mixOutput[], unsigned nframes)
 {
+    if (!_processed)
+        return;
+
     const float gainToMain = _gainToMain;
     const float gainToMix = _gainToMix;
 
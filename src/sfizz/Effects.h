@@ -132,6 +132,17 @@ public:
      */
     void clearInputs(unsigned nframes);
 
+    /**
+       @brief Checks whether the bus has received some input in this cycle.
+     */
+    bool hasInput() const { return _hasInput; }
+
+    /**
+       @brief Checks whether the bus is silent, having no input in this cycle
+       and an effect tail which has decayed. A silent bus is not processed.
+     */
+    bool isSilent() const;
+
     /**
        @brief Adds some audio into the input buffer.
      */
@@ -181,6 +192,13 @@ private:
     AudioBuffer<float> _outputs { EffectChannels, config::defaultSamplesPerBlock };
     float _gainToMain { Default::effect };
     float _gainToMix { Default::effect };
+    // Whether some input was added in this cycle
+    bool _hasInput { false };
+    // Whether the outputs were computed in this cycle
+    bool _processed { false };
+    // Duration of the silence of the inputs and outputs, and its limit
+    unsigned _silentFrames { 0 };
+    unsigned _tailFrames { 0 };
 };
 
 } // namespace sfz
@@ -24,6 +24,10 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "FilePool.h"
+#include "FileStream.h"
+#include "MappedSample.h"
+#include "SampleCache.h"
+#include "SampleStore.h"
 #include "AudioReader.h"
 #include "Buffer.h"
 #include "AudioBuffer.h"
@@ -36,7 +40,9 @@
 #include <absl/strings/match.h>
 #include <absl/memory/memory.h>
 #include <algorithm>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <system_error>
 #if defined(_WIN32)
@@ -69,6 +75,150 @@ static std::shared_ptr<ThreadPool> globalThreadPool()
     return threadPool;
 }
 
+/**
+ * @brief The background loaders, shared by all the file pools of the process.
+ *
+ * The audio threads push their requests to a lock-free queue and post a
+ * semaphore, without locking or allocating. The loaders move the queued
+ * requests into a heap ordered by urgency, which is a locked queue shared by
+ * the loaders only, and serve the most urgent request first.
+ */
+class sfz::FilePool::LoaderPool {
+public:
+    LoaderPool();
+    ~LoaderPool();
+
+    /**
+     * @brief Get the loader pool of the process, started on first use and
+     * stopped when its last file pool is destroyed.
+     */
+    static std::shared_ptr<LoaderPool> getShared();
+
+    /**
+     * @brief Queue a request. This is called from the audio threads.
+     *
+     * @return true if the request was queued
+     */
+    bool queueRequest(const LoadRequest& request) noexcept;
+
+    /**
+     * @brief Get the maximum number of requests in the queue.
+     */
+    size_t capacity() const noexcept { return loadRequests->capacity(); }
+
+private:
+    bool takeMostUrgentRequest(LoadRequest& request) noexcept;
+    void loaderJob() noexcept;
+
+    // shared by the file pools of all the synths
+    static constexpr unsigned maxLoadRequests { 8 * config::maxVoices };
+    using RequestQueue = atomic_queue::AtomicQueue2<LoadRequest, maxLoadRequests>;
+    aligned_unique_ptr<RequestQueue> loadRequests;
+    // Requests taken from the queue, ordered by urgency
+    SpinMutex scheduledRequestsMutex;
+    std::vector<LoadRequest> scheduledRequests;
+
+    volatile bool loaderFlag { true };
+    RTSemaphore loaderBarrier;
+    std::vector<std::thread> loaderThreads;
+};
+
+std::shared_ptr<sfz::FilePool::LoaderPool> sfz::FilePool::LoaderPool::getShared()
+{
+    static std::weak_ptr<LoaderPool> globalLoaderPoolWeakPtr;
+    static std::mutex globalLoaderPoolMutex;
+
+    std::lock_guard<std::mutex> lock(globalLoaderPoolMutex);
+    std::shared_ptr<LoaderPool> loaderPool = globalLoaderPoolWeakPtr.lock();
+    if (loaderPool)
+        return loaderPool;
+
+    loaderPool.reset(new LoaderPool);
+    globalLoaderPoolWeakPtr = loaderPool;
+    return loaderPool;
+}
+
+sfz::FilePool::LoaderPool::LoaderPool()
+    : loadRequests(alignedNew<RequestQueue>())
+{
+    scheduledRequests.reserve(maxLoadRequests);
+
+    loaderThreads.reserve(config::numBackgroundThreads);
+    for (int i = 0; i < config::numBackgroundThreads; ++i)
+        loaderThreads.emplace_back(&LoaderPool::loaderJob, this);
+}
+
+sfz::FilePool::LoaderPool::~LoaderPool()
+{
+    std::error_code ec;
+
+    loaderFlag = false;
+    for (size_t i = 0; i < loaderThreads.size(); ++i)
+        loaderBarrier.post(ec);
+    for (std::thread& thread : loaderThreads)
+        thread.join();
+}
+
+bool sfz::FilePool::LoaderPool::queueRequest(const LoadRequest& request) noexcept
+{
+    if (!loadRequests->try_push(request))
+        return false;
+
+    // one post per queued request, and each loader wakeup takes one request
+    std::error_code ec;
+    loaderBarrier.post(ec);
+    ASSERT(!ec);
+
+    return true;
+}
+
+bool sfz::FilePool::LoaderPool::takeMostUrgentRequest(LoadRequest& request) noexcept
+{
+    const auto lessUrgent = [](const LoadRequest& lhs, const LoadRequest& rhs) {
+        return lhs.isLessUrgentThan(rhs);
+    };
+
+    std::lock_guard<SpinMutex> guard { scheduledRequestsMutex };
+
+    // the capacity of the heap is the one of the queue, so that this
+    // never allocates
+    LoadRequest queued;
+    while (scheduledRequests.size() < scheduledRequests.capacity() && loadRequests->try_pop(queued)) {
+        scheduledRequests.push_back(std::move(queued));
+        std::push_heap(scheduledRequests.begin(), scheduledRequests.end(), lessUrgent);
+    }
+
+    if (scheduledRequests.empty())
+        return false;
+
+    std::pop_heap(scheduledRequests.begin(), scheduledRequests.end(), lessUrgent);
+    request = std::move(scheduledRequests.back());
+    scheduledRequests.pop_back();
+    return true;
+}
+
+void sfz::FilePool::LoaderPool::loaderJob() noexcept
+{
+    raiseCurrentThreadPriority();
+
+    while (loaderBarrier.wait(), loaderFlag) {
+        LoadRequest request;
+        if (!takeMostUrgentRequest(request))
+            continue;
+
+        // only the refills carry a stream, and those whose voice is gone
+        // find no file data to load either
+        FilePool& pool = *request.pool;
+        if (request.stream.expired())
+            pool.loadingJob(request);
+        else
+            pool.streamingJob(request);
+
+        // the file pool may be destroyed as soon as this returns
+        pool.finishRequest();
+    }
+}
+
 void readBaseFile(sfz::AudioReader& reader, sfz::FileAudioBuffer& output, uint32_t numFrames)
 {
     output.reset();
@@ -142,12 +292,14 @@ void streamFromFile(sfz::AudioReader& reader, sfz::FileAudioBuffer& output, std:
 
 sfz::FilePool::FilePool(sfz::Logger& logger)
     : logger(logger),
-      filesToLoad(alignedNew<FileQueue>()),
+      sampleCache(new SampleCache),
+      sampleStore(SampleStore::getShared()),
+      loaderPool(LoaderPool::getShared()),
       threadPool(globalThreadPool())
 {
-    loadingJobs.reserve(config::maxVoices);
     lastUsedFiles.reserve(config::maxVoices);
     garbageToCollect.reserve(config::maxVoices);
+    sampleStore->addUser();
 }
 
 sfz::FilePool::~FilePool()
@@ -158,12 +310,10 @@ sfz::FilePool::~FilePool()
     semGarbageBarrier.post(ec);
     garbageThread.join();
 
-    dispatchFlag = false;
-    dispatchBarrier.post(ec);
-    dispatchThread.join();
+    // the shared loaders must be done with the requests of this pool
+    waitForBackgroundLoading();
 
-    for (auto& job : loadingJobs)
-        job.wait();
+    sampleStore->removeUser();
 }
 
 bool sfz::FilePool::checkSample(std::string& filename) const noexcept
@@ -233,6 +383,10 @@ bool sfz::FilePool::checkSample(std::string& filename) const noexcept
 
 bool sfz::FilePool::checkSampleId(FileId& fileId) const noexcept
 {
+    // already found and read by a previous region
+    if (preloadedFiles.find(fileId) != preloadedFiles.end())
+        return true;
+
     std::string filename = fileId.filename();
     bool result = checkSample(filename);
     if (result)
@@ -240,28 +394,24 @@ bool sfz::FilePool::checkSampleId(FileId& fileId) const noexcept
     return result;
 }
 
-absl::optional<sfz::FileInformation> sfz::FilePool::getFileInformation(const FileId& fileId) noexcept
+static absl::optional<sfz::FileInformation> readFileInformation(
+    const sfz::FileId& fileId, const fs::path& file, sfz::AudioReader& reader) noexcept
 {
-    const fs::path file { rootDirectory / fileId.filename() };
-
-    if (!fs::exists(file))
-        return {};
-
-    AudioReaderPtr reader = createAudioReader(file, fileId.isReverse());
-    const unsigned channels = reader->channels();
+    using namespace sfz;
+    const unsigned channels = reader.channels();
 
     if (channels != 1 && channels != 2) {
-        DBG("[sfizz] Missing logic for " << reader->channels() << " channels, discarding sample " << fileId);
+        DBG("[sfizz] Missing logic for " << reader.channels() << " channels, discarding sample " << fileId);
         return {};
     }
 
     FileInformation returnedValue;
-    returnedValue.end = static_cast<uint32_t>(reader->frames()) - 1;
-    returnedValue.sampleRate = static_cast<double>(reader->sampleRate());
-    returnedValue.numChannels = static_cast<int>(reader->channels());
+    returnedValue.end = static_cast<uint32_t>(reader.frames()) - 1;
+    returnedValue.sampleRate = static_cast<double>(reader.sampleRate());
+    returnedValue.numChannels = static_cast<int>(reader.channels());
 
     InstrumentInfo instrumentInfo {};
-    bool haveInstrumentInfo = reader->getInstrument(&instrumentInfo);
+    bool haveInstrumentInfo = reader.getInstrument(&instrumentInfo);
 
     FileMetadataReader mdReader;
     bool mdReaderOpened = mdReader.open(file);
@@ -296,87 +446,370 @@ absl::optional<sfz::FileInformation> sfz::FilePool::getFileInformation(const Fil
     return returnedValue;
 }
 
-bool sfz::FilePool::preloadFile(const FileId& fileId, uint32_t maxOffset) noexcept
+absl::optional<sfz::FileInformation> sfz::FilePool::getFileInformation(const FileId& fileId) noexcept
 {
-    auto fileInformation = getFileInformation(fileId);
-    if (!fileInformation)
-        return false;
+    const auto preloaded = preloadedFiles.find(fileId);
+    if (preloaded != preloadedFiles.end())
+        return preloaded->second.data->information;
 
-    fileInformation->maxOffset = maxOffset;
+    const auto probed = probedFiles.find(fileId);
+    if (probed != probedFiles.end())
+        return probed->second;
+
+    // Only read the header here: the frames are decoded once, by the next
+    // preloading pass which knows the offsets of all the regions
     const fs::path file { rootDirectory / fileId.filename() };
-    AudioReaderPtr reader = createAudioReader(file, fileId.isReverse());
+    const bool reverse = fileId.isReverse();
 
-    const auto frames = static_cast<uint32_t>(reader->frames());
-    const auto framesToLoad = [&]() {
-        if (loadInRam)
-            return frames;
+    absl::optional<FileInformation> information =
+        sampleStore->findInformation(SampleStore::makeKey(file, reverse));
+
+    SampleCache::Entry cached;
+    if (!information && sampleCache->lookup(file, reverse, cached))
+        information = cached.information;
+
+    if (!information) {
+        std::error_code readError;
+        AudioReaderPtr reader = createAudioReader(file, reverse, &readError);
+        if (readError) {
+            DBG("[sfizz] reading the file errored for " << fileId << " with code " << readError << ": " << readError.message());
+            return {};
+        }
+        information = readFileInformation(fileId, file, *reader);
+        if (!information)
+            return {};
+    }
+
+    probedFiles.emplace(fileId, *information);
+    return information;
+}
+
+uint32_t sfz::FilePool::getFramesToLoad(const FileInformation& information, uint32_t maxOffset, bool wholeFile) const noexcept
+{
+    const auto frames = static_cast<uint32_t>(information.end + 1);
+    if (loadInRam || wholeFile)
+        return frames;
+    else
+        return min(frames, maxOffset + preloadSize);
+}
+
+struct sfz::FilePool::PreloadJob {
+    const FileId* id { nullptr };
+    uint32_t maxOffset { 0 };
+    bool wholeFile { false };
+    bool mapped { false };
+    SampleStore::FileKey key;
+    absl::optional<FileInformation> information;
+    FileAudioBuffer data;
+    std::shared_ptr<const MappedFile> cachedMapping;
+    AudioSpan<const float> cachedData;
+    std::shared_ptr<MappedSample> mappedData;
+    bool done { false };
+};
+
+std::shared_ptr<sfz::MappedSample> sfz::FilePool::mapFile(const FileId& fileId, const FileInformation& information) const noexcept
+{
+    const fs::path file { rootDirectory / fileId.filename() };
+    std::shared_ptr<MappedSample> mapped = MappedSample::open(file, fileId.isReverse());
+
+    // the mapping must agree with the decoder about the frames
+    if (!mapped || mapped->getNumFrames() != information.end + 1
+        || mapped->getNumChannels() != static_cast<unsigned>(information.numChannels))
+        return {};
+
+    return mapped;
+}
+
+void sfz::FilePool::readPreloadJob(PreloadJob& job) const noexcept
+{
+    const fs::path file { rootDirectory / job.id->filename() };
+    const bool reverse = job.id->isReverse();
+
+    // a cache entry with enough frames spares decoding the file
+    SampleCache::Entry cached;
+    if (sampleCache->lookup(file, reverse, cached)) {
+        if (!job.information)
+            job.information = cached.information;
+
+        const auto framesToLoad = getFramesToLoad(*job.information, job.maxOffset, job.wholeFile);
+        if (cached.numFrames >= framesToLoad) {
+            // the frames are read from the mapping of the entry in place
+            job.information->maxOffset = job.maxOffset;
+            job.cachedData = cached.getFrames(framesToLoad);
+            job.cachedMapping = std::move(cached.mapping);
+            if (job.mapped)
+                job.mappedData = mapFile(*job.id, *job.information);
+            job.done = true;
+            return;
+        }
+    }
+
+    std::error_code readError;
+    AudioReaderPtr reader = createAudioReader(file, reverse, &readError);
+    if (readError) {
+        DBG("[sfizz] reading the file errored for " << *job.id << " with code " << readError << ": " << readError.message());
+        return;
+    }
+
+    // files seen for the first time also have their information read
+    if (!job.information) {
+        job.information = readFileInformation(*job.id, file, *reader);
+        if (!job.information)
+            return;
+    }
+
+    job.information->maxOffset = job.maxOffset;
+    job.data = readFromFile(*reader, getFramesToLoad(*job.information, job.maxOffset, job.wholeFile));
+
+    // only the preloaded head is cached, even if the whole file is loaded
+    const auto headFrames = min(static_cast<uint32_t>(job.information->end + 1), job.maxOffset + preloadSize);
+    sampleCache->store(file, reverse, *job.information, job.data, headFrames);
+    if (job.mapped)
+        job.mappedData = mapFile(*job.id, *job.information);
+    job.done = true;
+}
+
+void sfz::FilePool::preloadFiles(const std::vector<std::pair<FileId, uint32_t>>& files) noexcept
+{
+    acquireFiles(files, false);
+}
+
+void sfz::FilePool::acquireFiles(const std::vector<std::pair<FileId, uint32_t>>& files, bool wholeFiles) noexcept
+{
+    const bool mapped = shouldMap();
+
+    // the replaced entries which voices still read are kept until they are done
+    swapAndPopAll(retiredFiles, [](const std::shared_ptr<FileData>& data) {
+        return data->readerCount == 0;
+    });
+
+    const auto setPreloadedFile = [&](const FileId& fileId, std::shared_ptr<FileData> data, uint32_t maxOffset) {
+        PreloadedFile& preloaded = preloadedFiles[fileId];
+        if (preloaded.data && preloaded.data != data && preloaded.data->readerCount != 0)
+            retiredFiles.push_back(std::move(preloaded.data));
+        preloaded.data = std::move(data);
+        preloaded.maxOffset = maxOffset;
+        preloaded.mapped = mapped;
+    };
+
+    std::vector<PreloadJob> jobs;
+    jobs.reserve(files.size());
+
+    for (const auto& file : files) {
+        PreloadJob job;
+        job.id = &file.first;
+        job.maxOffset = file.second;
+        job.wholeFile = wholeFiles;
+        job.mapped = mapped;
+        job.key = SampleStore::makeKey(rootDirectory / file.first.filename(), file.first.isReverse());
+
+        // the information is known if this pool or another one holds the file
+        const auto existingFile = preloadedFiles.find(file.first);
+        const auto probedFile = probedFiles.find(file.first);
+        if (existingFile != preloadedFiles.end())
+            job.information = existingFile->second.data->information;
+        else if (probedFile != probedFiles.end())
+            job.information = probedFile->second;
         else
-            return min(frames, maxOffset + preloadSize);
-    }();
-
-    const auto existingFile = preloadedFiles.find(fileId);
-    if (existingFile != preloadedFiles.end()) {
-        if (framesToLoad > existingFile->second.preloadedData.getNumFrames()) {
-            preloadedFiles[fileId].information.maxOffset = maxOffset;
-            preloadedFiles[fileId].preloadedData = readFromFile(*reader, framesToLoad);
+            job.information = sampleStore->findInformation(job.key);
+
+        if (job.information) {
+            const auto framesToLoad = getFramesToLoad(*job.information, job.maxOffset, wholeFiles);
+            if (existingFile != preloadedFiles.end()) {
+                PreloadedFile& preloaded = existingFile->second;
+                if (preloaded.data->getNumPreloadedFrames() == framesToLoad && preloaded.mapped == mapped) {
+                    preloaded.maxOffset = job.maxOffset;
+                    continue;
+                }
+            }
+
+            if (std::shared_ptr<FileData> data = sampleStore->find(job.key, framesToLoad, mapped)) {
+                setPreloadedFile(file.first, std::move(data), job.maxOffset);
+                continue;
+            }
         }
-    } else {
-        fileInformation->sampleRate = static_cast<double>(reader->sampleRate());
-        auto insertedPair = preloadedFiles.insert_or_assign(fileId, {
-            readFromFile(*reader, framesToLoad),
-            *fileInformation
-        });
 
-        if (!insertedPair.second)
-            return false;
+        jobs.push_back(std::move(job));
+    }
+
+    if (jobs.empty())
+        return;
+
+    // The jobs are taken in turn by the helpers on the thread pool and by the
+    // calling thread, which ensures progress even if the pool is busy
+    std::atomic<size_t> nextJob { 0 };
+    const auto work = [this, &jobs, &nextJob]() {
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+            readPreloadJob(jobs[i]);
+    };
+
+    const size_t numHelpers = std::min<size_t>(jobs.size(), maxPreloadingJobs) - 1;
+    std::vector<std::future<void>> helpers;
+    helpers.reserve(numHelpers);
+    for (size_t i = 0; i < numHelpers; ++i)
+        helpers.push_back(threadPool->enqueue(work));
 
-        insertedPair.first->second.status = FileData::Status::Preloaded;
+    work();
+
+    for (auto& helper : helpers)
+        helper.wait();
+
+    for (PreloadJob& job : jobs) {
+        if (!job.done)
+            continue;
+
+        auto data = job.cachedMapping ?
+            std::make_shared<FileData>(std::move(job.cachedMapping), job.cachedData, std::move(*job.information)) :
+            std::make_shared<FileData>(std::move(job.data), std::move(*job.information));
+        data->mappedData = std::move(job.mappedData);
+        data->status = FileData::Status::Preloaded;
+        setPreloadedFile(*job.id, sampleStore->insert(job.key, mapped, std::move(data)), job.maxOffset);
     }
-    return true;
 }
 
-sfz::FileDataHolder sfz::FilePool::loadFile(const FileId& fileId) noexcept
+void sfz::FilePool::reacquireFiles() noexcept
 {
-    auto fileInformation = getFileInformation(fileId);
-    if (!fileInformation)
-        return {};
+    std::vector<std::pair<FileId, uint32_t>> files;
+    files.reserve(preloadedFiles.size());
+    for (const auto& preloadedFile : preloadedFiles)
+        files.emplace_back(preloadedFile.first, preloadedFile.second.maxOffset);
 
-    const fs::path file { rootDirectory / fileId.filename() };
-    AudioReaderPtr reader = createAudioReader(file, fileId.isReverse());
+    acquireFiles(files, false);
+}
 
-    const auto frames = static_cast<uint32_t>(reader->frames());
-    const auto existingFile = loadedFiles.find(fileId);
-    if (existingFile != loadedFiles.end()) {
-        return { &existingFile->second };
-    } else {
-        fileInformation->sampleRate = static_cast<double>(reader->sampleRate());
-        auto insertedPair = preloadedFiles.insert_or_assign(fileId, {
-            readFromFile(*reader, frames),
-            *fileInformation
-        });
-        insertedPair.first->second.status = FileData::Status::Preloaded;
-        return { &insertedPair.first->second };
+bool sfz::FilePool::preloadFile(const FileId& fileId, uint32_t maxOffset) noexcept
+{
+    preloadFiles({ { fileId, maxOffset } });
+    return preloadedFiles.find(fileId) != preloadedFiles.end();
+}
+
+void sfz::FilePool::loadFiles(const std::vector<FileId>& fileIds) noexcept
+{
+    std::vector<std::pair<FileId, uint32_t>> files;
+    files.reserve(fileIds.size());
+    for (const FileId& fileId : fileIds) {
+        const auto existingFile = preloadedFiles.find(fileId);
+        const uint32_t maxOffset = (existingFile != preloadedFiles.end()) ? existingFile->second.maxOffset : 0;
+        files.emplace_back(fileId, maxOffset);
     }
+
+    acquireFiles(files, true);
 }
 
-sfz::FileDataHolder sfz::FilePool::getFilePromise(const std::shared_ptr<FileId>& fileId) noexcept
+sfz::FileDataHolder sfz::FilePool::loadFile(const FileId& fileId) noexcept
+{
+    auto existingFile = preloadedFiles.find(fileId);
+    const uint32_t maxOffset = (existingFile != preloadedFiles.end()) ? existingFile->second.maxOffset : 0;
+    acquireFiles({ { fileId, maxOffset } }, true);
+
+    existingFile = preloadedFiles.find(fileId);
+    if (existingFile == preloadedFiles.end())
+        return {};
+
+    return { existingFile->second.data.get() };
+}
+
+sfz::FileDataHolder sfz::FilePool::getFilePromise(const std::shared_ptr<FileId>& fileId, uint64_t startFrame) noexcept
 {
     const auto preloaded = preloadedFiles.find(*fileId);
     if (preloaded == preloadedFiles.end()) {
         DBG("[sfizz] File not found in the preloaded files: " << fileId);
         return {};
     }
-    QueuedFileData queuedData { fileId, &preloaded->second, std::chrono::high_resolution_clock::now() };
-    if (!filesToLoad->try_push(queuedData)) {
-        DBG("[sfizz] Could not enqueue the file to load for " << fileId << " (queue capacity " << filesToLoad->capacity() << ")");
+
+    // the voices stream or map the data past the preloaded frames themselves
+    const std::shared_ptr<FileData>& data = preloaded->second.data;
+    if (streaming || (memoryMapping && data->mappedData))
+        return { data.get() };
+
+    LoadRequest request;
+    request.id = fileId;
+    request.data = data;
+    request.queuedTime = std::chrono::high_resolution_clock::now();
+    request.deadline = request.queuedTime;
+
+    // the voice runs out of preloaded frames first from its start frame
+    const auto preloadedFrames = static_cast<uint64_t>(data->getNumPreloadedFrames());
+    if (startFrame < preloadedFrames && data->information.sampleRate > 0) {
+        const double seconds = (preloadedFrames - startFrame) / data->information.sampleRate;
+        request.deadline += std::chrono::duration_cast<LoadRequest::TimePoint::duration>(
+            std::chrono::duration<double>(seconds));
+    }
+
+    if (!queueRequest(request)) {
+        DBG("[sfizz] Could not enqueue the file to load for " << fileId << " (queue capacity " << loaderPool->capacity() << ")");
         return {};
     }
 
-    std::error_code ec;
-    dispatchBarrier.post(ec);
-    ASSERT(!ec);
+    return { data.get() };
+}
+
+bool sfz::FilePool::requestStreamRefill(const std::shared_ptr<FileStream>& stream, const std::shared_ptr<FileId>& fileId) noexcept
+{
+    LoadRequest request;
+    request.id = fileId;
+    request.stream = stream;
+    request.generation = stream->getGeneration();
+    request.queuedTime = std::chrono::high_resolution_clock::now();
+    request.deadline = request.queuedTime;
+
+    // a refill is requested when the playhead enters a new chunk, which
+    // leaves the rest of the ring to play before the underrun
+    const auto preloaded = preloadedFiles.find(*fileId);
+    if (preloaded != preloadedFiles.end() && preloaded->second.data->information.sampleRate > 0) {
+        const double seconds = (FileStream::ringFrames() - config::chunkSize)
+            / preloaded->second.data->information.sampleRate;
+        request.deadline += std::chrono::duration_cast<LoadRequest::TimePoint::duration>(
+            std::chrono::duration<double>(seconds));
+    }
+
+    if (!queueRequest(request)) {
+        DBG("[sfizz] Could not enqueue the stream to refill for " << *fileId);
+        stream->clearRefillRequest();
+        return false;
+    }
+
+    return true;
+}
+
+bool sfz::FilePool::queueRequest(LoadRequest request) noexcept
+{
+    request.pool = this;
+
+    // counted first, so that a loader never finishes a request before it
+    pendingRequests.fetch_add(1);
+    if (!loaderPool->queueRequest(request)) {
+        pendingRequests.fetch_sub(1);
+        return false;
+    }
+
+    return true;
+}
+
+void sfz::FilePool::finishRequest() noexcept
+{
+    std::lock_guard<std::mutex> lock { pendingRequestsMutex };
+    if (pendingRequests.fetch_sub(1) == 1)
+        pendingRequestsDone.notify_all();
+}
+
+void sfz::FilePool::setMemoryMapping(bool mapping) noexcept
+{
+    if (mapping == memoryMapping)
+        return;
 
-    return { &preloaded->second };
+    memoryMapping = mapping;
+    reacquireFiles();
+}
+
+void sfz::FilePool::setCacheDirectory(const fs::path& directory) noexcept
+{
+    sampleCache->setDirectory(directory);
+}
+
+const fs::path& sfz::FilePool::getCacheDirectory() const noexcept
+{
+    return sampleCache->getDirectory();
 }
 
 void sfz::FilePool::setPreloadSize(uint32_t preloadSize) noexcept
@@ -386,26 +819,25 @@ void sfz::FilePool::setPreloadSize(uint32_t preloadSize) noexcept
         return;
 
     // Update all the preloaded sizes
-    for (auto& preloadedFile : preloadedFiles) {
-        const auto maxOffset = preloadedFile.second.information.maxOffset;
-        fs::path file { rootDirectory / preloadedFile.first.filename() };
-        AudioReaderPtr reader = createAudioReader(file, preloadedFile.first.isReverse());
-        preloadedFile.second.preloadedData = readFromFile(*reader, preloadSize + maxOffset);
-    }
+    reacquireFiles();
 }
 
-void sfz::FilePool::loadingJob(const QueuedFileData& data) noexcept
+void sfz::FilePool::loadingJob(const LoadRequest& request) noexcept
 {
-    raiseCurrentThreadPriority();
-
-    std::shared_ptr<FileId> id = data.id.lock();
+    std::shared_ptr<FileId> id = request.id.lock();
     if (!id) {
         // file ID was nulled, it means the region was deleted, ignore
         return;
     }
 
+    std::shared_ptr<FileData> data = request.data.lock();
+    if (!data) {
+        // the preloaded files were cleared or replaced, ignore
+        return;
+    }
+
     const auto loadStartTime = std::chrono::high_resolution_clock::now();
-    const auto waitDuration = loadStartTime - data.queuedTime;
+    const auto waitDuration = loadStartTime - request.queuedTime;
     const fs::path file { rootDirectory / id->filename() };
     std::error_code readError;
     AudioReaderPtr reader = createAudioReader(file, id->isReverse(), &readError);
@@ -415,39 +847,64 @@ void sfz::FilePool::loadingJob(const QueuedFileData& data) noexcept
         return;
     }
 
-    FileData::Status currentStatus = data.data->status.load();
+    FileData::Status currentStatus = data->status.load();
 
-    unsigned spinCounter { 0 };
-    while (currentStatus == FileData::Status::Invalid) {
-        // Spin until the state changes
-        if (spinCounter > 1024) {
-            DBG("[sfizz] " << *id << " is stuck on Invalid? Leaving the load");
-            return;
-        }
+    // The entries are published after their preloading, so this is an error
+    if (currentStatus == FileData::Status::Invalid) {
+        DBG("[sfizz] " << *id << " is not preloaded, leaving the load");
+        return;
+    }
 
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
-        currentStatus = data.data->status.load();
-        spinCounter += 1;
+    // A garbage collector is releasing the loaded frames, which is short
+    while (currentStatus == FileData::Status::Collecting) {
+        std::this_thread::yield();
+        currentStatus = data->status.load();
     }
 
+    // The data may be loaded by another file pool which shares it, so the
+    // file is collected by this one as well
+    const auto markUsed = [this, &id]() {
+        std::lock_guard<SpinMutex> guard { garbageAndLastUsedMutex };
+        if (absl::c_find(lastUsedFiles, *id) == lastUsedFiles.end())
+            lastUsedFiles.push_back(*id);
+    };
+
     // Already loading or loaded
-    if (currentStatus != FileData::Status::Preloaded)
+    if (currentStatus != FileData::Status::Preloaded) {
+        markUsed();
         return;
+    }
 
     // Someone else got the token
-    if (!data.data->status.compare_exchange_strong(currentStatus, FileData::Status::Streaming))
+    if (!data->status.compare_exchange_strong(currentStatus, FileData::Status::Streaming)) {
+        markUsed();
         return;
+    }
 
     const auto frames = static_cast<uint32_t>(reader->frames());
-    streamFromFile(*reader, data.data->fileData, &data.data->availableFrames);
+    streamFromFile(*reader, data->fileData, &data->availableFrames);
     const auto loadDuration = std::chrono::high_resolution_clock::now() - loadStartTime;
     logger.logFileTime(waitDuration, loadDuration, frames, id->filename());
 
-    data.data->status = FileData::Status::Done;
+    data->status = FileData::Status::Done;
+    markUsed();
+}
 
-    std::lock_guard<SpinMutex> guard { garbageAndLastUsedMutex };
-    if (absl::c_find(lastUsedFiles, *id) == lastUsedFiles.end())
-        lastUsedFiles.push_back(*id);
+void sfz::FilePool::streamingJob(const LoadRequest& request) noexcept
+{
+    std::shared_ptr<FileStream> stream = request.stream.lock();
+    std::shared_ptr<FileId> id = request.id.lock();
+    if (!stream || !id) {
+        // the voice or the region was deleted, ignore
+        return;
+    }
+
+    // take the request before reading the playhead, so that the voice
+    // may request again while this refill is running
+    stream->clearRefillRequest();
+
+    const fs::path file { rootDirectory / id->filename() };
+    stream->refill(file, *id, request.generation);
 }
 
 void sfz::FilePool::clear()
@@ -457,6 +914,8 @@ void sfz::FilePool::clear()
     garbageToCollect.clear();
     lastUsedFiles.clear();
     preloadedFiles.clear();
+    probedFiles.clear();
+    retiredFiles.clear();
 }
 
 uint32_t sfz::FilePool::getPreloadSize() const noexcept
@@ -464,34 +923,6 @@ uint32_t sfz::FilePool::getPreloadSize() const noexcept
     return preloadSize;
 }
 
-template <typename R>
-bool is_ready(std::future<R> const& f)
-{
-    return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-}
-
-void sfz::FilePool::dispatchingJob() noexcept
-{
-    while (dispatchBarrier.wait(), dispatchFlag) {
-        std::lock_guard<std::mutex> guard { loadingJobsMutex };
-
-        QueuedFileData queuedData;
-        if (filesToLoad->try_pop(queuedData)) {
-            if (queuedData.id.expired()) {
-                // file ID was nulled, it means the region was deleted, ignore
-            }
-            else
-                loadingJobs.push_back(
-                    threadPool->enqueue([this](const QueuedFileData& data) { loadingJob(data); }, std::move(queuedData)));
-        }
-
-        // Clear finished jobs
-        swapAndPopAll(loadingJobs, [](std::future<void>& future) {
-            return is_ready(future);
-        });
-    }
-}
-
 void sfz::FilePool::garbageJob() noexcept
 {
     while (semGarbageBarrier.wait(), garbageFlag) {
@@ -502,12 +933,8 @@ void sfz::FilePool::garbageJob() noexcept
 
 void sfz::FilePool::waitForBackgroundLoading() noexcept
 {
-    std::lock_guard<std::mutex> guard { loadingJobsMutex };
-
-    for (auto& job : loadingJobs)
-        job.wait();
-
-    loadingJobs.clear();
+    std::unique_lock<std::mutex> lock { pendingRequestsMutex };
+    pendingRequestsDone.wait(lock, [this]() { return pendingRequests.load() == 0; });
 }
 
 void sfz::FilePool::raiseCurrentThreadPriority() noexcept
@@ -547,19 +974,7 @@ void sfz::FilePool::setRamLoading(bool loadInRam) noexcept
         return;
 
     this->loadInRam = loadInRam;
-
-    if (loadInRam) {
-        for (auto& preloadedFile : preloadedFiles) {
-            fs::path file { rootDirectory / preloadedFile.first.filename() };
-            AudioReaderPtr reader = createAudioReader(file, preloadedFile.first.isReverse());
-            preloadedFile.second.preloadedData = readFromFile(
-                *reader,
-                preloadedFile.second.information.end
-            );
-        }
-    } else {
-        setPreloadSize(preloadSize);
-    }
+    reacquireFiles();
 }
 
 void sfz::FilePool::triggerGarbageCollection() noexcept
@@ -580,7 +995,7 @@ void sfz::FilePool::triggerGarbageCollection() noexcept
             return true;
         }
 
-        sfz::FileData& data = it->second;
+        sfz::FileData& data = *it->second.data;
         if (data.status == FileData::Status::Preloaded)
             return true;
 
@@ -594,9 +1009,24 @@ void sfz::FilePool::triggerGarbageCollection() noexcept
         if (secondsIdle < config::fileClearingPeriod)
             return false;
 
-        data.availableFrames = 0;
-        data.status = FileData::Status::Preloaded;
+        // claim the data against the collectors of the other file pools
+        // sharing it, then hide the loaded frames from the voices acquiring
+        // it from now on; those only read the preloaded frames
+        FileData::Status status = FileData::Status::Done;
+        if (!data.status.compare_exchange_strong(status, FileData::Status::Collecting))
+            return false;
+
+        const size_t loadedFrames = data.availableFrames.exchange(0);
+        if (data.readerCount != 0) {
+            // a voice acquired the data in the meantime
+            data.availableFrames = loadedFrames;
+            data.status = FileData::Status::Done;
+            return false;
+        }
+
+        // the loaders wait for the data to be moved out before loading again
         garbageToCollect.push_back(std::move(data.fileData));
+        data.status.store(FileData::Status::Preloaded, std::memory_order_release);
         return true;
     });
 
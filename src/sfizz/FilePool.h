@@ -41,13 +41,24 @@
 #include <absl/types/optional.h>
 #include <absl/strings/string_view.h>
 #include <atomic_queue/atomic_queue.h>
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <thread>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 class ThreadPool;
 
 namespace sfz {
+class FileStream;
+class MappedFile;
+class MappedSample;
+class SampleCache;
+class SampleStore;
+
 using FileAudioBuffer = AudioBuffer<float, 2, config::defaultAlignment,
                                     sfz::config::excessFileFrames, sfz::config::excessFileFrames>;
 using FileAudioBufferPtr = std::shared_ptr<FileAudioBuffer>;
@@ -67,20 +78,34 @@ struct FileInformation {
 // Strict C++11 disallows member initialization if aggregate initialization is to be used...
 struct FileData
 {
-    enum class Status { Invalid, Preloaded, Streaming, Done };
+    enum class Status { Invalid, Preloaded, Streaming, Done, Collecting };
     FileData() = default;
     FileData(FileAudioBuffer preloaded, FileInformation info)
     : preloadedData(std::move(preloaded)), information(std::move(info))
+    {
+        preloadedView = AudioSpan<const float>(preloadedData);
+    }
+    FileData(std::shared_ptr<const MappedFile> mapping, AudioSpan<const float> preloaded, FileInformation info)
+    : information(std::move(info)), preloadedMapping(std::move(mapping)), preloadedView(preloaded)
     {
 
     }
     AudioSpan<const float> getData()
     {
-        if (availableFrames > preloadedData.getNumFrames())
-            return AudioSpan<const float>(fileData).first(availableFrames);
+        // a garbage collector may zero the count at any time
+        const size_t frames = availableFrames;
+        if (frames > preloadedView.getNumFrames())
+            return AudioSpan<const float>(fileData).first(frames);
         else
-            return AudioSpan<const float>(preloadedData);
+            return preloadedView;
     }
+    /**
+     * @brief Get the preloaded frames, decoded in memory or read from a
+     * mapping of the sample cache. Either way, they are padded by
+     * `config::excessFileFrames` readable frames on both sides.
+     */
+    AudioSpan<const float> getPreloadedData() const noexcept { return preloadedView; }
+    size_t getNumPreloadedFrames() const noexcept { return preloadedView.getNumFrames(); }
 
     FileData(const FileData& other) = delete;
     FileData& operator=(const FileData& other) = delete;
@@ -90,6 +115,10 @@ struct FileData
         information = std::move(other.information);
         preloadedData = std::move(other.preloadedData);
         fileData = std::move(other.fileData);
+        mappedData = std::move(other.mappedData);
+        // the buffers keep their heap storage when moved
+        preloadedMapping = std::move(other.preloadedMapping);
+        preloadedView = other.preloadedView;
         availableFrames = other.availableFrames.load();
         lastViewerLeftAt = other.lastViewerLeftAt;
         status = other.status.load();
@@ -100,6 +129,10 @@ struct FileData
         information = std::move(other.information);
         preloadedData = std::move(other.preloadedData);
         fileData = std::move(other.fileData);
+        mappedData = std::move(other.mappedData);
+        // the buffers keep their heap storage when moved
+        preloadedMapping = std::move(other.preloadedMapping);
+        preloadedView = other.preloadedView;
         availableFrames = other.availableFrames.load();
         lastViewerLeftAt = other.lastViewerLeftAt;
         status = other.status.load();
@@ -109,6 +142,9 @@ struct FileData
     FileAudioBuffer preloadedData;
     FileInformation information;
     FileAudioBuffer fileData {};
+    std::shared_ptr<MappedSample> mappedData;
+    std::shared_ptr<const MappedFile> preloadedMapping;
+    AudioSpan<const float> preloadedView;
     std::atomic<Status> status { Status::Invalid };
     std::atomic<size_t> availableFrames { 0 };
     std::atomic<int> readerCount { 0 };
@@ -139,6 +175,8 @@ public:
         if (!data)
             return;
 
+        // the garbage collectors check the count after hiding the loaded
+        // frames, so the preloaded frames are always readable from here
         data->readerCount += 1;
     }
     void reset()
@@ -210,6 +248,9 @@ public:
     /**
      * @brief Get metadata information about a file.
      *
+     * The first request for a file which is not preloaded only reads its
+     * header; the frames are decoded by the next preloading pass.
+     *
      * @param fileId
      * @return absl::optional<FileInformation>
      */
@@ -226,6 +267,48 @@ public:
      */
     bool preloadFile(const FileId& fileId, uint32_t maxOffset) noexcept;
 
+    /**
+     * @brief Preload a set of files with their offset bounds. The files are
+     * read concurrently by the background threads and the calling thread,
+     * with at most `getMaxPreloadingJobs()` of them at once.
+     *
+     * @param files the file identifiers and their maximum offsets
+     */
+    void preloadFiles(const std::vector<std::pair<FileId, uint32_t>>& files) noexcept;
+
+    /**
+     * @brief Set the maximum number of files which are read at once when
+     * preloading, including the calling thread.
+     *
+     * @param numJobs
+     */
+    void setMaxPreloadingJobs(unsigned numJobs) noexcept { maxPreloadingJobs = std::max(1u, numJobs); }
+    /**
+     * @brief Get the maximum number of files which are read at once when
+     * preloading.
+     */
+    unsigned getMaxPreloadingJobs() const noexcept { return maxPreloadingJobs; }
+
+    /**
+     * @brief Get the sample store, which this file pool shares with the
+     * other file pools of the process.
+     */
+    SampleStore& getSampleStore() noexcept { return *sampleStore; }
+
+    /**
+     * @brief Set the directory where the information and the preloaded
+     * frames of the sample files are cached across sessions. The cached
+     * entries are used as long as the sample files are not modified.
+     * An empty path disables the cache, which is the default.
+     *
+     * @param directory
+     */
+    void setCacheDirectory(const fs::path& directory) noexcept;
+    /**
+     * @brief Get the directory of the sample cache, empty if it is disabled.
+     */
+    const fs::path& getCacheDirectory() const noexcept;
+
     /**
      * @brief Load a file and return its information. The file pool will store this
      * data for future requests so use this function responsibly.
@@ -234,6 +317,12 @@ public:
      * @return A handle on the file data
      */
     FileDataHolder loadFile(const FileId& fileId) noexcept;
+    /**
+     * @brief Load a set of files whole, concurrently like `preloadFiles`.
+     *
+     * @param fileIds
+     */
+    void loadFiles(const std::vector<FileId>& fileIds) noexcept;
 
     /**
      * @brief Check that the sample exists. If not, try to find it in a case insensitive way.
@@ -259,12 +348,15 @@ public:
      */
     void clear();
     /**
-     * @brief Get a handle on a file, which triggers background loading
+     * @brief Get a handle on a file, which triggers background loading.
+     * The loads are scheduled by the time at which the voices run out of
+     * preloaded frames, assuming they play at the original speed.
      *
      * @param fileId the file to preload
+     * @param startFrame the frame where the voice starts playing
      * @return FileDataHolder a file data handle
      */
-    FileDataHolder getFilePromise(const std::shared_ptr<FileId>& fileId) noexcept;
+    FileDataHolder getFilePromise(const std::shared_ptr<FileId>& fileId, uint64_t startFrame = 0) noexcept;
     /**
      * @brief Change the preloading size. This will trigger a full
      * reload of all samples, so don't call it on the audio thread.
@@ -291,7 +383,7 @@ public:
     }
     /**
      * @brief Wait for the background loading to finish for all promises
-     * in the queue.
+     * in the queue. This does not block the loaders.
      */
     void waitForBackgroundLoading() noexcept;
     /**
@@ -306,6 +398,39 @@ public:
      * @param loadInRam
      */
     void setRamLoading(bool loadInRam) noexcept;
+    /**
+     * @brief Change whether the samples are streamed from disk by the voices,
+     * in bounded ring buffers, instead of being loaded whole in memory when
+     * played. This has no effect on the samples which are loaded in ram.
+     *
+     * @param streaming
+     */
+    void setStreaming(bool streaming) noexcept { this->streaming = streaming; }
+    /**
+     * @brief Check whether the samples are streamed from disk.
+     */
+    bool isStreaming() const noexcept { return streaming; }
+    /**
+     * @brief Change whether the uncompressed WAV samples are memory-mapped and
+     * read in place by the voices, instead of being loaded whole in memory when
+     * played. This has no effect on the samples which are loaded in ram.
+     *
+     * @param mapping
+     */
+    void setMemoryMapping(bool mapping) noexcept;
+    /**
+     * @brief Check whether the uncompressed WAV samples are memory-mapped.
+     */
+    bool isMemoryMapping() const noexcept { return memoryMapping; }
+    /**
+     * @brief Ask the background loaders to refill the ring of a stream.
+     * This is called from the audio thread.
+     *
+     * @param stream the stream, whose refill must have been marked pending
+     * @param fileId the file which is streamed
+     * @return true if the request was queued
+     */
+    bool requestStreamRefill(const std::shared_ptr<FileStream>& stream, const std::shared_ptr<FileId>& fileId) noexcept;
     /**
      * @brief Prepares unused data to be freed on a background thread.
      * This should be called regularly by the Synth, otherwise memory
@@ -317,35 +442,64 @@ private:
     fs::path rootDirectory;
 
     bool loadInRam { config::loadInRam };
+    bool streaming { config::diskStreaming };
+    bool memoryMapping { config::sampleMemoryMapping };
     uint32_t preloadSize { config::preloadSize };
+    unsigned maxPreloadingJobs { std::max(1u, std::thread::hardware_concurrency()) };
+    std::unique_ptr<SampleCache> sampleCache;
+    std::shared_ptr<SampleStore> sampleStore;
 
     // Signals
-    volatile bool dispatchFlag { true };
     volatile bool garbageFlag { true };
-    RTSemaphore dispatchBarrier;
     RTSemaphore semGarbageBarrier;
 
-    // Structures for the background loaders
-    struct QueuedFileData
+    // Requests to the background loaders, which are either the load of a
+    // file or the refill of a stream
+    struct LoadRequest
     {
         using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
-        QueuedFileData() noexcept {}
-        QueuedFileData(std::weak_ptr<FileId> id, FileData* data, TimePoint queuedTime) noexcept
-        : id(id), data(data), queuedTime(queuedTime) {}
+        LoadRequest() noexcept {}
+        FilePool* pool { nullptr };
         std::weak_ptr<FileId> id;
-        FileData* data { nullptr };
+        std::weak_ptr<FileData> data;
+        std::weak_ptr<FileStream> stream;
+        uint32_t generation { 0 };
         TimePoint queuedTime {};
+        TimePoint deadline {};
+        /**
+         * @brief Whether the request is less urgent than another: the one
+         * whose voice runs out of data first goes first, then the one whose
+         * voice started first.
+         */
+        bool isLessUrgentThan(const LoadRequest& other) const noexcept
+        {
+            if (deadline != other.deadline)
+                return deadline > other.deadline;
+            return queuedTime > other.queuedTime;
+        }
     };
 
-    using FileQueue = atomic_queue::AtomicQueue2<QueuedFileData, config::maxVoices>;
-    aligned_unique_ptr<FileQueue> filesToLoad;
-
-    void dispatchingJob() noexcept;
+    // The loader threads, shared by the file pools of the process
+    class LoaderPool;
+    std::shared_ptr<LoaderPool> loaderPool;
+    // Requests queued and not yet done, which the loaders count down under
+    // the mutex, so that a waiter may destroy the file pool once notified
+    std::atomic<int> pendingRequests { 0 };
+    std::mutex pendingRequestsMutex;
+    std::condition_variable pendingRequestsDone;
+
+    uint32_t getFramesToLoad(const FileInformation& information, uint32_t maxOffset, bool wholeFile) const noexcept;
+    bool shouldMap() const noexcept { return memoryMapping && !loadInRam; }
+    struct PreloadJob;
+    void readPreloadJob(PreloadJob& job) const noexcept;
+    void acquireFiles(const std::vector<std::pair<FileId, uint32_t>>& files, bool wholeFiles) noexcept;
+    void reacquireFiles() noexcept;
+    std::shared_ptr<MappedSample> mapFile(const FileId& fileId, const FileInformation& information) const noexcept;
+    bool queueRequest(LoadRequest request) noexcept;
+    void finishRequest() noexcept;
     void garbageJob() noexcept;
-    void loadingJob(const QueuedFileData& data) noexcept;
-    std::mutex loadingJobsMutex;
-    std::vector<std::future<void>> loadingJobs;
-    std::thread dispatchThread { &FilePool::dispatchingJob, this };
+    void loadingJob(const LoadRequest& request) noexcept;
+    void streamingJob(const LoadRequest& request) noexcept;
     std::thread garbageThread { &FilePool::garbageJob, this };
 
     SpinMutex garbageAndLastUsedMutex;
@@ -354,9 +508,16 @@ private:
 
     std::shared_ptr<ThreadPool> threadPool;
 
-    // Preloaded data
-    absl::flat_hash_map<FileId, FileData> preloadedFiles;
-    absl::flat_hash_map<FileId, FileData> loadedFiles;
+    // Preloaded data, shared with the other file pools through the store
+    struct PreloadedFile {
+        std::shared_ptr<FileData> data;
+        uint32_t maxOffset { 0 };
+        bool mapped { false };
+    };
+    absl::flat_hash_map<FileId, PreloadedFile> preloadedFiles;
+    // Information read ahead of preloading, for the files not preloaded yet
+    absl::flat_hash_map<FileId, FileInformation> probedFiles;
+    std::vector<std::shared_ptr<FileData>> retiredFiles;
     LEAK_DETECTOR(FilePool);
 };
 }
@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "FileStream.h"
+#include "utility/Debug.h"
+#include <algorithm>
+
+namespace sfz {
+
+static constexpr uint64_t invalidTag = ~uint64_t(0);
+
+FileStream::FileStream()
+{
+    ring_.addChannels(2);
+    ring_.resize(static_cast<size_t>(ringFrames()));
+    ring_.clear();
+
+    for (auto& tag : slotTags_)
+        tag.store(invalidTag);
+}
+
+void FileStream::attach(const FileData& data) noexcept
+{
+    attached_ = true;
+    lastRequestedChunk_ = -1;
+    underrun_ = false;
+
+    generation_.fetch_add(1);
+    fileFrames_.store(data.information.end + 1);
+    preloadedFrames_.store(static_cast<int64_t>(data.getNumPreloadedFrames()));
+    setPlayhead(0, 0, -1);
+}
+
+void FileStream::setPlayhead(int64_t position, int64_t loopStart, int64_t loopEnd) noexcept
+{
+    loopStart_.store(loopStart, std::memory_order_relaxed);
+    loopEnd_.store(loopEnd, std::memory_order_relaxed);
+    position_.store(position, std::memory_order_release);
+}
+
+bool FileStream::shouldRequestRefill() noexcept
+{
+    const int64_t chunk = position_.load(std::memory_order_relaxed) / config::chunkSize;
+    if (chunk == lastRequestedChunk_ && !underrun_)
+        return false;
+
+    if (refillPending_.exchange(true))
+        return false;
+
+    lastRequestedChunk_ = chunk;
+    underrun_ = false;
+    return true;
+}
+
+int FileStream::findSlot(uint64_t tag) const noexcept
+{
+    for (int s = 0; s < config::streamingChunks; ++s) {
+        if (slotTags_[s].load(std::memory_order_acquire) == tag)
+            return s;
+    }
+    return -1;
+}
+
+bool FileStream::read(const FileData& data, int64_t first, AudioSpan<float> output) noexcept
+{
+    const size_t numFrames = output.getNumFrames();
+    const size_t numChannels = output.getNumChannels();
+    const int64_t fileFrames = fileFrames_.load(std::memory_order_relaxed);
+    const uint32_t generation = generation_.load(std::memory_order_relaxed);
+    const AudioSpan<const float> preloaded = data.getPreloadedData();
+    const int64_t preloadedFrames = static_cast<int64_t>(preloaded.getNumFrames());
+    const size_t sourceChannels = std::min(numChannels, preloaded.getNumChannels());
+    bool complete = true;
+
+    size_t i = 0;
+    while (i < numFrames) {
+        const int64_t frame = first + static_cast<int64_t>(i);
+
+        // out of the file
+        if (frame < 0 || frame >= fileFrames) {
+            const size_t count = (frame < 0) ?
+                static_cast<size_t>(std::min<int64_t>(-frame, numFrames - i)) : numFrames - i;
+            for (size_t c = 0; c < numChannels; ++c)
+                fill<float>(output.getSpan(c).subspan(i, count), 0.0f);
+            i += count;
+            continue;
+        }
+
+        // preloaded
+        if (frame < preloadedFrames) {
+            const size_t count = static_cast<size_t>(
+                std::min<int64_t>(preloadedFrames - frame, numFrames - i));
+            for (size_t c = 0; c < numChannels; ++c) {
+                const size_t sc = std::min(c, sourceChannels - 1);
+                copy<float>(preloaded.getConstSpan(sc).subspan(static_cast<size_t>(frame), count),
+                    output.getSpan(c).subspan(i, count));
+            }
+            i += count;
+            continue;
+        }
+
+        // streamed, read under the slot tag which must be unchanged after the copy
+        const int64_t chunk = frame / config::chunkSize;
+        const int64_t offset = frame - chunk * config::chunkSize;
+        const size_t count = static_cast<size_t>(std::min<int64_t>(
+            std::min<int64_t>(config::chunkSize - offset, fileFrames - frame), numFrames - i));
+        const uint64_t tag = makeTag(generation, chunk);
+        const int slot = findSlot(tag);
+
+        bool valid = false;
+        if (slot >= 0) {
+            const size_t ringOffset = static_cast<size_t>(slot * config::chunkSize + offset);
+            for (size_t c = 0; c < numChannels; ++c)
+                copy<float>(ring_.getConstSpan(c).subspan(ringOffset, count),
+                    output.getSpan(c).subspan(i, count));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            valid = slotTags_[slot].load(std::memory_order_relaxed) == tag;
+        }
+
+        if (!valid) {
+            for (size_t c = 0; c < numChannels; ++c)
+                fill<float>(output.getSpan(c).subspan(i, count), 0.0f);
+            complete = false;
+        }
+
+        i += count;
+    }
+
+    if (!complete)
+        underrun_ = true;
+
+    return complete;
+}
+
+size_t FileStream::collectChunksAhead(std::array<int64_t, config::streamingChunks>& chunks) const noexcept
+{
+    const int64_t fileFrames = fileFrames_.load(std::memory_order_relaxed);
+    const int64_t preloadedFrames = preloadedFrames_.load(std::memory_order_relaxed);
+    const int64_t position = position_.load(std::memory_order_acquire);
+    const int64_t loopStart = loopStart_.load(std::memory_order_relaxed);
+    const int64_t loopEnd = std::min(loopEnd_.load(std::memory_order_relaxed), fileFrames - 1);
+    const bool looping = loopEnd >= 0 && loopStart <= loopEnd;
+
+    // keep the frames just before the playhead, which the interpolation reads
+    int64_t frame = std::max<int64_t>(0, position - config::excessFileFrames);
+    size_t numChunks = 0;
+
+    // walk the chunks in playing order, wrapping around the loop
+    while (numChunks < chunks.size()) {
+        if (looping && frame > loopEnd + config::excessFileFrames)
+            frame = std::max<int64_t>(0, loopStart - config::excessFileFrames);
+        if (frame >= fileFrames)
+            break;
+
+        const int64_t chunk = frame / config::chunkSize;
+        const int64_t chunkEnd = (chunk + 1) * config::chunkSize;
+
+        if (chunkEnd > preloadedFrames) {
+            if (std::find(chunks.begin(), chunks.begin() + numChunks, chunk) != chunks.begin() + numChunks)
+                break; // went around the loop
+            chunks[numChunks++] = chunk;
+        } else if (looping && loopEnd < preloadedFrames) {
+            break; // the loop plays from the preloaded data
+        }
+
+        frame = chunkEnd;
+    }
+
+    return numChunks;
+}
+
+void FileStream::refill(const fs::path& file, const FileId& id, uint32_t generation) noexcept
+{
+    std::lock_guard<std::mutex> lock { loaderMutex_ };
+
+    if (generation != generation_.load())
+        return;
+
+    std::array<int64_t, config::streamingChunks> chunks;
+    const size_t numChunks = collectChunksAhead(chunks);
+    if (numChunks == 0)
+        return;
+
+    const auto isWanted = [&](uint64_t tag) {
+        if (tag == invalidTag || uint32_t(tag >> 32) != generation)
+            return false;
+        const int64_t chunk = int64_t(uint32_t(tag));
+        return std::find(chunks.begin(), chunks.begin() + numChunks, chunk) != chunks.begin() + numChunks;
+    };
+
+    for (size_t k = 0; k < numChunks; ++k) {
+        const uint64_t tag = makeTag(generation, chunks[k]);
+        if (findSlot(tag) >= 0)
+            continue;
+
+        // a newer attachment has started, this request is stale
+        if (generation != generation_.load())
+            return;
+
+        int slot = -1;
+        for (int s = 0; s < config::streamingChunks && slot < 0; ++s) {
+            if (!isWanted(slotTags_[s].load(std::memory_order_relaxed)))
+                slot = s;
+        }
+        if (slot < 0)
+            return;
+
+        if (!reader_ || !(readerId_ == id)) {
+            std::error_code ec;
+            reader_ = createAudioReader(file, id.isReverse(), &ec);
+            if (ec) {
+                DBG("[sfizz] Could not open " << id << " for streaming: " << ec.message());
+                reader_.reset();
+                return;
+            }
+            readerId_ = id;
+            readBuffer_.reset(new float[config::chunkSize * reader_->channels()]);
+        }
+
+        const int64_t first = chunks[k] * config::chunkSize;
+        if (!reader_->seek(static_cast<uint64_t>(first))) {
+            DBG("[sfizz] Could not seek to frame " << first << " in " << id);
+            return;
+        }
+
+        const unsigned channels = reader_->channels();
+        const size_t numFrames = reader_->readNextBlock(readBuffer_.get(), config::chunkSize);
+
+        slotTags_[slot].store(invalidTag, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const size_t ringOffset = static_cast<size_t>(slot * config::chunkSize);
+        auto left = ring_.getSpan(0).subspan(ringOffset, config::chunkSize);
+        auto right = ring_.getSpan(1).subspan(ringOffset, config::chunkSize);
+        const float* frames = readBuffer_.get();
+        for (size_t i = 0; i < numFrames; ++i) {
+            left[i] = frames[i * channels];
+            right[i] = frames[i * channels + channels - 1];
+        }
+        fill<float>(left.subspan(numFrames), 0.0f);
+        fill<float>(right.subspan(numFrames), 0.0f);
+
+        slotTags_[slot].store(tag, std::memory_order_release);
+    }
+}
+
+} // namespace sfz
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "Config.h"
+#include "FilePool.h"
+#include "AudioReader.h"
+#include "utility/LeakDetector.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace sfz {
+
+/**
+ * @brief The window of a voice on a sample file, when streaming from disk.
+ *
+ * Past the preloaded frames, the sample data lives in a fixed ring of
+ * `config::streamingChunks` chunks which the background loaders refill ahead
+ * of the playhead of the voice, following the loop if the voice is looping.
+ * The memory used is thus bounded by the ring size, whatever the length of
+ * the sample.
+ *
+ * The voice side (`attach`, `setPlayhead`, `read`...) is real-time safe and
+ * must only be called from the audio thread. The loader side (`refill`) runs
+ * on the background threads.
+ *
+ * Each chunk slot is tagged with the chunk it holds and with the generation of
+ * the attachment, so that a slot which a loader overwrites or which belongs to
+ * a previous file is never read as valid.
+ */
+class FileStream {
+public:
+    FileStream();
+
+    /**
+     * @brief Start streaming a file from its beginning.
+     *
+     * @param data the file data, which holds the preloaded frames
+     */
+    void attach(const FileData& data) noexcept;
+
+    /**
+     * @brief Stop streaming.
+     */
+    void detach() noexcept { attached_ = false; }
+
+    /**
+     * @brief Check whether the stream is attached to a file.
+     */
+    bool isAttached() const noexcept { return attached_; }
+
+    /**
+     * @brief Get the generation of the current attachment.
+     */
+    uint32_t getGeneration() const noexcept { return generation_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Publish the position which the voice reads from, and the loop it
+     * plays if any, so that the loaders know which chunks to prefetch.
+     *
+     * @param position the frame position
+     * @param loopStart the first frame read after a loop restart
+     * @param loopEnd the last frame of the loop, or a negative value if not looping
+     */
+    void setPlayhead(int64_t position, int64_t loopStart, int64_t loopEnd) noexcept;
+
+    /**
+     * @brief Check whether the loaders should be asked to refill the ring, and
+     * mark the request as pending if so.
+     */
+    bool shouldRequestRefill() noexcept;
+
+    /**
+     * @brief Mark a refill request as taken by a loader.
+     */
+    void clearRefillRequest() noexcept { refillPending_.store(false); }
+
+    /**
+     * @brief Copy frames of the file, from the preloaded data or from the ring.
+     * Frames which are out of the file or not yet streamed are zeroed.
+     *
+     * @param data the file data which the stream is attached to
+     * @param first the first frame to copy
+     * @param output the destination, determining the number of frames
+     * @return false if some frames were not streamed in time
+     */
+    bool read(const FileData& data, int64_t first, AudioSpan<float> output) noexcept;
+
+    /**
+     * @brief Load the chunks which are ahead of the playhead and missing from
+     * the ring. This is called by the background loaders.
+     *
+     * @param file the path of the sample file
+     * @param id the identifier of the sample file
+     * @param generation the generation which the request was made for
+     */
+    void refill(const fs::path& file, const FileId& id, uint32_t generation) noexcept;
+
+    /**
+     * @brief Number of frames held by the ring
+     */
+    static constexpr int64_t ringFrames() noexcept
+    {
+        return int64_t(config::streamingChunks) * config::chunkSize;
+    }
+
+private:
+    static uint64_t makeTag(uint32_t generation, int64_t chunk) noexcept
+    {
+        return (uint64_t(generation) << 32) | uint64_t(uint32_t(chunk));
+    }
+
+    int findSlot(uint64_t tag) const noexcept;
+    size_t collectChunksAhead(std::array<int64_t, config::streamingChunks>& chunks) const noexcept;
+
+    // Voice side
+    bool attached_ { false };
+    int64_t lastRequestedChunk_ { -1 };
+    bool underrun_ { false };
+
+    // Shared with the loaders
+    std::atomic<uint32_t> generation_ { 0 };
+    std::atomic<int64_t> position_ { 0 };
+    std::atomic<int64_t> loopStart_ { 0 };
+    std::atomic<int64_t> loopEnd_ { -1 };
+    std::atomic<int64_t> fileFrames_ { 0 };
+    std::atomic<int64_t> preloadedFrames_ { 0 };
+    std::atomic<bool> refillPending_ { false };
+    std::array<std::atomic<uint64_t>, config::streamingChunks> slotTags_;
+    FileAudioBuffer ring_;
+
+    // Loader side
+    std::mutex loaderMutex_;
+    AudioReaderPtr reader_;
+    FileId readerId_;
+    std::unique_ptr<float[]> readBuffer_;
+
+    LEAK_DETECTOR(FileStream);
+};
+
+} // namespace sfz
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "FilterSubmix.h"
+#include "SIMDHelpers.h"
+#include <absl/algorithm/container.h>
+
+namespace sfz {
+
+FilterSubmix::FilterSubmix(const Region& region)
+    : _filterDescriptions(region.filters)
+    , _eqDescriptions(region.equalizers)
+    , _effectSends(region.effectSends)
+{
+    for (const FilterDescription& description : _filterDescriptions) {
+        auto filter = absl::make_unique<Filter>();
+        filter->init(config::defaultSampleRate);
+        filter->setType(description.type);
+        filter->setChannels(2);
+        _filters.push_back(std::move(filter));
+    }
+
+    for (const EQDescription& description : _eqDescriptions) {
+        auto eq = absl::make_unique<FilterEq>();
+        eq->init(config::defaultSampleRate);
+        eq->setType(description.type);
+        eq->setChannels(2);
+        _equalizers.push_back(std::move(eq));
+    }
+
+    clear();
+}
+
+bool FilterSubmix::canShareFilterStage(const Region& region)
+{
+    if (region.filters.empty() && region.equalizers.empty())
+        return false;
+
+    // the parameters must not depend on the triggering note
+    for (const FilterDescription& description : region.filters) {
+        if (description.keytrack != 0 || description.veltrack != 0 || description.random != 0)
+            return false;
+        for (const auto& mod : description.veltrackCC) {
+            if (mod.data.modifier != 0)
+                return false;
+        }
+    }
+
+    for (const EQDescription& description : region.equalizers) {
+        if (description.vel2frequency != 0 || description.vel2gain != 0)
+            return false;
+    }
+
+    // the parameters must not be modulated, and for mono regions, the pan
+    // stage which comes after the filters must be a constant gain
+    for (const Region::Connection& connection : region.connections) {
+        switch (connection.target.id()) {
+        case ModId::FilGain:
+        case ModId::FilCutoff:
+        case ModId::FilResonance:
+        case ModId::EqGain:
+        case ModId::EqFrequency:
+        case ModId::EqBandwidth:
+            return false;
+        case ModId::Pan:
+            if (!region.isStereo())
+                return false;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool FilterSubmix::matches(const Region& region) const
+{
+    auto sameFilter = [](const FilterDescription& lhs, const FilterDescription& rhs) {
+        return lhs.type == rhs.type && lhs.cutoff == rhs.cutoff
+            && lhs.resonance == rhs.resonance && lhs.gain == rhs.gain;
+    };
+
+    auto sameEq = [](const EQDescription& lhs, const EQDescription& rhs) {
+        return lhs.type == rhs.type && lhs.frequency == rhs.frequency
+            && lhs.bandwidth == rhs.bandwidth && lhs.gain == rhs.gain;
+    };
+
+    auto sameSend = [](const Region::EffectSend& lhs, const Region::EffectSend& rhs) {
+        return lhs.bus == rhs.bus && lhs.gain == rhs.gain;
+    };
+
+    return absl::c_equal(_filterDescriptions, region.filters, sameFilter)
+        && absl::c_equal(_eqDescriptions, region.equalizers, sameEq)
+        && absl::c_equal(_effectSends, region.effectSends, sameSend);
+}
+
+void FilterSubmix::setSampleRate(double sampleRate)
+{
+    for (auto& filter : _filters)
+        filter->init(sampleRate);
+
+    for (auto& eq : _equalizers)
+        eq->init(sampleRate);
+
+    clear();
+}
+
+void FilterSubmix::setSamplesPerBlock(int samplesPerBlock)
+{
+    _buffer.resize(samplesPerBlock);
+}
+
+void FilterSubmix::clear()
+{
+    // set the coefficients without smoothing, like the voices do at start
+    for (size_t i = 0, n = _filters.size(); i < n; ++i) {
+        const FilterDescription& description = _filterDescriptions[i];
+        const float cutoff = Default::filterCutoff.bounds.clamp(description.cutoff);
+        _filters[i]->prepare(cutoff, description.resonance, description.gain);
+    }
+
+    for (size_t i = 0, n = _equalizers.size(); i < n; ++i) {
+        const EQDescription& description = _eqDescriptions[i];
+        _equalizers[i]->prepare(description.frequency, description.bandwidth, description.gain);
+    }
+
+    _ringing = false;
+}
+
+void FilterSubmix::clearInputs(unsigned nframes)
+{
+    AudioSpan<float>(_buffer).first(nframes).fill(0.0f);
+    _hasInput = false;
+    _processed = false;
+}
+
+void FilterSubmix::addToInputs(AudioSpan<const float> voiceOutput, unsigned nframes)
+{
+    _hasInput = true;
+
+    for (unsigned c = 0; c < 2; ++c)
+        add<float>(voiceOutput.getConstSpan(c).first(nframes), _buffer.getSpan(c).first(nframes));
+}
+
+void FilterSubmix::process(unsigned nframes)
+{
+    // the output is left cleared
+    if (isSilent())
+        return;
+
+    _processed = true;
+
+    float* channels[2] { _buffer.channelWriter(0), _buffer.channelWriter(1) };
+
+    for (size_t i = 0, n = _filters.size(); i < n; ++i) {
+        const FilterDescription& description = _filterDescriptions[i];
+        const float cutoff = Default::filterCutoff.bounds.clamp(description.cutoff);
+        _filters[i]->process(channels, channels, cutoff, description.resonance, description.gain, nframes);
+    }
+
+    for (size_t i = 0, n = _equalizers.size(); i < n; ++i) {
+        const EQDescription& description = _eqDescriptions[i];
+        _equalizers[i]->process(channels, channels, description.frequency, description.bandwidth, description.gain, nframes);
+    }
+
+    if (_hasInput) {
+        _ringing = true;
+        return;
+    }
+
+    // without input, stop when the tail has faded out
+    const float threshold = config::filterSubmixSilenceThreshold;
+    if (allWithin(_buffer.getConstSpan(0).first(nframes), -threshold, threshold)
+        && allWithin(_buffer.getConstSpan(1).first(nframes), -threshold, threshold))
+        clear();
+}
+
+} // namespace sfz
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "Config.h"
+#include "AudioBuffer.h"
+#include "AudioSpan.h"
+#include "Region.h"
+#include "SfzFilter.h"
+#include "utility/LeakDetector.h"
+#include <vector>
+#include <memory>
+
+namespace sfz {
+
+/**
+ * @brief A stereo submix of the voices of some regions, which share the same
+ * static filters and equalizers.
+ *
+ * When the filters and equalizers of a region are not modulated and do not
+ * depend on the triggering note, they are linear and time-invariant stages of
+ * the voice. The voices can then skip them, and the submix applies them once
+ * to the sum of the voices, for an identical result up to rounding.
+ */
+class FilterSubmix {
+public:
+    /**
+     * @brief Create a submix with the filters, equalizers and effect sends of
+     * the region.
+     */
+    explicit FilterSubmix(const Region& region);
+
+    /**
+     * @brief Check whether the filter stage of the voices of a region can be
+     * applied on a submix instead.
+     *
+     * This requires the filters and the equalizers to be static, and for mono
+     * regions, the panning after the filters to be constant.
+     */
+    static bool canShareFilterStage(const Region& region);
+
+    /**
+     * @brief Check whether the region has the same filters, equalizers and
+     * effect sends as this submix.
+     */
+    bool matches(const Region& region) const;
+
+    /**
+     * @brief Get the effect sends of the regions of this submix.
+     */
+    const std::vector<Region::EffectSend>& effectSends() const { return _effectSends; }
+
+    /**
+     * @brief Initialize the filters with the given sample rate.
+     */
+    void setSampleRate(double sampleRate);
+
+    /**
+     * @brief Sets the maximum number of frames to render at a time.
+     */
+    void setSamplesPerBlock(int samplesPerBlock);
+
+    /**
+     * @brief Resets the state of the filters.
+     */
+    void clear();
+
+    /**
+     * @brief Resets the input buffer to zero.
+     */
+    void clearInputs(unsigned nframes);
+
+    /**
+     * @brief Adds the output of a voice into the input buffer.
+     */
+    void addToInputs(AudioSpan<const float> voiceOutput, unsigned nframes);
+
+    /**
+     * @brief Checks whether the submix is silent, having no input in this
+     * cycle and the tail of its filters being over.
+     */
+    bool isSilent() const { return !_hasInput && !_ringing; }
+
+    /**
+     * @brief Applies the filters and the equalizers in place, unless the
+     * submix is silent.
+     */
+    void process(unsigned nframes);
+
+    /**
+     * @brief Checks whether the submix was processed in this cycle.
+     */
+    bool isProcessed() const { return _processed; }
+
+    /**
+     * @brief Get the output, which is valid if the submix was processed.
+     */
+    AudioSpan<const float> getOutputs(unsigned nframes)
+    {
+        return AudioSpan<float>(_buffer).first(nframes);
+    }
+
+private:
+    std::vector<FilterDescription> _filterDescriptions;
+    std::vector<EQDescription> _eqDescriptions;
+    std::vector<Region::EffectSend> _effectSends;
+    std::vector<std::unique_ptr<Filter>> _filters;
+    std::vector<std::unique_ptr<FilterEq>> _equalizers;
+    AudioBuffer<float> _buffer { 2, config::defaultSamplesPerBlock };
+    // Whether some input was added in this cycle
+    bool _hasInput { false };
+    // Whether the buffer was processed in this cycle
+    bool _processed { false };
+    // Whether the filters still have some output from the past cycles
+    bool _ringing { false };
+    LEAK_DETECTOR(FilterSubmix);
+};
+
+} // namespace sfz
@@ -5,6 +5,7 @@
 // If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
 
 #include "Interpolators.h"
+#include "simd/InterpolatorsAVX2.h"
 
 namespace sfz {
 
@@ -20,4 +21,11 @@ void initializeInterpolators()
     SincInterpolatorTraits<72>::initialize();
 }
 
+bool interpolatorsUseAVX2()
+{
+    return hasSIMDInstructionSet(SIMDInstructionSet::AVX2)
+        && getSIMDInstructionSetStatus<float>(SIMDInstructionSet::AVX2)
+        && sincInterpolatorAVX2Built();
+}
+
 } // namespace sfz
@@ -49,6 +49,14 @@ enum InterpolatorModel : int {
  */
 void initializeInterpolators();
 
+/**
+ * @brief Whether the windowed-sinc block interpolation can use its AVX2 kernel
+ *
+ * This queries the SIMD dispatcher, so query it once per block and pass the
+ * result to `interpolateBlock`.
+ */
+bool interpolatorsUseAVX2();
+
 /**
  * @brief Interpolate from a vector of values
  *
@@ -65,6 +73,31 @@ void initializeInterpolators();
 template <InterpolatorModel M, class R>
 R interpolate(const R* values, R coeff, float mod);
 
+/**
+ * @brief Interpolate a block of frames from a mono or stereo source
+ *
+ * The interpolation weights of a frame are computed once for both channels,
+ * and the short models compute several frames at once.
+ *
+ * @tparam M the interpolator model
+ * @tparam Adding whether to add to the outputs, applying the adding gains
+ * @param leftSource the left (or mono) source channel
+ * @param rightSource the right source channel, or nullptr if the source is mono
+ * @param left the left output channel
+ * @param right the right output channel, unused if the source is mono
+ * @param indices the integer positions in the source
+ * @param coeffs the interpolation coefficients
+ * @param addingGains the gains to apply when adding to the outputs
+ * @param size the number of frames
+ * @param mod the interpolation modifier
+ * @param useAVX2 whether the windowed sincs use their AVX2 kernel, see `interpolatorsUseAVX2`
+ */
+template <InterpolatorModel M, bool Adding>
+void interpolateBlock(
+    const float* leftSource, const float* rightSource, float* left, float* right,
+    const int* indices, const float* coeffs, const float* addingGains,
+    unsigned size, float mod, bool useAVX2);
+
 } // namespace sfz
 
 #include "Interpolators.hpp"
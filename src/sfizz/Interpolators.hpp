@@ -8,6 +8,9 @@
 #include "WindowedSinc.h"
 #include "MathHelpers.h"
 #include "SIMDConfig.h"
+#include "SIMDHelpers.h"
+#include "simd/InterpolatorsAVX2.h"
+#include "utility/Macros.h"
 #include <simde/simde-features.h>
 #if SIMDE_NATURAL_VECTOR_SIZE_GE(128)
 #include <simde/x86/sse.h>
@@ -262,4 +265,291 @@ class Interpolator<kInterpolatorSinc60, R> : public SincInterpolator<R, 60> {};
 template <class R>
 class Interpolator<kInterpolatorSinc72, R> : public SincInterpolator<R, 72> {};
 
+//------------------------------------------------------------------------------
+// Block interpolation, generic
+
+namespace BlockInterpolatorDetail {
+    // Interpolate the frames one at a time
+    template <InterpolatorModel M, bool Adding>
+    inline void processFrames(
+        const float* leftSource, const float* rightSource, float* left, float* right,
+        const int* indices, const float* coeffs, const float* addingGains,
+        unsigned size, float mod)
+    {
+        if (!rightSource) {
+            for (unsigned i = 0; i < size; ++i) {
+                float output = interpolate<M>(&leftSource[indices[i]], coeffs[i], mod);
+                IF_CONSTEXPR(Adding)
+                    left[i] += addingGains[i] * output;
+                else
+                    left[i] = output;
+            }
+        } else {
+            for (unsigned i = 0; i < size; ++i) {
+                float leftOutput = interpolate<M>(&leftSource[indices[i]], coeffs[i], mod);
+                float rightOutput = interpolate<M>(&rightSource[indices[i]], coeffs[i], mod);
+                IF_CONSTEXPR(Adding) {
+                    left[i] += addingGains[i] * leftOutput;
+                    right[i] += addingGains[i] * rightOutput;
+                }
+                else {
+                    left[i] = leftOutput;
+                    right[i] = rightOutput;
+                }
+            }
+        }
+    }
+} // namespace BlockInterpolatorDetail
+
+template <InterpolatorModel M>
+class BlockInterpolator
+{
+public:
+    template <bool Adding>
+    static void process(
+        const float* leftSource, const float* rightSource, float* left, float* right,
+        const int* indices, const float* coeffs, const float* addingGains,
+        unsigned size, float mod, bool useAVX2)
+    {
+        UNUSED(useAVX2);
+        BlockInterpolatorDetail::processFrames<M, Adding>(
+            leftSource, rightSource, left, right, indices, coeffs, addingGains, size, mod);
+    }
+};
+
+#if SIMDE_NATURAL_VECTOR_SIZE_GE(128)
+namespace BlockInterpolatorDetail {
+    // Load the points 0 and 1 of 4 frames, one point per register
+    inline void loadPairsX4(const float* source, const int* ind, simde__m128& x0, simde__m128& x1)
+    {
+        simde__m128 p0p1 = simde_mm_castsi128_ps(simde_mm_loadl_epi64((const simde__m128i*)&source[ind[0]]));
+        simde__m128 p2p3 = simde_mm_castsi128_ps(simde_mm_loadl_epi64((const simde__m128i*)&source[ind[2]]));
+        p0p1 = simde_mm_loadh_pi(p0p1, (const simde__m64*)&source[ind[1]]);
+        p2p3 = simde_mm_loadh_pi(p2p3, (const simde__m64*)&source[ind[3]]);
+        x0 = simde_mm_shuffle_ps(p0p1, p2p3, SIMDE_MM_SHUFFLE(2, 0, 2, 0));
+        x1 = simde_mm_shuffle_ps(p0p1, p2p3, SIMDE_MM_SHUFFLE(3, 1, 3, 1));
+    }
+
+    // Load 4 consecutive points of 4 frames from an offset, one point per register
+    inline void loadQuadsX4(const float* source, const int* ind, int offset, simde__m128 x[4])
+    {
+        for (int i = 0; i < 4; ++i)
+            x[i] = simde_mm_loadu_ps(&source[ind[i] + offset]);
+        SIMDE_MM_TRANSPOSE4_PS(x[0], x[1], x[2], x[3]);
+    }
+
+    template <bool Adding>
+    inline void storeX4(float* output, simde__m128 value, const float* addingGains)
+    {
+        IF_CONSTEXPR(Adding)
+            value = simde_mm_add_ps(simde_mm_loadu_ps(output), simde_mm_mul_ps(simde_mm_loadu_ps(addingGains), value));
+        simde_mm_storeu_ps(output, value);
+    }
+
+    /**
+     * @brief Interpolate 4 frames at once, the frames in the lanes of the
+     * registers, and the remaining frames one at a time. The kernel computes
+     * the weights of the frames, which are shared by both channels.
+     */
+    template <InterpolatorModel M, class Kernel>
+    struct BlockInterpolatorX4 {
+        template <bool Adding>
+        static void process(
+            const float* leftSource, const float* rightSource, float* left, float* right,
+            const int* indices, const float* coeffs, const float* addingGains,
+            unsigned size, float mod, bool useAVX2)
+        {
+            UNUSED(useAVX2);
+            unsigned i = 0;
+            if (!rightSource) {
+                for (; i + 4 <= size; i += 4) {
+                    const float* gains = Adding ? &addingGains[i] : nullptr;
+                    const auto weights = Kernel::weights(simde_mm_loadu_ps(&coeffs[i]));
+                    storeX4<Adding>(&left[i], Kernel::apply(leftSource, &indices[i], weights), gains);
+                }
+            } else {
+                for (; i + 4 <= size; i += 4) {
+                    const float* gains = Adding ? &addingGains[i] : nullptr;
+                    const auto weights = Kernel::weights(simde_mm_loadu_ps(&coeffs[i]));
+                    storeX4<Adding>(&left[i], Kernel::apply(leftSource, &indices[i], weights), gains);
+                    storeX4<Adding>(&right[i], Kernel::apply(rightSource, &indices[i], weights), gains);
+                }
+            }
+
+            if (i < size) {
+                processFrames<M, Adding>(
+                    leftSource, rightSource, &left[i], rightSource ? &right[i] : nullptr,
+                    &indices[i], &coeffs[i], Adding ? &addingGains[i] : nullptr, size - i, mod);
+            }
+        }
+    };
+
+    struct LinearKernel {
+        struct Weights { simde__m128 w0, w1; };
+
+        static inline Weights weights(simde__m128 coeff)
+        {
+            return { simde_mm_sub_ps(simde_mm_set1_ps(1.0f), coeff), coeff };
+        }
+
+        static inline simde__m128 apply(const float* source, const int* ind, const Weights& w)
+        {
+            simde__m128 x0, x1;
+            loadPairsX4(source, ind, x0, x1);
+            return simde_mm_add_ps(simde_mm_mul_ps(x0, w.w0), simde_mm_mul_ps(x1, w.w1));
+        }
+    };
+
+    template <simde__m128 (*F)(simde__m128)>
+    struct CubicKernel {
+        struct Weights { simde__m128 w[4]; };
+
+        static inline Weights weights(simde__m128 coeff)
+        {
+            Weights w;
+            for (int i = 0; i < 4; ++i)
+                w.w[i] = F(simde_mm_sub_ps(simde_mm_set1_ps(static_cast<float>(i - 1)), coeff));
+            return w;
+        }
+
+        static inline simde__m128 apply(const float* source, const int* ind, const Weights& w)
+        {
+            simde__m128 x[4];
+            loadQuadsX4(source, ind, -1, x);
+            simde__m128 y = simde_mm_mul_ps(x[0], w.w[0]);
+            for (int i = 1; i < 4; ++i)
+                y = simde_mm_add_ps(y, simde_mm_mul_ps(x[i], w.w[i]));
+            return y;
+        }
+    };
+} // namespace BlockInterpolatorDetail
+
+//------------------------------------------------------------------------------
+// Block interpolation, SSE specializations
+
+template <>
+class BlockInterpolator<kInterpolatorLinear>
+    : public BlockInterpolatorDetail::BlockInterpolatorX4<
+        kInterpolatorLinear, BlockInterpolatorDetail::LinearKernel> {};
+
+template <>
+class BlockInterpolator<kInterpolatorHermite3>
+    : public BlockInterpolatorDetail::BlockInterpolatorX4<
+        kInterpolatorHermite3, BlockInterpolatorDetail::CubicKernel<&hermite3x4>> {};
+
+template <>
+class BlockInterpolator<kInterpolatorBspline3>
+    : public BlockInterpolatorDetail::BlockInterpolatorX4<
+        kInterpolatorBspline3, BlockInterpolatorDetail::CubicKernel<&bspline3x4>> {};
+
+/**
+ * @brief Windowed sinc block interpolation, which evaluates the sinc once per
+ * frame for both channels. It computes 4 frames at once, the frames in the
+ * lanes of the registers, or 8 frames with the AVX2 kernel when enabled.
+ */
+template <InterpolatorModel M, size_t Points>
+class SincBlockInterpolator
+{
+public:
+    template <bool Adding>
+    static void process(
+        const float* leftSource, const float* rightSource, float* left, float* right,
+        const int* indices, const float* coeffs, const float* addingGains,
+        unsigned size, float mod, bool useAVX2)
+    {
+        const auto &ws = *SincInterpolatorTraits<Points>::windowedSinc;
+
+#if SFIZZ_CPU_FAMILY_X86_64 || SFIZZ_CPU_FAMILY_I386
+        if (useAVX2) {
+            sincInterpolateAVX2(
+                ws.getTablePointer(), Points, ws.getTableSize(),
+                leftSource, rightSource, left, right, indices, coeffs,
+                Adding ? addingGains : nullptr, size);
+            return;
+        }
+#else
+        UNUSED(useAVX2);
+#endif
+
+        using namespace BlockInterpolatorDetail;
+        constexpr int j0 = 1 - int(Points) / 2;
+        const bool stereo = rightSource != nullptr;
+
+        // the table index of x is (x + Points / 2) * scale, see AbstractWindowedSinc;
+        // the scale is integral, so the points of a frame share the fractional part
+        const float* table = ws.getTablePointer();
+        const int step = static_cast<int>((ws.getTableSize() - 1) / Points);
+        const simde__m128 scale = simde_mm_set1_ps(static_cast<float>(step));
+
+        unsigned n = 0;
+        for (; n + 4 <= size; n += 4) {
+            const int* ind = &indices[n];
+            const simde__m128 ix = simde_mm_mul_ps(
+                simde_mm_sub_ps(simde_mm_set1_ps(j0 + Points / 2.0f), simde_mm_loadu_ps(&coeffs[n])), scale);
+            const simde__m128i i0 = simde_mm_cvttps_epi32(ix);
+            const simde__m128 mu = simde_mm_sub_ps(ix, simde_mm_cvtepi32_ps(i0));
+            alignas(simde__m128i) int tableIndices[4];
+            simde_mm_store_si128((simde__m128i*)tableIndices, i0);
+
+            simde__m128 yl = simde_mm_set1_ps(0.0f);
+            simde__m128 yr = simde_mm_set1_ps(0.0f);
+
+            for (int i = 0; i < int(Points); i += 4) {
+                simde__m128 l[4];
+                simde__m128 r[4];
+                loadQuadsX4(leftSource, ind, j0 + i, l);
+                if (stereo)
+                    loadQuadsX4(rightSource, ind, j0 + i, r);
+                for (int k = 0; k < 4; ++k) {
+                    simde__m128 y0, y1;
+                    loadPairsX4(&table[(i + k) * step], tableIndices, y0, y1);
+                    const simde__m128 h = simde_mm_add_ps(y0, simde_mm_mul_ps(mu, simde_mm_sub_ps(y1, y0)));
+                    yl = simde_mm_add_ps(yl, simde_mm_mul_ps(h, l[k]));
+                    if (stereo)
+                        yr = simde_mm_add_ps(yr, simde_mm_mul_ps(h, r[k]));
+                }
+            }
+
+            const float* gains = Adding ? &addingGains[n] : nullptr;
+            storeX4<Adding>(&left[n], yl, gains);
+            if (stereo)
+                storeX4<Adding>(&right[n], yr, gains);
+        }
+
+        if (n < size) {
+            processFrames<M, Adding>(
+                leftSource, rightSource, &left[n], stereo ? &right[n] : nullptr,
+                &indices[n], &coeffs[n], Adding ? &addingGains[n] : nullptr, size - n, mod);
+        }
+    }
+};
+
+template <>
+class BlockInterpolator<kInterpolatorSinc8> : public SincBlockInterpolator<kInterpolatorSinc8, 8> {};
+template <>
+class BlockInterpolator<kInterpolatorSinc12> : public SincBlockInterpolator<kInterpolatorSinc12, 12> {};
+template <>
+class BlockInterpolator<kInterpolatorSinc16> : public SincBlockInterpolator<kInterpolatorSinc16, 16> {};
+template <>
+class BlockInterpolator<kInterpolatorSinc24> : public SincBlockInterpolator<kInterpolatorSinc24, 24> {};
+template <>
+class BlockInterpolator<kInterpolatorSinc36> : public SincBlockInterpolator<kInterpolatorSinc36, 36> {};
+template <>
+class BlockInterpolator<kInterpolatorSinc48> : public SincBlockInterpolator<kInterpolatorSinc48, 48> {};
+template <>
+class BlockInterpolator<kInterpolatorSinc60> : public SincBlockInterpolator<kInterpolatorSinc60, 60> {};
+template <>
+class BlockInterpolator<kInterpolatorSinc72> : public SincBlockInterpolator<kInterpolatorSinc72, 72> {};
+#endif
+
+template <InterpolatorModel M, bool Adding>
+inline void interpolateBlock(
+    const float* leftSource, const float* rightSource, float* left, float* right,
+    const int* indices, const float* coeffs, const float* addingGains,
+    unsigned size, float mod, bool useAVX2)
+{
+    BlockInterpolator<M>::template process<Adding>(
+        leftSource, rightSource, left, right, indices, coeffs, addingGains, size, mod, useAVX2);
+}
+
 } // namespace sfz
@@ -46,6 +46,9 @@ struct LFO::Impl {
     std::array<float, config::maxLFOSubs> subPhases_ {{}};
     std::array<float, config::maxLFOSubs> sampleHoldMem_ {{}};
     std::array<int, config::maxLFOSubs> sampleHoldState_ {{}};
+
+    // per-LFO generator, the voices being rendered concurrently
+    fast_rand randomGenerator_ { Random::randomGenerator() };
 };
 
 LFO::LFO(Resources& resources)
@@ -197,7 +200,7 @@ void LFO::processSH(unsigned nth, absl::Span<float> out, const float* phaseIn)
         // value updates twice every period
         if (sampleHoldState != oldState) {
             std::uniform_real_distribution<float> dist(-1.0f, +1.0f);
-            sampleHoldValue = dist(Random::randomGenerator);
+            sampleHoldValue = dist(impl.randomGenerator_);
         }
     }
 
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include <ghc/fs_std.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+namespace sfz {
+
+/**
+ * @brief A read-only memory mapping of a whole file.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file, closing the current mapping if any.
+     *
+     * @param path the file to map, which must not be empty
+     * @param ec the error if the mapping failed
+     * @return true if the file was mapped
+     */
+    bool open(const fs::path& path, std::error_code& ec) noexcept;
+
+    /**
+     * @brief Unmap the file.
+     */
+    void close() noexcept;
+
+    explicit operator bool() const noexcept { return data_ != nullptr; }
+
+    /**
+     * @brief Get the mapped bytes.
+     */
+    const uint8_t* data() const noexcept { return data_; }
+
+    /**
+     * @brief Get the number of mapped bytes.
+     */
+    size_t size() const noexcept { return size_; }
+
+private:
+    const uint8_t* data_ { nullptr };
+    size_t size_ { 0 };
+#if defined(_WIN32)
+    void* mapping_ { nullptr };
+#endif
+};
+
+} // namespace sfz
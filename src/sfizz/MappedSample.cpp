@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "MappedSample.h"
+#include "MathHelpers.h"
+#include <algorithm>
+#include <cstring>
+
+namespace sfz {
+
+namespace {
+
+constexpr uint16_t waveFormatPcm { 1 };
+constexpr uint16_t waveFormatFloat { 3 };
+constexpr uint16_t waveFormatExtensible { 0xFFFE };
+
+uint16_t readU16(const uint8_t* p) noexcept
+{
+    return uint16_t(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) noexcept
+{
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+bool isLittleEndianHost() noexcept
+{
+    const uint16_t probe { 1 };
+    uint8_t firstByte;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+}
+
+float decodeInt16(const uint8_t* p) noexcept
+{
+    return float(int16_t(readU16(p))) * (1.0f / 32768.0f);
+}
+
+float decodeInt24(const uint8_t* p) noexcept
+{
+    const int32_t value = int32_t((uint32_t(p[0]) << 8) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 24)) >> 8;
+    return float(value) * (1.0f / 8388608.0f);
+}
+
+float decodeInt32(const uint8_t* p) noexcept
+{
+    return float(int32_t(readU32(p))) * (1.0f / 2147483648.0f);
+}
+
+float decodeFloat32(const uint8_t* p) noexcept
+{
+    float value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Convert interleaved frames to the planar output, moving by `step`
+ * bytes from one frame to the next.
+ */
+template <float (*Decode)(const uint8_t*)>
+void copyFrames(const uint8_t* frame, ptrdiff_t step, unsigned sampleBytes, unsigned numChannels,
+    AudioSpan<float> output, size_t offset, size_t count) noexcept
+{
+    for (size_t c = 0, n = output.getNumChannels(); c < n; ++c) {
+        const uint8_t* sample = frame + std::min<size_t>(c, numChannels - 1) * sampleBytes;
+        float* out = output.getChannel(c) + offset;
+        for (size_t i = 0; i < count; ++i, sample += step)
+            out[i] = Decode(sample);
+    }
+}
+
+} // namespace
+
+std::shared_ptr<MappedSample> MappedSample::open(const fs::path& path, bool reverse) noexcept
+{
+    if (!isLittleEndianHost())
+        return {};
+
+    std::error_code ec;
+    MappedFile mapping;
+    if (!mapping.open(path, ec))
+        return {};
+
+    const uint8_t* bytes = mapping.data();
+    const size_t size = mapping.size();
+    if (size < 12 || std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0)
+        return {};
+
+    const uint8_t* format = nullptr;
+    const uint8_t* frames = nullptr;
+    size_t dataSize = 0;
+    uint32_t formatSize = 0;
+
+    // walk the chunks, which are padded to an even size
+    size_t position = 12;
+    while (position + 8 <= size && !(format && frames)) {
+        const uint8_t* chunk = bytes + position;
+        const size_t chunkSize = readU32(chunk + 4);
+        const size_t available = size - position - 8;
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && chunkSize <= available) {
+            format = chunk + 8;
+            formatSize = static_cast<uint32_t>(chunkSize);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            frames = chunk + 8;
+            dataSize = std::min(chunkSize, available);
+        }
+        position += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (!format || !frames)
+        return {};
+
+    uint16_t formatTag = readU16(format);
+    const unsigned numChannels = readU16(format + 2);
+    const unsigned blockAlign = readU16(format + 12);
+    const unsigned bitsPerSample = readU16(format + 14);
+    if (formatTag == waveFormatExtensible && formatSize >= 40)
+        formatTag = readU16(format + 24);
+
+    Encoding encoding;
+    if (formatTag == waveFormatPcm && bitsPerSample == 16)
+        encoding = Encoding::Int16;
+    else if (formatTag == waveFormatPcm && bitsPerSample == 24)
+        encoding = Encoding::Int24;
+    else if (formatTag == waveFormatPcm && bitsPerSample == 32)
+        encoding = Encoding::Int32;
+    else if (formatTag == waveFormatFloat && bitsPerSample == 32)
+        encoding = Encoding::Float32;
+    else
+        return {};
+
+    if ((numChannels != 1 && numChannels != 2) || blockAlign != numChannels * bitsPerSample / 8)
+        return {};
+
+    const int64_t numFrames = static_cast<int64_t>(dataSize / blockAlign);
+    if (numFrames == 0)
+        return {};
+
+    std::shared_ptr<MappedSample> sample { new MappedSample };
+    sample->mapping_ = std::move(mapping);
+    sample->frames_ = frames;
+    sample->numFrames_ = numFrames;
+    sample->numChannels_ = numChannels;
+    sample->bytesPerFrame_ = blockAlign;
+    sample->encoding_ = encoding;
+    sample->reverse_ = reverse;
+    return sample;
+}
+
+void MappedSample::read(int64_t first, AudioSpan<float> output) const noexcept
+{
+    const auto outputFrames = static_cast<int64_t>(output.getNumFrames());
+    const int64_t begin = clamp<int64_t>(-first, 0, outputFrames);
+    const int64_t end = clamp<int64_t>(numFrames_ - first, begin, outputFrames);
+
+    for (size_t c = 0, n = output.getNumChannels(); c < n; ++c) {
+        absl::Span<float> channel = output.getSpan(c);
+        std::fill(channel.begin(), channel.begin() + begin, 0.0f);
+        std::fill(channel.begin() + end, channel.end(), 0.0f);
+    }
+
+    if (begin == end)
+        return;
+
+    const int64_t firstFrame = reverse_ ? numFrames_ - 1 - (first + begin) : first + begin;
+    const uint8_t* frame = frames_ + firstFrame * bytesPerFrame_;
+    const ptrdiff_t step = reverse_ ? -ptrdiff_t(bytesPerFrame_) : ptrdiff_t(bytesPerFrame_);
+    const unsigned sampleBytes = bytesPerFrame_ / numChannels_;
+    const auto offset = static_cast<size_t>(begin);
+    const auto count = static_cast<size_t>(end - begin);
+
+    switch (encoding_) {
+    case Encoding::Int16:
+        copyFrames<decodeInt16>(frame, step, sampleBytes, numChannels_, output, offset, count);
+        break;
+    case Encoding::Int24:
+        copyFrames<decodeInt24>(frame, step, sampleBytes, numChannels_, output, offset, count);
+        break;
+    case Encoding::Int32:
+        copyFrames<decodeInt32>(frame, step, sampleBytes, numChannels_, output, offset, count);
+        break;
+    case Encoding::Float32:
+        copyFrames<decodeFloat32>(frame, step, sampleBytes, numChannels_, output, offset, count);
+        break;
+    }
+}
+
+} // namespace sfz
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "AudioSpan.h"
+#include "MappedFile.h"
+#include "utility/LeakDetector.h"
+#include <ghc/fs_std.hpp>
+#include <cstdint>
+#include <memory>
+
+namespace sfz {
+
+/**
+ * @brief The frames of an uncompressed WAV file, read in place from a memory
+ * mapping of the file.
+ *
+ * The file is never decoded as a whole: the frames are converted to float
+ * when they are read, so that the memory use is left to the page cache of
+ * the system, and the pages are shared between all the users of the file.
+ * Mono and stereo files of 16, 24 or 32 bits PCM and 32 bits float are
+ * supported.
+ */
+class MappedSample {
+public:
+    /**
+     * @brief Map a WAV file.
+     *
+     * @param path the file
+     * @param reverse whether the frames are read backwards
+     * @return the sample, or null if the file is not a supported WAV file
+     */
+    static std::shared_ptr<MappedSample> open(const fs::path& path, bool reverse) noexcept;
+
+    /**
+     * @brief Get the number of frames.
+     */
+    int64_t getNumFrames() const noexcept { return numFrames_; }
+
+    /**
+     * @brief Get the number of channels.
+     */
+    unsigned getNumChannels() const noexcept { return numChannels_; }
+
+    /**
+     * @brief Copy frames, converted to float. Frames which are out of the
+     * sample are zeroed, and a mono sample is copied to every output channel.
+     *
+     * @param first the first frame to copy
+     * @param output the destination, determining the number of frames
+     */
+    void read(int64_t first, AudioSpan<float> output) const noexcept;
+
+private:
+    enum class Encoding { Int16, Int24, Int32, Float32 };
+
+    MappedFile mapping_;
+    const uint8_t* frames_ { nullptr };
+    int64_t numFrames_ { 0 };
+    unsigned numChannels_ { 0 };
+    unsigned bytesPerFrame_ { 0 };
+    Encoding encoding_ { Encoding::Int16 };
+    bool reverse_ { false };
+
+    LEAK_DETECTOR(MappedSample);
+};
+
+} // namespace sfz
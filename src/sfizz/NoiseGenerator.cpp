@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "NoiseGenerator.h"
+#include <algorithm>
+#include <cmath>
+#if SIMDE_NATURAL_VECTOR_SIZE_GE(128)
+#include <simde/x86/sse2.h>
+#endif
+
+namespace sfz {
+
+constexpr unsigned NoiseGenerator::numLanes;
+constexpr unsigned NoiseGenerator::numGroups;
+
+// Number of uniform variables summed in a gaussian one
+constexpr unsigned gaussianQuality { NoiseGenerator::numGroups };
+
+// Scale of a signed 32-bit integer to [-1, 1]
+constexpr float intToUnit { 1.0f / (1ll << 31) };
+
+NoiseGenerator::NoiseGenerator(uint32_t initialSeed)
+{
+    seed(initialSeed);
+}
+
+void NoiseGenerator::seed(uint32_t s) noexcept
+{
+    // decorrelate the lanes with a hash of the seed, since xorshift is linear
+    // and related states would give correlated sequences, and avoid the null
+    // state of xorshift
+    for (uint32_t& state : state_) {
+        s += 0x9e3779b9u;
+        uint32_t h = s;
+        h = (h ^ (h >> 16)) * 0x85ebca6bu;
+        h = (h ^ (h >> 13)) * 0xc2b2ae35u;
+        h ^= h >> 16;
+        state = h ? h : 1;
+    }
+}
+
+/**
+ * @brief Compute the output by blocks, storing a partial last block.
+ */
+template <unsigned BlockSize, class F>
+static inline void fillBlocks(absl::Span<float> output, F&& next) noexcept
+{
+    float* out = output.data();
+    const size_t size = output.size();
+
+    size_t i = 0;
+    for (; i + BlockSize <= size; i += BlockSize)
+        next(out + i);
+
+    if (i < size) {
+        float last[BlockSize];
+        next(last);
+        std::copy(last, last + (size - i), out + i);
+    }
+}
+
+#if SIMDE_NATURAL_VECTOR_SIZE_GE(128)
+/**
+ * @brief Advance the xorshift32 sequences of the lanes.
+ */
+static inline simde__m128i xorshiftLanes(simde__m128i& state) noexcept
+{
+    simde__m128i x = state;
+    x = simde_mm_xor_si128(x, simde_mm_slli_epi32(x, 13));
+    x = simde_mm_xor_si128(x, simde_mm_srli_epi32(x, 17));
+    x = simde_mm_xor_si128(x, simde_mm_slli_epi32(x, 5));
+    state = x;
+    return x;
+}
+
+void NoiseGenerator::fillUniform(absl::Span<float> output, float bound) noexcept
+{
+    simde__m128i* stateData = reinterpret_cast<simde__m128i*>(state_.data());
+    simde__m128i state[numGroups];
+    for (unsigned g = 0; g < numGroups; ++g)
+        state[g] = simde_mm_loadu_si128(&stateData[g]);
+
+    const simde__m128 gain = simde_mm_set1_ps(bound * intToUnit);
+
+    fillBlocks<numGroups * numLanes>(output, [&](float* block) {
+        for (unsigned g = 0; g < numGroups; ++g) {
+            const simde__m128 x = simde_mm_cvtepi32_ps(xorshiftLanes(state[g]));
+            simde_mm_storeu_ps(block + g * numLanes, simde_mm_mul_ps(x, gain));
+        }
+    });
+
+    for (unsigned g = 0; g < numGroups; ++g)
+        simde_mm_storeu_si128(&stateData[g], state[g]);
+}
+
+void NoiseGenerator::fillGaussian(absl::Span<float> output, float mean, float variance) noexcept
+{
+    simde__m128i* stateData = reinterpret_cast<simde__m128i*>(state_.data());
+    simde__m128i state[numGroups];
+    for (unsigned g = 0; g < numGroups; ++g)
+        state[g] = simde_mm_loadu_si128(&stateData[g]);
+
+    const simde__m128 offset = simde_mm_set1_ps(mean);
+    const simde__m128 gain = simde_mm_set1_ps(variance / std::sqrt(gaussianQuality / 3.0f) * intToUnit);
+
+    fillBlocks<numLanes>(output, [&](float* block) {
+        simde__m128 sum = simde_mm_cvtepi32_ps(xorshiftLanes(state[0]));
+        for (unsigned g = 1; g < numGroups; ++g)
+            sum = simde_mm_add_ps(sum, simde_mm_cvtepi32_ps(xorshiftLanes(state[g])));
+        simde_mm_storeu_ps(block, simde_mm_add_ps(offset, simde_mm_mul_ps(sum, gain)));
+    });
+
+    for (unsigned g = 0; g < numGroups; ++g)
+        simde_mm_storeu_si128(&stateData[g], state[g]);
+}
+#else
+/**
+ * @brief Advance the xorshift32 sequence of a lane.
+ */
+static inline int32_t xorshift(uint32_t& state) noexcept
+{
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return static_cast<int32_t>(x);
+}
+
+void NoiseGenerator::fillUniform(absl::Span<float> output, float bound) noexcept
+{
+    const float gain = bound * intToUnit;
+
+    fillBlocks<numGroups * numLanes>(output, [&](float* block) {
+        for (unsigned l = 0; l < numGroups * numLanes; ++l)
+            block[l] = static_cast<float>(xorshift(state_[l])) * gain;
+    });
+}
+
+void NoiseGenerator::fillGaussian(absl::Span<float> output, float mean, float variance) noexcept
+{
+    const float gain = variance / std::sqrt(gaussianQuality / 3.0f) * intToUnit;
+
+    fillBlocks<numLanes>(output, [&](float* block) {
+        for (unsigned l = 0; l < numLanes; ++l) {
+            float sum = static_cast<float>(xorshift(state_[l]));
+            for (unsigned g = 1; g < numGroups; ++g)
+                sum += static_cast<float>(xorshift(state_[g * numLanes + l]));
+            block[l] = mean + sum * gain;
+        }
+    });
+}
+#endif
+
+} // namespace sfz
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "MathHelpers.h"
+#include <absl/types/span.h>
+#include <array>
+#include <cstdint>
+
+namespace sfz {
+
+/**
+ * @brief Generator of white noise by blocks, which runs interleaved
+ * xorshift sequences in the lanes of SIMD registers.
+ *
+ * There are 4 groups of 4 lanes, which are independent so they can be
+ * computed at once. The uniform noise takes its values from the groups in
+ * turn, and the gaussian noise sums one value of each group. The latter is
+ * the same approximation as `fast_gaussian_generator`, a sum of 4 uniform
+ * variables.
+ */
+class NoiseGenerator {
+public:
+    static constexpr unsigned numLanes = 4;
+    static constexpr unsigned numGroups = 4;
+
+    explicit NoiseGenerator(uint32_t initialSeed = Random::randomGenerator());
+
+    /**
+     * @brief Reinitialize the sequences from a seed.
+     */
+    void seed(uint32_t s) noexcept;
+
+    /**
+     * @brief Fill with uniform noise in the range [-bound, bound].
+     */
+    void fillUniform(absl::Span<float> output, float bound) noexcept;
+
+    /**
+     * @brief Fill with approximately normal noise, with the same parameters
+     * as `fast_gaussian_generator`.
+     */
+    void fillGaussian(absl::Span<float> output, float mean, float variance) noexcept;
+
+private:
+    std::array<uint32_t, numGroups * numLanes> state_ {{}};
+};
+
+} // namespace sfz
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "NoteActivationIndex.h"
+#include "Layer.h"
+#include "Region.h"
+#include <absl/algorithm/container.h>
+#include <algorithm>
+
+namespace sfz {
+
+/**
+ * @brief Check whether a layer must see every note-on of its keys.
+ */
+static bool needsAllNoteOns(const Region& region)
+{
+    // the sequence counts the notes out of the velocity range and the
+    // switched off notes too
+    if (region.usesSequenceSwitches || region.sequenceLength != Default::sequence)
+        return true;
+
+    // the velocity which is checked is not the one of the note
+    if (region.velocityOverride == VelocityOverride::previous)
+        return true;
+
+    return false;
+}
+
+/**
+ * @brief Check whether the key switch state of a layer only depends on its
+ * `sw_last` key, so that it is shared by the layers with the same key.
+ */
+static bool hasLastKeyswitchOnly(const Region& region)
+{
+    return region.lastKeyswitch && !region.lastKeyswitchRange
+        && !region.upKeyswitch && !region.downKeyswitch;
+}
+
+void NoteActivationIndex::build(absl::Span<Layer* const> layers)
+{
+    clear();
+
+    // assign the layers to their partitions
+    std::vector<std::vector<uint32_t>> partitionLayers;
+    for (uint32_t position = 0, n = static_cast<uint32_t>(layers.size()); position < n; ++position) {
+        const Layer& layer = *layers[position];
+        const Region& region = layer.getRegion();
+
+        if (needsAllNoteOns(region)) {
+            alwaysCandidates_.push_back(position);
+            continue;
+        }
+
+        absl::optional<uint8_t> keyswitch;
+        if (hasLastKeyswitchOnly(region))
+            keyswitch = region.lastKeyswitch;
+
+        auto it = absl::c_find_if(partitions_, [keyswitch](const Partition& partition) {
+            return partition.keyswitch == keyswitch;
+        });
+        if (it == partitions_.end()) {
+            partitions_.emplace_back();
+            partitions_.back().keyswitch = keyswitch;
+            if (keyswitch)
+                partitions_.back().switchLayer = &layer;
+            partitionLayers.emplace_back();
+            it = partitions_.end() - 1;
+        }
+
+        partitionLayers[it - partitions_.begin()].push_back(position);
+    }
+
+    // sort the partitions by velocity range
+    for (size_t p = 0, numPartitions = partitions_.size(); p < numPartitions; ++p) {
+        Partition& partition = partitions_[p];
+        std::vector<uint32_t>& positions = partitionLayers[p];
+
+        auto velocityRange = [&layers](uint32_t position) {
+            return layers[position]->getRegion().velocityRange;
+        };
+
+        std::stable_sort(positions.begin(), positions.end(), [&](uint32_t lhs, uint32_t rhs) {
+            return velocityRange(lhs).getStart() < velocityRange(rhs).getStart();
+        });
+
+        const size_t size = positions.size();
+        partition.starts.reserve(size);
+        partition.ends.reserve(size);
+        partition.maxEnds.reserve(size);
+        for (uint32_t position : positions) {
+            const auto range = velocityRange(position);
+            partition.starts.push_back(range.getStart());
+            partition.ends.push_back(range.getEnd());
+            partition.maxEnds.push_back(partition.maxEnds.empty() ? range.getEnd()
+                : std::max(partition.maxEnds.back(), range.getEnd()));
+        }
+        partition.positions = std::move(positions);
+    }
+}
+
+void NoteActivationIndex::clear()
+{
+    alwaysCandidates_.clear();
+    partitions_.clear();
+}
+
+void NoteActivationIndex::collectCandidates(float velocity, std::vector<uint32_t>& candidates) const noexcept
+{
+    candidates.assign(alwaysCandidates_.begin(), alwaysCandidates_.end());
+
+    for (const Partition& partition : partitions_) {
+        if (partition.switchLayer && !partition.switchLayer->keySwitched_)
+            continue;
+
+        // the layers before `first` all end below the velocity, and the
+        // layers from `last` all start above it
+        const size_t first = std::lower_bound(
+            partition.maxEnds.begin(), partition.maxEnds.end(), velocity) - partition.maxEnds.begin();
+        const size_t last = std::upper_bound(
+            partition.starts.begin(), partition.starts.end(), velocity) - partition.starts.begin();
+
+        for (size_t i = first; i < last; ++i) {
+            if (partition.ends[i] >= velocity)
+                candidates.push_back(partition.positions[i]);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+}
+
+} // namespace sfz
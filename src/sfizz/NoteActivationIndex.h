@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "utility/LeakDetector.h"
+#include <absl/types/optional.h>
+#include <absl/types/span.h>
+#include <cstdint>
+#include <vector>
+
+namespace sfz {
+struct Layer;
+
+/**
+ * @brief An index of the layers mapped to a key, which finds the layers
+ * a note-on may trigger without checking all of them.
+ *
+ * The layers are partitioned by their `sw_last` key switch, so that the
+ * articulations which are switched off are skipped at once, and each
+ * partition is sorted by velocity range so that the layers containing the
+ * velocity are found with a binary search. Only the candidates are then
+ * checked completely with `Layer::registerNoteOn`.
+ *
+ * The layers which must see all the notes of the key, because they count
+ * them in a sequence or they use the velocity of the previous note, are
+ * always candidates.
+ */
+class NoteActivationIndex {
+public:
+    /**
+     * @brief Build the index of a key from the list of its layers.
+     */
+    void build(absl::Span<Layer* const> layers);
+
+    /**
+     * @brief Remove all the layers.
+     */
+    void clear();
+
+    /**
+     * @brief Collect the positions, in the list the index was built from,
+     * of the layers which may trigger on a note with this velocity.
+     *
+     * The positions are sorted, so that the layers are considered in the
+     * same order as the list. The candidates do not allocate if they were
+     * reserved for the size of the list.
+     */
+    void collectCandidates(float velocity, std::vector<uint32_t>& candidates) const noexcept;
+
+private:
+    struct Partition {
+        // The key switch of the layers, or none for the layers without one
+        absl::optional<uint8_t> keyswitch;
+        // A layer whose key switch state is the one of the whole partition
+        const Layer* switchLayer { nullptr };
+        // The velocity ranges sorted by start, and the running maximum of
+        // their ends
+        std::vector<float> starts;
+        std::vector<float> ends;
+        std::vector<float> maxEnds;
+        std::vector<uint32_t> positions;
+    };
+
+    std::vector<uint32_t> alwaysCandidates_;
+    std::vector<Partition> partitions_;
+    LEAK_DETECTOR(NoteActivationIndex);
+};
+
+} // namespace sfz
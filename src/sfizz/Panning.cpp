@@ -1,5 +1,9 @@
 #include "Panning.h"
 #include "MathHelpers.h"
+#include "SIMDHelpers.h"
+#include "SIMDConfig.h"
+#include "simd/HelpersSSE.h"
+#include "simd/HelpersAVX.h"
 #include <array>
 #include <cmath>
 
@@ -47,8 +51,30 @@ inline void tickPan(const float* pan, float* leftBuffer, float* rightBuffer)
     *rightBuffer *= panLookup(1 - p);
 }
 
+#if SFIZZ_CPU_FAMILY_X86_64 || SFIZZ_CPU_FAMILY_I386
+static bool useInstructionSet(SIMDInstructionSet set)
+{
+    return getSIMDInstructionSetStatus<float>(set) && hasSIMDInstructionSet(set);
+}
+#endif
+
 void pan(const float* panEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
 {
+#if SFIZZ_CPU_FAMILY_X86_64 || SFIZZ_CPU_FAMILY_I386
+    // The x86 versions compute the pan law with a polynomial rather than
+    // looking up the table, which would need a gather for each channel
+    if (getSIMDOpStatus<float>(SIMDOps::pan)) {
+        if (useInstructionSet(SIMDInstructionSet::AVX)) {
+            panAVX(panEnvelope, leftBuffer, rightBuffer, size);
+            return;
+        }
+        if (useInstructionSet(SIMDInstructionSet::SSE)) {
+            panSSE(panEnvelope, leftBuffer, rightBuffer, size);
+            return;
+        }
+    }
+#endif
+
     const auto* sentinel = panEnvelope + size;
 
 #if SFIZZ_HAVE_NEON
@@ -110,8 +136,31 @@ inline void tickWidth(const float* width, float* leftBuffer, float* rightBuffer)
     *rightBuffer = l * coeff1 + r * coeff2;
 }
 
+void pan1(float panValue, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
+{
+    // the gains of the modulated version, panning a unit frame
+    float leftGain = 1.0f;
+    float rightGain = 1.0f;
+    pan(&panValue, &leftGain, &rightGain, 1);
+    applyGain1<float>(leftGain, leftBuffer, leftBuffer, size);
+    applyGain1<float>(rightGain, rightBuffer, rightBuffer, size);
+}
+
 void width(const float* widthEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
 {
+#if SFIZZ_CPU_FAMILY_X86_64 || SFIZZ_CPU_FAMILY_I386
+    if (getSIMDOpStatus<float>(SIMDOps::width)) {
+        if (useInstructionSet(SIMDInstructionSet::AVX)) {
+            widthAVX(widthEnvelope, leftBuffer, rightBuffer, size);
+            return;
+        }
+        if (useInstructionSet(SIMDInstructionSet::SSE)) {
+            widthSSE(widthEnvelope, leftBuffer, rightBuffer, size);
+            return;
+        }
+    }
+#endif
+
     const auto* sentinel = widthEnvelope + size;
 
 #if SFIZZ_HAVE_NEON
@@ -165,4 +214,19 @@ void width(const float* widthEnvelope, float* leftBuffer, float* rightBuffer, un
     }
 }
 
+
+void width1(float widthValue, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
+{
+    // the coefficients of the modulated version, processing a unit frame
+    float coeff2 = 1.0f;
+    float coeff1 = 0.0f;
+    width(&widthValue, &coeff2, &coeff1, 1);
+    for (unsigned i = 0; i < size; ++i) {
+        const float l = leftBuffer[i];
+        const float r = rightBuffer[i];
+        leftBuffer[i] = l * coeff2 + r * coeff1;
+        rightBuffer[i] = l * coeff1 + r * coeff2;
+    }
+}
+
 }
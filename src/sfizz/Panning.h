@@ -31,6 +31,21 @@ inline void pan(absl::Span<const float> panEnvelope, absl::Span<float> leftBuffe
     pan(panEnvelope.data(), leftBuffer.data(), rightBuffer.data(), minSpanSize(panEnvelope, leftBuffer, rightBuffer));
 }
 
+/**
+ * @brief Pans a mono signal left or right, with a constant pan value
+ *
+ * @param panValue
+ * @param leftBuffer
+ * @param rightBuffer
+ * @param size
+ */
+void pan1(float panValue, float* leftBuffer, float* rightBuffer, unsigned size) noexcept;
+inline void pan1(float panValue, absl::Span<float> leftBuffer, absl::Span<float> rightBuffer) noexcept
+{
+    CHECK_SPAN_SIZES(leftBuffer, rightBuffer);
+    pan1(panValue, leftBuffer.data(), rightBuffer.data(), minSpanSize(leftBuffer, rightBuffer));
+}
+
 /**
  * @brief Controls the width of a stereo signal, setting it to mono when width = 0 and inverting the channels
  * when width = -1. Width = 1 has no effect.
@@ -47,4 +62,19 @@ inline void width(absl::Span<const float> widthEnvelope, absl::Span<float> leftB
     width(widthEnvelope.data(), leftBuffer.data(), rightBuffer.data(), minSpanSize(widthEnvelope, leftBuffer, rightBuffer));
 }
 
+/**
+ * @brief Controls the width of a stereo signal, with a constant width value
+ *
+ * @param widthValue
+ * @param leftBuffer
+ * @param rightBuffer
+ * @param size
+ */
+void width1(float widthValue, float* leftBuffer, float* rightBuffer, unsigned size) noexcept;
+inline void width1(float widthValue, absl::Span<float> leftBuffer, absl::Span<float> rightBuffer) noexcept
+{
+    CHECK_SPAN_SIZES(leftBuffer, rightBuffer);
+    width1(widthValue, leftBuffer.data(), rightBuffer.data(), minSpanSize(leftBuffer, rightBuffer));
+}
+
 }
@@ -19,7 +19,10 @@ void sfz::PolyphonyGroup::registerVoice(Voice* voice) noexcept
 
 void sfz::PolyphonyGroup::removeVoice(const Voice* voice) noexcept
 {
-    swapAndPopFirst(voices, [voice](const Voice* v) { return v == voice; });
+    // keep the order of the voices, which the voice stealers use
+    auto it = absl::c_find(voices, voice);
+    if (it != voices.end())
+        voices.erase(it);
 }
 
 void sfz::PolyphonyGroup::removeAllVoices() noexcept
@@ -378,6 +378,16 @@ struct Region {
 
     // Effects
     std::vector<float> gainToEffect;
+    // The non-zero entries of `gainToEffect` whose buses exist, computed at
+    // the end of loading
+    struct EffectSend {
+        unsigned bus;
+        float gain;
+    };
+    std::vector<EffectSend> effectSends;
+    // The index of the submix which applies the filters and equalizers of
+    // the region, if they are static, computed at the end of loading
+    absl::optional<unsigned> filterSubmix;
 
     bool triggerOnCC { false }; // whether the region triggers on CC events or note events
     bool triggerOnNote { true };
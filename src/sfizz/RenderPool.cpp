@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "RenderPool.h"
+#include "Config.h"
+#include "utility/Debug.h"
+#include <absl/memory/memory.h>
+#include <algorithm>
+#include <system_error>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace sfz {
+
+static thread_local unsigned renderWorkerIndex = 0;
+
+RenderPool::RenderPool()
+{
+    setNumWorkers(1);
+}
+
+RenderPool::~RenderPool()
+{
+    setNumWorkers(0);
+}
+
+unsigned RenderPool::currentWorkerIndex() noexcept
+{
+    return renderWorkerIndex;
+}
+
+void RenderPool::setNumWorkers(unsigned numWorkers)
+{
+    if (!workers_.empty()) {
+        quit_.store(true);
+        for (auto& worker : workers_)
+            worker->startSemaphore.post();
+        for (auto& worker : workers_)
+            worker->thread.join();
+        workers_.clear();
+        quit_.store(false);
+    }
+
+    numWorkers_ = std::max(1u, numWorkers);
+    ranges_.reset(new TaskRange[numWorkers_]);
+
+    if (numWorkers == 0)
+        return;
+
+    workers_.reserve(numWorkers_ - 1);
+    for (unsigned i = 1; i < numWorkers_; ++i) {
+        auto worker = absl::make_unique<Worker>();
+        worker->thread = std::thread(&RenderPool::workerJob, this, worker.get(), i);
+        workers_.push_back(std::move(worker));
+    }
+}
+
+void RenderPool::run(unsigned numTasks, TaskFunction function, void* data) noexcept
+{
+    if (numTasks == 0)
+        return;
+
+    const unsigned numWorkers = std::min(numWorkers_, numTasks);
+
+    if (numWorkers == 1) {
+        for (unsigned i = 0; i < numTasks; ++i)
+            function(data, 0, i);
+        return;
+    }
+
+    function_ = function;
+    data_ = data;
+
+    // distribute the tasks evenly across all the workers, including
+    // those which will not be woken up, so these ranges get stolen
+    for (unsigned w = 0; w < numWorkers_; ++w) {
+        TaskRange& range = ranges_[w];
+        range.next.store(static_cast<unsigned>(uint64_t(numTasks) * w / numWorkers_), std::memory_order_relaxed);
+        range.end = static_cast<unsigned>(uint64_t(numTasks) * (w + 1) / numWorkers_);
+    }
+
+    numBusyWorkers_.store(numWorkers - 1, std::memory_order_relaxed);
+    for (unsigned w = 1; w < numWorkers; ++w)
+        workers_[w - 1]->startSemaphore.post();
+
+    processTasks(0);
+
+    // the calling thread is done, wait for the stragglers: the last one
+    // always posts, so the semaphore is taken even if the spin succeeds
+    for (unsigned spin = 0; spin < config::renderWorkerSpinCount; ++spin) {
+        if (numBusyWorkers_.load(std::memory_order_acquire) == 0)
+            break;
+    }
+    doneSemaphore_.wait();
+
+    function_ = nullptr;
+    data_ = nullptr;
+}
+
+void RenderPool::processTasks(unsigned workerIndex) noexcept
+{
+    const unsigned numRanges = numWorkers_;
+    const TaskFunction function = function_;
+    void* data = data_;
+
+    for (unsigned r = 0; r < numRanges; ++r) {
+        // start with the own range, then steal from the next ones
+        TaskRange& range = ranges_[(workerIndex + r) % numRanges];
+        const unsigned end = range.end;
+        unsigned task;
+        while (range.next.load(std::memory_order_relaxed) < end &&
+               (task = range.next.fetch_add(1, std::memory_order_relaxed)) < end)
+            function(data, workerIndex, task);
+    }
+}
+
+void RenderPool::workerJob(Worker* worker, unsigned workerIndex)
+{
+    renderWorkerIndex = workerIndex;
+    raiseCurrentThreadPriority();
+
+    for (;;) {
+        worker->startSemaphore.wait();
+        if (quit_.load())
+            break;
+        processTasks(workerIndex);
+        if (numBusyWorkers_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            doneSemaphore_.post();
+    }
+}
+
+void RenderPool::raiseCurrentThreadPriority() noexcept
+{
+#if defined(_WIN32)
+    HANDLE thread = GetCurrentThread();
+    if (!SetThreadPriority(thread, THREAD_PRIORITY_TIME_CRITICAL)) {
+        std::system_error error(GetLastError(), std::system_category());
+        DBG("[sfizz] Cannot set the render worker priority: " << error.what());
+    }
+#else
+    pthread_t thread = pthread_self();
+    int policy;
+    sched_param param;
+
+    if (pthread_getschedparam(thread, &policy, &param) != 0) {
+        DBG("[sfizz] Cannot get the render worker scheduling parameters");
+        return;
+    }
+
+    // like the audio threads of the hosts, which run with SCHED_FIFO
+    policy = SCHED_FIFO;
+    const int minprio = sched_get_priority_min(policy);
+    const int maxprio = sched_get_priority_max(policy);
+    param.sched_priority = minprio + config::renderWorkerPthreadPriority * (maxprio - minprio) / 100;
+
+    if (pthread_setschedparam(thread, policy, &param) != 0) {
+        DBG("[sfizz] Cannot set the render worker scheduling parameters");
+        return;
+    }
+#endif
+}
+
+} // namespace sfz
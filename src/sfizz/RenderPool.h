@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "RTSemaphore.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace sfz {
+
+/**
+ * @brief A fixed set of worker threads which cooperate with the calling
+ * thread to process a batch of independent tasks.
+ *
+ * The tasks are split in contiguous ranges, one per worker. A worker which
+ * exhausts its own range steals the remaining tasks of the other ranges.
+ * Claiming a task is a single atomic increment, so that `run` neither
+ * locks nor allocates once the workers are created.
+ *
+ * The calling thread always participates as the worker of index 0. The
+ * background workers run at real-time priority, and the calling thread
+ * spins for a short while on the last tasks before it blocks.
+ */
+class RenderPool {
+public:
+    using TaskFunction = void (*)(void* data, unsigned workerIndex, unsigned taskIndex);
+
+    RenderPool();
+    ~RenderPool();
+
+    RenderPool(const RenderPool&) = delete;
+    RenderPool& operator=(const RenderPool&) = delete;
+
+    /**
+     * @brief Set the number of workers, including the calling thread.
+     * This creates or joins the background threads, and must not be called
+     * concurrently with `run`.
+     *
+     * @param numWorkers number of workers, 1 meaning no background thread
+     */
+    void setNumWorkers(unsigned numWorkers);
+
+    /**
+     * @brief Get the number of workers, including the calling thread.
+     */
+    unsigned getNumWorkers() const noexcept { return numWorkers_; }
+
+    /**
+     * @brief Process the tasks from 0 to `numTasks` exclusive, and return
+     * when all of them are done.
+     *
+     * @param numTasks the number of tasks
+     * @param function the task function
+     * @param data an opaque pointer passed to the task function
+     */
+    void run(unsigned numTasks, TaskFunction function, void* data) noexcept;
+
+    /**
+     * @brief Process the tasks from 0 to `numTasks` exclusive, using a
+     * callable which accepts `(workerIndex, taskIndex)`.
+     */
+    template <class F>
+    void run(unsigned numTasks, F& function) noexcept
+    {
+        auto thunk = [](void* data, unsigned workerIndex, unsigned taskIndex) {
+            (*reinterpret_cast<F*>(data))(workerIndex, taskIndex);
+        };
+        run(numTasks, thunk, &function);
+    }
+
+    /**
+     * @brief Get the index of the worker which is the current thread, or 0
+     * if the current thread is not a background worker.
+     */
+    static unsigned currentWorkerIndex() noexcept;
+
+private:
+    struct alignas(64) TaskRange {
+        std::atomic<unsigned> next { 0 };
+        unsigned end { 0 };
+    };
+
+    struct Worker {
+        RTSemaphore startSemaphore;
+        std::thread thread;
+    };
+
+    void workerJob(Worker* worker, unsigned workerIndex);
+    void processTasks(unsigned workerIndex) noexcept;
+    static void raiseCurrentThreadPriority() noexcept;
+
+    unsigned numWorkers_ { 1 };
+    std::unique_ptr<TaskRange[]> ranges_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    TaskFunction function_ { nullptr };
+    void* data_ { nullptr };
+    std::atomic<unsigned> numBusyWorkers_ { 0 };
+    RTSemaphore doneSemaphore_;
+    std::atomic<bool> quit_ { false };
+};
+
+} // namespace sfz
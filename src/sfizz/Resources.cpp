@@ -5,6 +5,7 @@
 // If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
 
 #include "Resources.h"
+#include "Config.h"
 #include "SynthConfig.h"
 #include "MidiState.h"
 #include "FilePool.h"
@@ -15,7 +16,11 @@
 #include "Tuning.h"
 #include "BeatClock.h"
 #include "Metronome.h"
+#include "RenderPool.h"
 #include "modulations/ModMatrix.h"
+#include "utility/Debug.h"
+#include <absl/memory/memory.h>
+#include <vector>
 
 namespace sfz {
 
@@ -32,6 +37,8 @@ struct Resources::Impl {
     ModMatrix modMatrix;
     BeatClock beatClock;
     Metronome metronome;
+    int samplesPerBlock { config::defaultSamplesPerBlock };
+    std::vector<std::unique_ptr<BufferPool>> workerBufferPools;
 };
 
 Resources::Resources()
@@ -55,12 +62,32 @@ void Resources::setSampleRate(float samplerate)
 void Resources::setSamplesPerBlock(int samplesPerBlock)
 {
     Impl& impl = *impl_;
+    impl.samplesPerBlock = samplesPerBlock;
     impl.bufferPool.setBufferSize(samplesPerBlock);
+    for (auto& pool : impl.workerBufferPools)
+        pool->setBufferSize(samplesPerBlock);
     impl.midiState.setSamplesPerBlock(samplesPerBlock);
     impl.modMatrix.setSamplesPerBlock(samplesPerBlock);
     impl.beatClock.setSamplesPerBlock(samplesPerBlock);
 }
 
+void Resources::setNumRenderWorkers(unsigned numWorkers)
+{
+    Impl& impl = *impl_;
+    numWorkers = std::max(1u, numWorkers);
+
+    // the worker 0 is the calling thread, which uses the main pool
+    impl.workerBufferPools.resize(numWorkers - 1);
+    for (auto& pool : impl.workerBufferPools) {
+        if (!pool) {
+            pool = absl::make_unique<BufferPool>();
+            pool->setBufferSize(impl.samplesPerBlock);
+        }
+    }
+
+    impl.modMatrix.setNumWorkers(numWorkers);
+}
+
 void Resources::clear()
 {
     Impl& impl = *impl_;
@@ -81,6 +108,12 @@ const SynthConfig& Resources::getSynthConfig() const noexcept
 
 const BufferPool& Resources::getBufferPool() const noexcept
 {
+    const unsigned workerIndex = RenderPool::currentWorkerIndex();
+    if (workerIndex > 0) {
+        ASSERT(workerIndex <= impl_->workerBufferPools.size());
+        return *impl_->workerBufferPools[workerIndex - 1];
+    }
+
     return impl_->bufferPool;
 }
 
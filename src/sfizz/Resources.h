@@ -31,6 +31,11 @@ public:
 
     void setSampleRate(float samplerate);
     void setSamplesPerBlock(int samplesPerBlock);
+    /**
+     * @brief Set the number of workers which render voices concurrently.
+     * Each worker other than the calling thread gets its own buffer pool.
+     */
+    void setNumRenderWorkers(unsigned numWorkers);
     void clear();
 
     #define ACCESSOR_RW(Accessor, RetTy) \
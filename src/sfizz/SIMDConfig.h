@@ -14,6 +14,7 @@
    - SFIZZ_HAVE_SSE
    - SFIZZ_HAVE_SSE2
    - SFIZZ_HAVE_AVX
+   - SFIZZ_HAVE_AVX2
    - SFIZZ_HAVE_NEON
  */
 
@@ -61,6 +62,12 @@
 // TODO: how to check for NEON on MSVC ARM?
 #endif
 
+#if defined(__AVX2__)
+#   define SFIZZ_DETECT_AVX2 1
+#else
+#   define SFIZZ_DETECT_AVX2 0
+#endif
+
 #ifndef SFIZZ_HAVE_SSE
 #   ifdef SFIZZ_DETECT_SSE
 #       define SFIZZ_HAVE_SSE SFIZZ_DETECT_SSE
@@ -82,6 +89,13 @@
 #       define SFIZZ_HAVE_AVX 0
 #   endif
 #endif
+#ifndef SFIZZ_HAVE_AVX2
+#   ifdef SFIZZ_DETECT_AVX2
+#       define SFIZZ_HAVE_AVX2 SFIZZ_DETECT_AVX2
+#   else
+#       define SFIZZ_HAVE_AVX2 0
+#   endif
+#endif
 #ifndef SFIZZ_HAVE_NEON
 #   ifdef SFIZZ_DETECT_NEON
 #       define SFIZZ_HAVE_NEON SFIZZ_DETECT_NEON
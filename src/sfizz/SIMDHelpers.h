@@ -64,12 +64,27 @@ enum class SIMDOps {
     upsampling,
     clampAll,
     allWithin,
+    exp2,
+    pan,
+    width,
+    _sentinel //
+};
+
+// Instruction sets of the SIMD accelerators
+enum class SIMDInstructionSet {
+    SSE,
+    AVX,
+    AVX2,
+    NEON,
     _sentinel //
 };
 
 // Call this at least once before using SIMD operations
 void initializeSIMDDispatchers();
 
+// Check whether the processor supports an instruction set
+bool hasSIMDInstructionSet(SIMDInstructionSet set);
+
 // Enable or disable SIMD accelerators at runtime
 template<class T>
 void resetSIMDOpStatus();
@@ -90,6 +105,20 @@ void setSIMDOpStatus<float>(SIMDOps op, bool status);
 template<>
 bool getSIMDOpStatus<float>(SIMDOps op);
 
+// Enable or disable an instruction set at runtime, for all the SIMD accelerators.
+// The ones supported by the processor are enabled by default, and the widest is used.
+template<class T>
+void setSIMDInstructionSetStatus(SIMDInstructionSet set, bool status);
+
+template<class T>
+bool getSIMDInstructionSetStatus(SIMDInstructionSet set);
+
+template<>
+void setSIMDInstructionSetStatus<float>(SIMDInstructionSet set, bool status);
+
+template<>
+bool getSIMDInstructionSetStatus<float>(SIMDInstructionSet set);
+
 /**
  * @brief Read interleaved stereo data from a buffer and separate it in a left/right pair of buffers.
  *
@@ -753,4 +782,30 @@ bool allWithin(absl::Span<const T> input, T low, T high) noexcept
     return allWithin<T>(input.data(), low, high, input.size());
 }
 
+/**
+ * @brief Computes the powers of 2 of a span.
+ * The SIMD versions approximate them with a relative error under 3e-7,
+ * for exponents within [-126, 126] where they are clamped.
+ *
+ * @tparam T the underlying type
+ * @param input
+ * @param output
+ * @param size
+ */
+template <class T>
+void exp2(const T* input, T* output, unsigned size) noexcept
+{
+    exp2Scalar(input, output, size);
+}
+
+template <>
+void exp2<float>(const float* input, float* output, unsigned size) noexcept;
+
+template <class T>
+void exp2(absl::Span<const T> input, absl::Span<T> output) noexcept
+{
+    CHECK_SPAN_SIZES(input, output);
+    exp2<T>(input.data(), output.data(), minSpanSize(input, output));
+}
+
 } // namespace sfz
@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "SampleCache.h"
+#include "utility/StringViewHelpers.h"
+#include "utility/Debug.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sfz {
+
+namespace {
+
+constexpr char cacheMagic[4] { 'S', 'F', 'Z', 'C' };
+constexpr uint32_t cacheVersion { 2 };
+constexpr uint32_t cacheByteOrder { 0x01020304 };
+constexpr size_t cacheDataAlignment { 64 };
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t keySize;
+    uint64_t dataOffset;
+    int64_t end;
+    int64_t loopStart;
+    int64_t loopEnd;
+    double sampleRate;
+    int32_t numChannels;
+    int32_t rootKey;
+    uint32_t numFrames;
+    uint32_t wavetableTableSize;
+    int32_t wavetableCrossTableInterpolation;
+    uint8_t hasLoop;
+    uint8_t hasWavetable;
+    uint8_t wavetableOneShot;
+    uint8_t reserved;
+};
+
+static_assert(std::is_trivially_copyable<CacheHeader>::value, "The cache header must be trivially copyable");
+
+size_t alignDataOffset(size_t offset)
+{
+    return (offset + cacheDataAlignment - 1) / cacheDataAlignment * cacheDataAlignment;
+}
+
+/**
+ * @brief Get the number of floats between the channels, which are padded
+ * on both sides and kept aligned.
+ */
+size_t getChannelStride(uint32_t numFrames)
+{
+    const size_t paddedFrames = numFrames + 2 * static_cast<size_t>(config::excessFileFrames);
+    return alignDataOffset(paddedFrames * sizeof(float)) / sizeof(float);
+}
+
+} // namespace
+
+absl::Span<const float> SampleCache::Entry::getChannel(unsigned channel) const noexcept
+{
+    const auto* frames = reinterpret_cast<const float*>(mapping->data() + dataOffset);
+    return { frames + channel * getChannelStride(numFrames) + config::excessFileFrames, numFrames };
+}
+
+AudioSpan<const float> SampleCache::Entry::getFrames(uint32_t numFrames) const noexcept
+{
+    ASSERT(numFrames <= this->numFrames);
+    std::array<const float*, config::numChannels> channels {};
+    for (unsigned c = 0, n = static_cast<unsigned>(information.numChannels); c < n; ++c)
+        channels[c] = getChannel(c).data();
+    return { channels, static_cast<size_t>(information.numChannels), 0, numFrames };
+}
+
+bool SampleCache::makeKey(const fs::path& file, bool reverse, std::string& key) const noexcept
+{
+    std::error_code ec;
+    const fs::path path = fs::absolute(file, ec);
+    if (ec)
+        return false;
+
+    const auto size = fs::file_size(path, ec);
+    if (ec)
+        return false;
+
+    const auto time = fs::last_write_time(path, ec);
+    if (ec)
+        return false;
+
+    key = path.u8string();
+    key += '\n';
+    key += std::to_string(size);
+    key += '\n';
+    key += std::to_string(static_cast<long long>(time.time_since_epoch().count()));
+    key += reverse ? "\nreverse" : "\nforward";
+    return true;
+}
+
+fs::path SampleCache::getEntryPath(const std::string& key) const
+{
+    uint64_t h = Fnv1aBasis;
+    for (char c : key)
+        h = hashByte(static_cast<uint8_t>(c), h);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.sfzc", static_cast<unsigned long long>(h));
+    return directory_ / name;
+}
+
+bool SampleCache::lookup(const fs::path& file, bool reverse, Entry& entry) const noexcept
+{
+    if (!isEnabled())
+        return false;
+
+    std::string key;
+    if (!makeKey(file, reverse, key))
+        return false;
+
+    std::error_code ec;
+    std::shared_ptr<MappedFile> mapping { new MappedFile };
+    if (!mapping->open(getEntryPath(key), ec))
+        return false;
+
+    CacheHeader header;
+    if (mapping->size() < sizeof(header))
+        return false;
+
+    std::memcpy(&header, mapping->data(), sizeof(header));
+    if (std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0
+        || header.version != cacheVersion || header.byteOrder != cacheByteOrder)
+        return false;
+
+    if (header.numChannels != 1 && header.numChannels != 2)
+        return false;
+
+    const uint64_t dataSize = uint64_t(getChannelStride(header.numFrames)) * header.numChannels * sizeof(float);
+    if (header.dataOffset < sizeof(header) + header.keySize
+        || header.dataOffset % cacheDataAlignment != 0
+        || header.dataOffset + dataSize > mapping->size())
+        return false;
+
+    // entries whose key hash collides are overwritten
+    const char* storedKey = reinterpret_cast<const char*>(mapping->data() + sizeof(header));
+    if (header.keySize != key.size() || std::memcmp(storedKey, key.data(), key.size()) != 0)
+        return false;
+
+    FileInformation& information = entry.information;
+    information = FileInformation {};
+    information.end = header.end;
+    information.loopStart = header.loopStart;
+    information.loopEnd = header.loopEnd;
+    information.hasLoop = header.hasLoop != 0;
+    information.sampleRate = header.sampleRate;
+    information.numChannels = header.numChannels;
+    information.rootKey = header.rootKey;
+    if (header.hasWavetable) {
+        WavetableInfo wt;
+        wt.tableSize = header.wavetableTableSize;
+        wt.crossTableInterpolation = header.wavetableCrossTableInterpolation;
+        wt.oneShot = header.wavetableOneShot != 0;
+        information.wavetable = wt;
+    }
+
+    entry.numFrames = header.numFrames;
+    entry.dataOffset = static_cast<size_t>(header.dataOffset);
+    entry.mapping = std::move(mapping);
+    return true;
+}
+
+bool SampleCache::store(const fs::path& file, bool reverse, const FileInformation& information,
+    const FileAudioBuffer& data, uint32_t numFrames) const noexcept
+{
+    if (!isEnabled())
+        return false;
+
+    const size_t numChannels = data.getNumChannels();
+    if (numChannels != 1 && numChannels != 2)
+        return false;
+
+    numFrames = std::min(numFrames, static_cast<uint32_t>(data.getNumFrames()));
+
+    std::string key;
+    if (!makeKey(file, reverse, key))
+        return false;
+
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+
+    CacheHeader header {};
+    std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    header.version = cacheVersion;
+    header.byteOrder = cacheByteOrder;
+    header.keySize = static_cast<uint32_t>(key.size());
+    header.dataOffset = alignDataOffset(sizeof(header) + key.size());
+    header.end = information.end;
+    header.loopStart = information.loopStart;
+    header.loopEnd = information.loopEnd;
+    header.sampleRate = information.sampleRate;
+    header.numChannels = static_cast<int32_t>(numChannels);
+    header.rootKey = information.rootKey;
+    header.numFrames = numFrames;
+    header.hasLoop = information.hasLoop;
+    if (information.wavetable) {
+        header.hasWavetable = 1;
+        header.wavetableTableSize = information.wavetable->tableSize;
+        header.wavetableCrossTableInterpolation = information.wavetable->crossTableInterpolation;
+        header.wavetableOneShot = information.wavetable->oneShot;
+    }
+
+    // write to a temporary file first, so that a reader never maps a partial entry
+    const fs::path entryPath = getEntryPath(key);
+    fs::path tempPath = entryPath;
+    tempPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+    {
+        std::ofstream stream(tempPath.string(), std::ios::binary | std::ios::trunc);
+        if (!stream)
+            return false;
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(key.data(), static_cast<std::streamsize>(key.size()));
+        const size_t padding = header.dataOffset - sizeof(header) - key.size();
+        const char zeros[cacheDataAlignment] {};
+        stream.write(zeros, static_cast<std::streamsize>(padding));
+
+        // the padding is zero, as in the decoded buffers
+        const size_t stride = getChannelStride(numFrames);
+        std::vector<float> channelData(stride, 0.0f);
+        for (size_t c = 0; c < numChannels; ++c) {
+            absl::Span<const float> channel = data.getConstSpan(c).first(numFrames);
+            std::copy(channel.begin(), channel.end(), channelData.begin() + config::excessFileFrames);
+            stream.write(reinterpret_cast<const char*>(channelData.data()),
+                static_cast<std::streamsize>(stride * sizeof(float)));
+        }
+
+        if (!stream) {
+            stream.close();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, entryPath, ec);
+    if (ec) {
+        DBG("[sfizz] Could not store the cache entry for " << file << ": " << ec.message());
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace sfz
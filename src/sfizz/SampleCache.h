@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "FilePool.h"
+#include "MappedFile.h"
+#include <absl/types/span.h>
+#include <ghc/fs_std.hpp>
+#include <memory>
+#include <string>
+
+namespace sfz {
+
+/**
+ * @brief A persistent cache of the information and the preloaded frames of
+ * sample files, stored in a directory.
+ *
+ * Each sample file has one cache file, named after a hash of its absolute
+ * path, its size, its modification time and its reading direction; a sample
+ * which changes on disk is thus never served from an outdated entry.
+ * A cache file holds a fixed header, the key it was written for, and the
+ * frames as planar float32 channels, aligned and padded like the buffers of
+ * the file pool so that the voices read them from a memory mapping of the
+ * file directly. Only the preloaded heads of the samples are stored.
+ *
+ * Lookups and stores may run concurrently from several threads.
+ */
+class SampleCache {
+public:
+    /**
+     * @brief A cache entry, mapped in memory.
+     */
+    struct Entry {
+        FileInformation information;
+        uint32_t numFrames { 0 };
+        /**
+         * @brief Get the frames of a channel, which are padded with
+         * `config::excessFileFrames` readable frames on both sides.
+         */
+        absl::Span<const float> getChannel(unsigned channel) const noexcept;
+        /**
+         * @brief Get the first frames of all the channels.
+         */
+        AudioSpan<const float> getFrames(uint32_t numFrames) const noexcept;
+
+        std::shared_ptr<const MappedFile> mapping;
+        size_t dataOffset { 0 };
+    };
+
+    /**
+     * @brief Set the directory of the cache. An empty path disables it.
+     *
+     * @param directory
+     */
+    void setDirectory(const fs::path& directory) noexcept { directory_ = directory; }
+
+    /**
+     * @brief Get the directory of the cache, empty if it is disabled.
+     */
+    const fs::path& getDirectory() const noexcept { return directory_; }
+
+    /**
+     * @brief Check whether the cache is enabled.
+     */
+    bool isEnabled() const noexcept { return !directory_.empty(); }
+
+    /**
+     * @brief Look up the entry of a sample file.
+     *
+     * @param file the sample file
+     * @param reverse whether the sample is read backwards
+     * @param entry the entry, if found
+     * @return true if a valid entry was found
+     */
+    bool lookup(const fs::path& file, bool reverse, Entry& entry) const noexcept;
+
+    /**
+     * @brief Store the entry of a sample file, replacing the previous one.
+     *
+     * @param file the sample file
+     * @param reverse whether the sample is read backwards
+     * @param information the information about the sample
+     * @param data the frames read from the beginning of the sample
+     * @param numFrames the number of frames of the data to store
+     * @return true if the entry was written
+     */
+    bool store(const fs::path& file, bool reverse, const FileInformation& information,
+        const FileAudioBuffer& data, uint32_t numFrames) const noexcept;
+
+private:
+    bool makeKey(const fs::path& file, bool reverse, std::string& key) const noexcept;
+    fs::path getEntryPath(const std::string& key) const;
+
+    fs::path directory_;
+};
+
+} // namespace sfz
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "SampleStore.h"
+#include "utility/SwapAndPop.h"
+
+namespace sfz {
+
+static std::weak_ptr<SampleStore> sharedSampleStoreWeakPtr;
+static std::mutex sharedSampleStoreMutex;
+
+std::shared_ptr<SampleStore> SampleStore::getShared()
+{
+    std::lock_guard<std::mutex> lock(sharedSampleStoreMutex);
+    std::shared_ptr<SampleStore> store = sharedSampleStoreWeakPtr.lock();
+    if (!store) {
+        store.reset(new SampleStore);
+        sharedSampleStoreWeakPtr = store;
+    }
+    return store;
+}
+
+SampleStore::FileKey SampleStore::makeKey(const fs::path& file, bool reverse)
+{
+    std::error_code ec;
+    fs::path path = fs::absolute(file, ec);
+    if (ec)
+        path = file;
+
+    FileKey key;
+    key.path = path.lexically_normal().u8string();
+    key.reverse = reverse;
+
+    // a file which changes on disk gets new entries
+    const auto size = fs::file_size(path, ec);
+    if (!ec)
+        key.size = static_cast<uint64_t>(size);
+    const auto time = fs::last_write_time(path, ec);
+    if (!ec)
+        key.modificationTime = static_cast<int64_t>(time.time_since_epoch().count());
+
+    return key;
+}
+
+void SampleStore::removeExpired(std::vector<Variant>& variants) noexcept
+{
+    swapAndPopAll(variants, [](const Variant& variant) {
+        return variant.data.expired();
+    });
+}
+
+std::shared_ptr<FileData> SampleStore::find(const FileKey& key, size_t numFrames, bool mapped)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        for (const Variant& variant : it->second) {
+            if (variant.numFrames != numFrames || variant.mapped != mapped)
+                continue;
+
+            if (std::shared_ptr<FileData> data = variant.data.lock()) {
+                numHits_ += 1;
+                return data;
+            }
+        }
+    }
+
+    numMisses_ += 1;
+    return {};
+}
+
+absl::optional<FileInformation> SampleStore::findInformation(const FileKey& key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+        return {};
+
+    for (const Variant& variant : it->second) {
+        if (std::shared_ptr<FileData> data = variant.data.lock())
+            return data->information;
+    }
+
+    return {};
+}
+
+std::shared_ptr<FileData> SampleStore::insert(const FileKey& key, bool mapped, std::shared_ptr<FileData> data)
+{
+    const size_t numFrames = data->getNumPreloadedFrames();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<Variant>& variants = entries_[key];
+    removeExpired(variants);
+
+    for (const Variant& variant : variants) {
+        if (variant.numFrames != numFrames || variant.mapped != mapped)
+            continue;
+
+        if (std::shared_ptr<FileData> existing = variant.data.lock())
+            return existing;
+    }
+
+    Variant variant;
+    variant.numFrames = numFrames;
+    variant.mapped = mapped;
+    variant.data = data;
+    variants.push_back(std::move(variant));
+    return data;
+}
+
+SampleStore::Stats SampleStore::getStats()
+{
+    Stats stats;
+    stats.numUsers = numUsers_;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.numHits = numHits_;
+    stats.numMisses = numMisses_;
+
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        std::vector<Variant>& variants = it->second;
+        removeExpired(variants);
+        if (variants.empty()) {
+            entries_.erase(it++);
+            continue;
+        }
+
+        for (const Variant& variant : variants) {
+            std::shared_ptr<FileData> data = variant.data.lock();
+            if (!data)
+                continue;
+
+            const size_t frameBytes = static_cast<size_t>(data->information.numChannels) * sizeof(float);
+            const size_t preloadedBytes = data->getNumPreloadedFrames() * frameBytes;
+            const size_t loadedBytes = data->availableFrames * frameBytes;
+            // the reference taken above is not a user
+            const auto numUsers = static_cast<size_t>(data.use_count() - 1);
+
+            stats.numSamples += 1;
+            stats.preloadedBytes += preloadedBytes;
+            stats.loadedBytes += loadedBytes;
+            if (numUsers > 1) {
+                stats.numSharedSamples += 1;
+                stats.savedBytes += (numUsers - 1) * (preloadedBytes + loadedBytes);
+            }
+        }
+
+        ++it;
+    }
+
+    return stats;
+}
+
+} // namespace sfz
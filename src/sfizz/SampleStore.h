@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "FilePool.h"
+#include "utility/LeakDetector.h"
+#include <absl/container/flat_hash_map.h>
+#include <absl/types/optional.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sfz {
+
+/**
+ * @brief The sample data which is shared between all the file pools of the
+ * process, so that the synths which play the same samples decode and hold
+ * them only once.
+ *
+ * An entry is identified by the absolute path of its file, the size and the
+ * modification time of the file, its reading direction, its number of
+ * preloaded frames and whether it is memory-mapped.
+ * The file pools hold the entries they use, and an entry is freed when the
+ * last of them releases it. The preloaded frames of an entry never change
+ * once it is stored; a file pool which needs different ones acquires another
+ * entry instead. The frames loaded in the background are shared as well.
+ *
+ * All the methods may be called concurrently.
+ */
+class SampleStore {
+public:
+    /**
+     * @brief Identifies a sample file, whatever its preloaded frames.
+     */
+    struct FileKey {
+        std::string path;
+        uint64_t size { 0 };
+        int64_t modificationTime { 0 };
+        bool reverse { false };
+
+        bool operator==(const FileKey& other) const noexcept
+        {
+            return reverse == other.reverse && size == other.size
+                && modificationTime == other.modificationTime && path == other.path;
+        }
+
+        template <class H>
+        friend H AbslHashValue(H h, const FileKey& key)
+        {
+            return H::combine(std::move(h), key.path, key.size, key.modificationTime, key.reverse);
+        }
+    };
+
+    /**
+     * @brief Statistics about the store.
+     */
+    struct Stats {
+        /**
+         * @brief Number of file pools using the store
+         */
+        size_t numUsers { 0 };
+        /**
+         * @brief Number of entries which are alive
+         */
+        size_t numSamples { 0 };
+        /**
+         * @brief Number of entries used by more than one file pool
+         */
+        size_t numSharedSamples { 0 };
+        /**
+         * @brief Bytes of preloaded frames held by the entries
+         */
+        size_t preloadedBytes { 0 };
+        /**
+         * @brief Bytes of frames loaded in the background for the entries
+         */
+        size_t loadedBytes { 0 };
+        /**
+         * @brief Bytes which the file pools would hold in addition if they
+         * did not share the entries
+         */
+        size_t savedBytes { 0 };
+        /**
+         * @brief Number of entries requested and found in the store
+         */
+        uint64_t numHits { 0 };
+        /**
+         * @brief Number of entries requested and not found in the store
+         */
+        uint64_t numMisses { 0 };
+    };
+
+    /**
+     * @brief Get the store of the process, creating it if needed.
+     */
+    static std::shared_ptr<SampleStore> getShared();
+
+    /**
+     * @brief Make the key of a sample file.
+     *
+     * @param file the path of the file
+     * @param reverse whether the file is read backwards
+     */
+    static FileKey makeKey(const fs::path& file, bool reverse);
+
+    /**
+     * @brief Find an entry.
+     *
+     * @param key the sample file
+     * @param numFrames the number of preloaded frames
+     * @param mapped whether the entry is memory-mapped
+     * @return the entry, or null if there is none alive
+     */
+    std::shared_ptr<FileData> find(const FileKey& key, size_t numFrames, bool mapped);
+
+    /**
+     * @brief Find the information about a sample file, from any of its
+     * entries which is alive.
+     *
+     * @param key the sample file
+     */
+    absl::optional<FileInformation> findInformation(const FileKey& key);
+
+    /**
+     * @brief Store an entry. If an equivalent entry was stored meanwhile,
+     * that one is returned instead, and the new one is discarded.
+     *
+     * @param key the sample file
+     * @param mapped whether the entry is memory-mapped
+     * @param data the entry, whose preloaded frames must not change anymore
+     * @return the entry to use
+     */
+    std::shared_ptr<FileData> insert(const FileKey& key, bool mapped, std::shared_ptr<FileData> data);
+
+    /**
+     * @brief Register a file pool using the store.
+     */
+    void addUser() noexcept { numUsers_ += 1; }
+
+    /**
+     * @brief Unregister a file pool using the store.
+     */
+    void removeUser() noexcept { numUsers_ -= 1; }
+
+    /**
+     * @brief Get statistics about the store.
+     */
+    Stats getStats();
+
+private:
+    struct Variant {
+        size_t numFrames { 0 };
+        bool mapped { false };
+        std::weak_ptr<FileData> data;
+    };
+
+    void removeExpired(std::vector<Variant>& variants) noexcept;
+
+    std::mutex mutex_;
+    absl::flat_hash_map<FileKey, std::vector<Variant>> entries_;
+    std::atomic<size_t> numUsers_ { 0 };
+    uint64_t numHits_ { 0 };
+    uint64_t numMisses_ { 0 };
+
+    LEAK_DETECTOR(SampleStore);
+};
+
+} // namespace sfz
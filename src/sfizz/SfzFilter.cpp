@@ -10,6 +10,7 @@
 #include "SIMDHelpers.h"
 #include "utility/StringViewHelpers.h"
 #include "utility/Debug.h"
+#include <algorithm>
 #include <cstring>
 
 namespace sfz {
@@ -21,6 +22,7 @@ struct Filter::Impl {
     double fSampleRate = sfz::config::defaultSampleRate;
     FilterType fType = kFilterNone;
     unsigned fChannels = 1;
+    unsigned fControlInterval = config::filterControlInterval;
     enum { maxChannels = 2 };
 
     union U {
@@ -123,12 +125,20 @@ void Filter::processModulated(const float *const in[], float *const out[], const
         return;
     }
 
+    const unsigned interval = P->fControlInterval;
     unsigned frame = 0;
     while (frame < nframes) {
-        unsigned current = nframes - frame;
-
-        if (current > config::filterControlInterval)
-            current = config::filterControlInterval;
+        unsigned current = std::min(nframes - frame, interval);
+
+        // extend over the next intervals as long as the values do not change
+        const float currentCutoff = cutoff[frame];
+        const float currentQ = q[frame];
+        const float currentPksh = pksh[frame];
+        while (frame + current < nframes
+            && cutoff[frame + current] == currentCutoff
+            && q[frame + current] == currentQ
+            && pksh[frame + current] == currentPksh)
+            current += std::min(nframes - frame - current, interval);
 
         const float *current_in[Impl::maxChannels];
         float *current_out[Impl::maxChannels];
@@ -138,7 +148,7 @@ void Filter::processModulated(const float *const in[], float *const out[], const
             current_out[c] = out[c] + frame;
         }
 
-        dsp->configureStandard(cutoff[frame], q[frame], pksh[frame]);
+        dsp->configureStandard(currentCutoff, currentQ, currentPksh);
         dsp->compute(current, const_cast<float **>(current_in), const_cast<float **>(current_out));
 
         frame += current;
@@ -166,6 +176,17 @@ void Filter::setChannels(unsigned channels)
     }
 }
 
+unsigned Filter::controlInterval() const
+{
+    return P->fControlInterval;
+}
+
+void Filter::setControlInterval(unsigned interval)
+{
+    ASSERT(interval > 0);
+    P->fControlInterval = std::max(1u, interval);
+}
+
 FilterType Filter::type() const
 {
     return P->fType;
@@ -219,6 +240,7 @@ struct FilterEq::Impl {
     double fSampleRate = sfz::config::defaultSampleRate;
     EqType fType = kEqNone;
     unsigned fChannels = 1;
+    unsigned fControlInterval = config::filterControlInterval;
     enum { maxChannels = 2 };
 
     union U {
@@ -321,12 +343,20 @@ void FilterEq::processModulated(const float *const in[], float *const out[], con
         return;
     }
 
+    const unsigned interval = P->fControlInterval;
     unsigned frame = 0;
     while (frame < nframes) {
-        unsigned current = nframes - frame;
-
-        if (current > config::filterControlInterval)
-            current = config::filterControlInterval;
+        unsigned current = std::min(nframes - frame, interval);
+
+        // extend over the next intervals as long as the values do not change
+        const float currentCutoff = cutoff[frame];
+        const float currentBw = bw[frame];
+        const float currentPksh = pksh[frame];
+        while (frame + current < nframes
+            && cutoff[frame + current] == currentCutoff
+            && bw[frame + current] == currentBw
+            && pksh[frame + current] == currentPksh)
+            current += std::min(nframes - frame - current, interval);
 
         const float *current_in[Impl::maxChannels];
         float *current_out[Impl::maxChannels];
@@ -336,7 +366,7 @@ void FilterEq::processModulated(const float *const in[], float *const out[], con
             current_out[c] = out[c] + frame;
         }
 
-        dsp->configureEq(cutoff[frame], bw[frame], pksh[frame]);
+        dsp->configureEq(currentCutoff, currentBw, currentPksh);
         dsp->compute(current, const_cast<float **>(current_in), const_cast<float **>(current_out));
 
         frame += current;
@@ -365,6 +395,17 @@ void FilterEq::setChannels(unsigned channels)
     }
 }
 
+unsigned FilterEq::controlInterval() const
+{
+    return P->fControlInterval;
+}
+
+void FilterEq::setControlInterval(unsigned interval)
+{
+    ASSERT(interval > 0);
+    P->fControlInterval = std::max(1u, interval);
+}
+
 EqType FilterEq::type() const
 {
     return P->fType;
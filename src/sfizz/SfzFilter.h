@@ -60,6 +60,8 @@ public:
        `cutoff` is a frequency expressed in Hz.
        `q` is a resonance expressed in dB.
        `pksh` is a peak/shelf gain expressed in dB.
+       The coefficients are recomputed every `controlInterval()` frames, and
+       the following intervals with identical values are run at once.
        `in[i]` and `out[i]` may refer to identical buffers, for in-place processing
      */
     void processModulated(const float *const in[], float *const out[], const float *cutoff, const float *q, const float *pksh, unsigned nframes);
@@ -74,6 +76,18 @@ public:
      */
     void setChannels(unsigned channels);
 
+    /**
+       Get the interval in frames between recomputations of the modulated
+       coefficients.
+     */
+    unsigned controlInterval() const;
+
+    /**
+       Set the interval in frames between recomputations of the modulated
+       coefficients, at least 1. It defaults to `config::filterControlInterval`.
+     */
+    void setControlInterval(unsigned interval);
+
     /**
        Get the type of filter.
      */
@@ -165,6 +179,8 @@ public:
        `cutoff` is a frequency expressed in Hz.
        `bw` is a bandwidth expressed in octaves.
        `pksh` is a peak/shelf gain expressed in dB.
+       The coefficients are recomputed every `controlInterval()` frames, and
+       the following intervals with identical values are run at once.
        `in[i]` and `out[i]` may refer to identical buffers, for in-place processing
      */
     void processModulated(const float *const in[], float *const out[], const float *cutoff, const float *bw, const float *pksh, unsigned nframes);
@@ -179,6 +195,18 @@ public:
      */
     void setChannels(unsigned channels);
 
+    /**
+       Get the interval in frames between recomputations of the modulated
+       coefficients.
+     */
+    unsigned controlInterval() const;
+
+    /**
+       Set the interval in frames between recomputations of the modulated
+       coefficients, at least 1. It defaults to `config::filterControlInterval`.
+     */
+    void setControlInterval(unsigned interval);
+
     /**
        Get the type of filter.
      */
@@ -36,7 +36,9 @@
 #include <absl/types/span.h>
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <utility>
 
@@ -212,6 +214,8 @@ void Synth::Impl::buildRegion(const std::vector<Opcode>& regionOpcodes)
         voiceManager_.ensureNumPolyphonyGroups(lastRegion->group);
     }
 
+    voiceManager_.ensureEventIndexes(*lastRegion);
+
     if (currentSet_ != nullptr) {
         lastRegion->parent = currentSet_;
         currentSet_->addRegion(lastRegion);
@@ -246,6 +250,8 @@ void Synth::Impl::clear()
         list.clear();
     for (auto& list : noteActivationLists_)
         list.clear();
+    for (auto& index : noteActivationIndexes_)
+        index.clear();
     for (auto& list : ccActivationLists_)
         list.clear();
     previousKeyswitchLists_.clear();
@@ -254,11 +260,13 @@ void Synth::Impl::clear()
     sets_.clear();
     layers_.clear();
     effectBuses_.clear();
+    filterSubmixes_.clear();
     effectBuses_.emplace_back(new EffectBus);
     effectBuses_[0]->setGainToMain(1.0);
     effectBuses_[0]->setSamplesPerBlock(samplesPerBlock_);
     effectBuses_[0]->setSampleRate(sampleRate_);
     effectBuses_[0]->clearInputs(samplesPerBlock_);
+    setupRenderWorkers();
     resources_.clear();
     rootPath_.clear();
     numGroups_ = 0;
@@ -440,14 +448,18 @@ void Synth::Impl::handleControlOpcodes(const std::vector<Opcode>& members)
             break;
         case hash("hint_min_samplerate"):
 	    {
-		if (float(stoi(member.value)) / sampleRate_ > 1.0f)
+		const float ratio = float(stoi(member.value)) / sampleRate_;
+		if (ratio > 1.0f)
 			overSampled = true;
-		resources_.getSynthConfig().OSFactor = int(std::min(128.0f, std::max(1.0f, float(stoi(member.value)) / sampleRate_)));
+		// the voices are decimated by halves, so round up to a power of two
+		const auto factor = nextPow2(static_cast<uint32_t>(std::ceil(std::max(1.0f, ratio))));
+		resources_.getSynthConfig().OSFactor = static_cast<int>(std::min(static_cast<uint32_t>(config::maxOversampling), factor));
     		for (auto& voice : voiceManager_) {
         		voice.setSampleRate(sampleRate_);
         		voice.setSamplesPerBlock(samplesPerBlock_);
     		}
 	    }
+            break;
         case hash("hint_sustain_cancels_release"):
         {
             SynthConfig& config = resources_.getSynthConfig();
@@ -588,6 +600,20 @@ bool Synth::loadSfzString(const fs::path& path, absl::string_view text)
     return true;
 }
 
+/**
+ * @brief Get the maximum offset at which a region can start in its sample.
+ */
+static uint32_t regionMaxOffset(const Region& region)
+{
+    // TODO: adjust with LFO targets
+    uint64_t sumOffsetCC = region.offset + region.offsetRandom;
+    for (const auto& offsets : region.offsetCC)
+        sumOffsetCC += offsets.data;
+    const int64_t maxOffset = Default::offsetMod.bounds.clamp(sumOffsetCC);
+    // the file pool counts the offsets in 32 bits
+    return static_cast<uint32_t>(clamp<int64_t>(maxOffset, 0, std::numeric_limits<uint32_t>::max()));
+}
+
 void Synth::Impl::finalizeSfzLoad()
 {
     const fs::path& rootDirectory = parser_.originalDirectory();
@@ -600,7 +626,7 @@ void Synth::Impl::finalizeSfzLoad()
     size_t currentRegionIndex = 0;
     size_t currentRegionCount = layers_.size();
 
-    absl::flat_hash_map<sfz::FileId, int64_t> filesToLoad;
+    absl::flat_hash_map<sfz::FileId, uint32_t> filesToLoad;
 
     auto removeCurrentRegion = [this, &currentRegionIndex, &currentRegionCount]() {
         const Region& region = layers_[currentRegionIndex]->getRegion();
@@ -621,6 +647,40 @@ void Synth::Impl::finalizeSfzLoad()
 
     FlexEGs::clearUnusedCurves();
 
+    // Probe all the sample files at once, so that their information and
+    // preloaded data are read concurrently rather than region by region
+    {
+        absl::flat_hash_map<sfz::FileId, uint32_t> filesToProbe;
+        for (const LayerPtr& layerPtr : layers_) {
+            const Region& region = layerPtr->getRegion();
+            if (region.isGenerator())
+                continue;
+
+            auto& toProbe = filesToProbe[*region.sampleId];
+            if (!region.isOscillator())
+                toProbe = max(toProbe, regionMaxOffset(region));
+        }
+
+        std::vector<std::pair<FileId, uint32_t>> files;
+        files.reserve(filesToProbe.size());
+        for (const auto& toProbe : filesToProbe) {
+            FileId fileId = toProbe.first;
+            if (filePool.checkSampleId(fileId))
+                files.emplace_back(std::move(fileId), toProbe.second);
+        }
+        filePool.preloadFiles(files);
+
+        // The short samples are checked for silence and may serve as
+        // wavetables, so they are loaded whole, also concurrently
+        std::vector<FileId> shortFiles;
+        for (const auto& file : files) {
+            const auto fileInformation = filePool.getFileInformation(file.first);
+            if (fileInformation && fileInformation->end < config::wavetableMaxFrames)
+                shortFiles.push_back(file.first);
+        }
+        filePool.loadFiles(shortFiles);
+    }
+
     while (currentRegionIndex < currentRegionCount) {
         Layer& layer = *layers_[currentRegionIndex];
         Region& region = layer.getRegion();
@@ -649,7 +709,7 @@ void Synth::Impl::finalizeSfzLoad()
                 bool allZeros = true;
                 int numChannels = sample->information.numChannels;
                 for (int i = 0; i < numChannels; ++i) {
-                    allZeros &= allWithin(sample->preloadedData.getConstSpan(i),
+                    allZeros &= allWithin(sample->getPreloadedData().getConstSpan(i),
                         -config::virtuallyZero, config::virtuallyZero);
                 }
 
@@ -692,14 +752,7 @@ void Synth::Impl::finalizeSfzLoad()
             if (region.pitchKeycenterFromSample)
                 region.pitchKeycenter = fileInformation->rootKey;
 
-            // TODO: adjust with LFO targets
-            const auto maxOffset = [region]() {
-                uint64_t sumOffsetCC = region.offset + region.offsetRandom;
-                for (const auto& offsets : region.offsetCC)
-                    sumOffsetCC += offsets.data;
-                return Default::offsetMod.bounds.clamp(sumOffsetCC);
-            }();
-
+            const auto maxOffset = regionMaxOffset(region);
             auto& toLoad = filesToLoad[*region.sampleId];
             toLoad = max(toLoad, maxOffset);
         }
@@ -767,6 +820,29 @@ void Synth::Impl::finalizeSfzLoad()
             region.velCurve = Curve::buildFromVelcurvePoints(
                 region.velocityPoints, Curve::Interpolator::Linear);
 
+        // Only keep the sends which feed an existing bus
+        region.effectSends.clear();
+        for (unsigned i = 0, n = static_cast<unsigned>(region.gainToEffect.size()); i < n; ++i) {
+            const float gain = region.gainToEffect[i];
+            if (gain != 0.0f && i < effectBuses_.size() && effectBuses_[i])
+                region.effectSends.push_back({ i, gain });
+        }
+
+        // Share the filter stage with the regions having the same filters
+        region.filterSubmix = absl::nullopt;
+        if (FilterSubmix::canShareFilterStage(region)) {
+            auto it = absl::c_find_if(filterSubmixes_, [&region](const FilterSubmixPtr& submix) {
+                return submix->matches(region);
+            });
+            if (it == filterSubmixes_.end()) {
+                filterSubmixes_.emplace_back(new FilterSubmix(region));
+                filterSubmixes_.back()->setSamplesPerBlock(samplesPerBlock_);
+                filterSubmixes_.back()->setSampleRate(sampleRate_);
+                it = filterSubmixes_.end() - 1;
+            }
+            region.filterSubmix = static_cast<unsigned>(it - filterSubmixes_.begin());
+        }
+
         layer.registerPitchWheel(0);
         layer.registerAftertouch(0);
         layer.registerTempo(2.0f);
@@ -783,9 +859,7 @@ void Synth::Impl::finalizeSfzLoad()
         ++currentRegionIndex;
     }
 
-    for (const auto& toLoad: filesToLoad) {
-        filePool.preloadFile(toLoad.first, toLoad.second);
-    }
+    filePool.preloadFiles({ filesToLoad.begin(), filesToLoad.end() });
 
     if (currentRegionCount < layers_.size()) {
         DBG("Removing " << (layers_.size() - currentRegionCount)
@@ -793,6 +867,14 @@ void Synth::Impl::finalizeSfzLoad()
     }
     layers_.resize(currentRegionCount);
 
+    size_t maxLayersPerNote = 0;
+    for (int note = 0; note < 128; ++note) {
+        const LayerViewVector& layers = noteActivationLists_[note];
+        noteActivationIndexes_[note].build(layers);
+        maxLayersPerNote = max(maxLayersPerNote, layers.size());
+    }
+    noteOnCandidates_.reserve(maxLayersPerNote);
+
     // collect all CCs used in regions, with matrix not yet connected
     BitArray<config::numCCs> usedCCs;
     for (const LayerPtr& layerPtr : layers_) {
@@ -839,6 +921,7 @@ void Synth::Impl::finalizeSfzLoad()
     applySettingsPerVoice();
 
     setupModMatrix();
+    setupRenderWorkers();
 
     // cache the set of used CCs for future access
     currentUsedCCs_ = collectAllUsedCCs();
@@ -930,7 +1013,8 @@ int Synth::getNumActiveVoices() const noexcept
 void Synth::setSamplesPerBlock(int samplesPerBlock) noexcept
 {
     Impl& impl = *impl_;
-    samplesPerBlock *= 128;
+    // hold the voices at the highest oversampling, see `hint_min_samplerate`
+    samplesPerBlock *= config::maxOversampling;
     ASSERT(samplesPerBlock <= config::maxBlockSize);
 
     impl.samplesPerBlock_ = samplesPerBlock;
@@ -943,6 +1027,11 @@ void Synth::setSamplesPerBlock(int samplesPerBlock) noexcept
         if (bus)
             bus->setSamplesPerBlock(samplesPerBlock);
     }
+
+    for (auto& submix : impl.filterSubmixes_)
+        submix->setSamplesPerBlock(samplesPerBlock);
+
+    impl.setupRenderWorkers();
 }
 
 int Synth::getSamplesPerBlock() const noexcept
@@ -965,6 +1054,9 @@ void Synth::setSampleRate(float sampleRate) noexcept
         if (bus)
             bus->setSampleRate(sampleRate);
     }
+
+    for (auto& submix : impl.filterSubmixes_)
+        submix->setSampleRate(sampleRate);
 }
 
 void Synth::renderBlock(AudioSpan<float> buffer) noexcept
@@ -1028,38 +1120,48 @@ void Synth::renderBlock(AudioSpan<float> buffer) noexcept
             if (bus)
                 bus->clearInputs(numFrames);
         }
+        for (auto& submix : impl.filterSubmixes_)
+            submix->clearInputs(numFrames);
     }
 
     { // Main render block
         ScopedTiming logger { callbackBreakdown.renderMethod, ScopedTiming::Operation::addToDuration };
         tempMixSpan->fill(0.0f);
 
-        for (auto& voice : impl.voiceManager_) {
-            if (voice.isFree())
-                continue;
-
-            mm.beginVoice(voice.getId(), voice.getRegion()->getId(), voice.getTriggerEvent().value);
-
-            const Region* region = voice.getRegion();
-            ASSERT(region != nullptr);
-
-            voice.renderBlock(*tempSpan);
-            for (size_t i = 0, n = impl.effectBuses_.size(); i < n; ++i) {
-                if (auto& bus = impl.effectBuses_[i]) {
-                    float addGain = region->getGainToEffectBus(i);
-                    bus->addToInputs(*tempSpan, addGain, numFrames);
+        if (impl.canRenderVoicesInParallel(numFrames)) {
+            impl.renderVoicesInParallel(numFrames, callbackBreakdown);
+        }
+        else {
+            for (auto& voice : impl.voiceManager_) {
+                if (voice.isFree())
+                    continue;
+
+                mm.beginVoice(voice.getId(), voice.getRegion()->getId(), voice.getTriggerEvent().value);
+
+                const Region* region = voice.getRegion();
+                ASSERT(region != nullptr);
+
+                FilterSubmix* submix = impl.setupFilterSubmix(voice);
+                voice.renderBlock(*tempSpan);
+                if (submix)
+                    submix->addToInputs(*tempSpan, numFrames);
+                else {
+                    for (const Region::EffectSend& send : region->effectSends)
+                        impl.effectBuses_[send.bus]->addToInputs(*tempSpan, send.gain, numFrames);
                 }
-            }
-            callbackBreakdown.data += voice.getLastDataDuration();
-            callbackBreakdown.amplitude += voice.getLastAmplitudeDuration();
-            callbackBreakdown.filters += voice.getLastFilterDuration();
-            callbackBreakdown.panning += voice.getLastPanningDuration();
+                callbackBreakdown.data += voice.getLastDataDuration();
+                callbackBreakdown.amplitude += voice.getLastAmplitudeDuration();
+                callbackBreakdown.filters += voice.getLastFilterDuration();
+                callbackBreakdown.panning += voice.getLastPanningDuration();
 
-            mm.endVoice();
+                mm.endVoice();
 
-            if (voice.toBeCleanedUp())
-                voice.reset();
+                if (voice.toBeCleanedUp())
+                    voice.reset();
+            }
         }
+
+        impl.processFilterSubmixes(numFrames);
     }
 
     { // Apply effect buses
@@ -1122,6 +1224,207 @@ void Synth::renderBlock(AudioSpan<float> buffer) noexcept
     SFIZZ_CHECK(isReasonableAudio(buffer.getConstSpan(1)));
 }
 
+void Synth::Impl::setupRenderWorkers()
+{
+    const unsigned numWorkers = renderPool_.getNumWorkers();
+    resources_.setNumRenderWorkers(numWorkers);
+
+    // a single worker renders directly into the buses
+    renderWorkers_.resize(numWorkers > 1 ? numWorkers : 0);
+    for (RenderWorker& worker : renderWorkers_) {
+        worker.busInputs.resize(effectBuses_.size());
+        for (AudioBuffer<float>& input : worker.busInputs) {
+            if (input.getNumChannels() != EffectChannels)
+                input = AudioBuffer<float>(EffectChannels, samplesPerBlock_);
+            else
+                input.resize(samplesPerBlock_);
+        }
+        // clear all the inputs at the next cycle
+        worker.busUsed.assign(effectBuses_.size(), true);
+    }
+
+    const size_t numVoices = config::calculateActualVoices(numVoices_);
+    renderVoices_.reserve(numVoices);
+    renderTasks_.reserve(numVoices);
+}
+
+FilterSubmix* Synth::Impl::getFilterSubmix(const Region* region) const noexcept
+{
+    // the voices apply their filters before decimation when oversampling
+    const SynthConfig& synthConfig = resources_.getSynthConfig();
+    if (!synthConfig.filterSubmixes || synthConfig.OSFactor != 1)
+        return nullptr;
+
+    if (region == nullptr || !region->filterSubmix)
+        return nullptr;
+
+    return filterSubmixes_[*region->filterSubmix].get();
+}
+
+FilterSubmix* Synth::Impl::setupFilterSubmix(Voice& voice) noexcept
+{
+    FilterSubmix* submix = getFilterSubmix(voice.getRegion());
+    voice.setFilterStageShared(submix != nullptr);
+    return submix;
+}
+
+void Synth::Impl::processFilterSubmixes(size_t numFrames) noexcept
+{
+    const unsigned frames = static_cast<unsigned>(numFrames);
+    for (FilterSubmixPtr& submix : filterSubmixes_) {
+        if (submix->isProcessed())
+            continue;
+
+        submix->process(frames);
+        if (!submix->isProcessed())
+            continue;
+
+        const AudioSpan<const float> output = submix->getOutputs(frames);
+        for (const Region::EffectSend& send : submix->effectSends())
+            effectBuses_[send.bus]->addToInputs(output, send.gain, frames);
+    }
+}
+
+bool Synth::Impl::canRenderVoicesInParallel(size_t numFrames) const noexcept
+{
+    if (renderWorkers_.empty())
+        return false;
+
+    const RenderWorker& worker = renderWorkers_.front();
+    return worker.busInputs.size() == effectBuses_.size() &&
+        (worker.busInputs.empty() || worker.busInputs.front().getNumFrames() >= numFrames);
+}
+
+void Synth::Impl::renderVoicesInParallel(size_t numFrames, CallbackBreakdown& callbackBreakdown) noexcept
+{
+    // compute lazily generated data which is shared by all voices
+    ModMatrix& mm = resources_.getModMatrix();
+    mm.prepareGlobalModulations();
+    resources_.getBeatClock().getRunningBeatPosition();
+
+    // group the voices per filter submix or else per region, each group
+    // being a task
+    renderVoices_.clear();
+    for (auto& voice : voiceManager_) {
+        if (!voice.isFree()) {
+            setupFilterSubmix(voice);
+            renderVoices_.push_back(&voice);
+        }
+    }
+
+    absl::c_sort(renderVoices_, [this](const Voice* lhs, const Voice* rhs) {
+        const FilterSubmix* lhsSubmix = getFilterSubmix(lhs->getRegion());
+        const FilterSubmix* rhsSubmix = getFilterSubmix(rhs->getRegion());
+        if (lhsSubmix != rhsSubmix)
+            return std::less<const FilterSubmix*>()(lhsSubmix, rhsSubmix);
+        return lhs->getRegion() < rhs->getRegion();
+    });
+
+    auto sameTask = [this](const Voice* lhs, const Voice* rhs) {
+        const FilterSubmix* submix = getFilterSubmix(lhs->getRegion());
+        if (submix != getFilterSubmix(rhs->getRegion()))
+            return false;
+        return submix || lhs->getRegion() == rhs->getRegion();
+    };
+
+    renderTasks_.clear();
+    for (unsigned i = 0, n = static_cast<unsigned>(renderVoices_.size()); i < n; ++i) {
+        if (renderTasks_.empty() || !sameTask(renderVoices_[i - 1], renderVoices_[i]))
+            renderTasks_.push_back({ i, i + 1 });
+        else
+            renderTasks_.back().voiceEnd = i + 1;
+    }
+
+    for (RenderWorker& worker : renderWorkers_) {
+        for (size_t i = 0, n = worker.busInputs.size(); i < n; ++i) {
+            if (!worker.busUsed[i])
+                continue;
+            AudioBuffer<float>& input = worker.busInputs[i];
+            for (size_t c = 0; c < input.getNumChannels(); ++c)
+                fill(input.getSpan(c).first(numFrames), 0.0f);
+            worker.busUsed[i] = false;
+        }
+        worker.dataDuration = Duration(0);
+        worker.amplitudeDuration = Duration(0);
+        worker.filterDuration = Duration(0);
+        worker.panningDuration = Duration(0);
+    }
+
+    auto renderTask = [this, &mm, numFrames](unsigned workerIndex, unsigned taskIndex) {
+        RenderWorker& worker = renderWorkers_[workerIndex];
+        BufferPool& bufferPool = resources_.getBufferPool();
+        auto tempSpan = bufferPool.getStereoBuffer(numFrames);
+        if (!tempSpan) {
+            DBG("[sfizz] Could not get a temporary buffer for a render worker");
+            return;
+        }
+
+        auto sendToBuses = [&worker, numFrames](AudioSpan<const float> output, const std::vector<Region::EffectSend>& sends) {
+            for (const Region::EffectSend& send : sends) {
+                AudioBuffer<float>& input = worker.busInputs[send.bus];
+                for (size_t c = 0; c < input.getNumChannels(); ++c)
+                    multiplyAdd1(send.gain, output.getConstSpan(c), input.getSpan(c).first(numFrames));
+                worker.busUsed[send.bus] = true;
+            }
+        };
+
+        const RenderTask& task = renderTasks_[taskIndex];
+        FilterSubmix* submix = getFilterSubmix(renderVoices_[task.voiceBegin]->getRegion());
+
+        for (unsigned v = task.voiceBegin; v < task.voiceEnd; ++v) {
+            Voice& voice = *renderVoices_[v];
+            const Region* region = voice.getRegion();
+            ASSERT(region != nullptr);
+
+            mm.beginVoice(voice.getId(), region->getId(), voice.getTriggerEvent().value);
+            voice.renderBlock(*tempSpan);
+
+            if (submix)
+                submix->addToInputs(*tempSpan, static_cast<unsigned>(numFrames));
+            else
+                sendToBuses(*tempSpan, region->effectSends);
+
+            worker.dataDuration += voice.getLastDataDuration();
+            worker.amplitudeDuration += voice.getLastAmplitudeDuration();
+            worker.filterDuration += voice.getLastFilterDuration();
+            worker.panningDuration += voice.getLastPanningDuration();
+
+            mm.endVoice();
+        }
+
+        if (submix) {
+            submix->process(static_cast<unsigned>(numFrames));
+            if (submix->isProcessed())
+                sendToBuses(submix->getOutputs(static_cast<unsigned>(numFrames)), submix->effectSends());
+        }
+    };
+
+    renderPool_.run(static_cast<unsigned>(renderTasks_.size()), renderTask);
+
+    // reduce the worker outputs into the buses
+    for (RenderWorker& worker : renderWorkers_) {
+        for (size_t i = 0, n = effectBuses_.size(); i < n; ++i) {
+            if (!worker.busUsed[i])
+                continue;
+            if (auto& bus = effectBuses_[i])
+                bus->addToInputs(AudioSpan<float>(worker.busInputs[i]), 1.0f, numFrames);
+        }
+        callbackBreakdown.data += worker.dataDuration;
+        callbackBreakdown.amplitude += worker.amplitudeDuration;
+        callbackBreakdown.filters += worker.filterDuration;
+        callbackBreakdown.panning += worker.panningDuration;
+    }
+
+    // the submixes without voices can have a remaining tail
+    processFilterSubmixes(numFrames);
+
+    // voice state changes update the shared voice lists, do them serially
+    for (Voice* voice : renderVoices_) {
+        if (voice->toBeCleanedUp())
+            voice->reset();
+    }
+}
+
 void Synth::noteOn(int delay, int noteNumber, int velocity) noexcept
 {
     const float normalizedVelocity = normalizeVelocity(velocity);
@@ -1158,8 +1461,8 @@ void Synth::hdNoteOff(int delay, int noteNumber, float normalizedVelocity) noexc
     midiState.noteOffEvent(delay, noteNumber, normalizedVelocity);
     const auto replacedVelocity = midiState.getNoteVelocity(noteNumber);
 
-    for (auto& voice : impl.voiceManager_)
-        voice.registerNoteOff(delay, noteNumber, replacedVelocity);
+    for (Voice* voice : impl.voiceManager_.getVoicesOnNote(noteNumber))
+        voice->registerNoteOff(delay, noteNumber, replacedVelocity);
 
     impl.noteOffDispatch(delay, noteNumber, replacedVelocity);
 }
@@ -1180,9 +1483,9 @@ void Synth::Impl::startVoice(Layer* layer, int delay, const TriggerEvent& trigge
 
 void Synth::Impl::checkOffGroups(const Region* region, int delay, int number)
 {
-    for (auto& voice : voiceManager_) {
-        if (voice.checkOffGroup(region, delay, number)) {
-            const TriggerEvent& event = voice.getTriggerEvent();
+    for (Voice* voice : voiceManager_.getVoicesOffBy(region->group)) {
+        if (voice->checkOffGroup(region, delay, number)) {
+            const TriggerEvent& event = voice->getTriggerEvent();
             noteOffDispatch(delay, event.number, event.value);
         }
     }
@@ -1234,7 +1537,11 @@ void Synth::Impl::noteOnDispatch(int delay, int noteNumber, float velocity) noex
     for (Layer* layer : downKeyswitchLists_[noteNumber])
         layer->keySwitched_ = true;
 
-    for (Layer* layer : noteActivationLists_[noteNumber]) {
+    const LayerViewVector& layers = noteActivationLists_[noteNumber];
+    noteActivationIndexes_[noteNumber].collectCandidates(velocity, noteOnCandidates_);
+
+    for (uint32_t position : noteOnCandidates_) {
+        Layer* layer = layers[position];
         if (layer->registerNoteOn(noteNumber, velocity, randValue)) {
             const Region& region = layer->getRegion();
             checkOffGroups(&region, delay, noteNumber);
@@ -1353,8 +1660,8 @@ void Synth::Impl::performHdcc(int delay, int ccNumber, float normValue, bool asM
         }
     }
 
-    for (auto& voice : voiceManager_)
-        voice.registerCC(delay, ccNumber, normValue);
+    for (Voice* voice : voiceManager_.getVoicesOnPedal(ccNumber))
+        voice->registerCC(delay, ccNumber, normValue);
 
     ccDispatch(delay, ccNumber, normValue);
     midiState.ccEvent(delay, ccNumber, normValue);
@@ -1445,8 +1752,8 @@ void Synth::hdPolyAftertouch(int delay, int noteNumber, float normAftertouch) no
 
     impl.resources_.getMidiState().polyAftertouchEvent(delay, noteNumber, normAftertouch);
 
-    for (auto& voice : impl.voiceManager_)
-        voice.registerPolyAftertouch(delay, noteNumber, normAftertouch);
+    for (Voice* voice : impl.voiceManager_.getVoicesOnNote(noteNumber))
+        voice->registerPolyAftertouch(delay, noteNumber, normAftertouch);
 
     // Note information is lost on this CC
     impl.performHdcc(delay, ExtendedCCs::polyphonicAftertouch, normAftertouch, false);
@@ -1806,6 +2113,26 @@ void Synth::setNumVoices(int numVoices) noexcept
     impl.resetVoices(numVoices);
 }
 
+int Synth::getNumRenderThreads() const noexcept
+{
+    Impl& impl = *impl_;
+    return static_cast<int>(impl.renderPool_.getNumWorkers());
+}
+
+void Synth::setNumRenderThreads(int numThreads) noexcept
+{
+    Impl& impl = *impl_;
+    const unsigned numWorkers = static_cast<unsigned>(
+        clamp(numThreads, 1, config::maxRenderThreads));
+
+    // fast path
+    if (numWorkers == impl.renderPool_.getNumWorkers())
+        return;
+
+    impl.renderPool_.setNumWorkers(numWorkers);
+    impl.setupRenderWorkers();
+}
+
 void Synth::Impl::resetVoices(int numVoices)
 {
     numVoices_ = numVoices;
@@ -1821,11 +2148,16 @@ void Synth::Impl::resetVoices(int numVoices)
     }
 
     applySettingsPerVoice();
+    setupRenderWorkers();
 }
 
 void Synth::Impl::applySettingsPerVoice()
 {
+    const bool diskStreaming = resources_.getFilePool().isStreaming();
+    const bool memoryMapping = resources_.getFilePool().isMemoryMapping();
     for (auto& voice : voiceManager_) {
+        voice.setDiskStreaming(diskStreaming);
+        voice.setSampleMemoryMapping(memoryMapping);
         voice.setMaxFiltersPerVoice(settingsPerVoice_.maxFilters);
         voice.setMaxEQsPerVoice(settingsPerVoice_.maxEQs);
         voice.setMaxLFOsPerVoice(settingsPerVoice_.maxLFOs);
@@ -1918,6 +2250,62 @@ void Synth::Impl::setupModMatrix()
     mm.init();
 }
 
+bool Synth::isDiskStreaming() const noexcept
+{
+    Impl& impl = *impl_;
+    return impl.resources_.getFilePool().isStreaming();
+}
+
+void Synth::setDiskStreaming(bool streaming) noexcept
+{
+    Impl& impl = *impl_;
+    FilePool& filePool = impl.resources_.getFilePool();
+
+    // fast path
+    if (streaming == filePool.isStreaming())
+        return;
+
+    filePool.setStreaming(streaming);
+    impl.resetVoices(impl.numVoices_);
+}
+
+bool Synth::isSampleMemoryMapping() const noexcept
+{
+    Impl& impl = *impl_;
+    return impl.resources_.getFilePool().isMemoryMapping();
+}
+
+void Synth::setSampleMemoryMapping(bool mapping) noexcept
+{
+    Impl& impl = *impl_;
+    FilePool& filePool = impl.resources_.getFilePool();
+
+    // fast path
+    if (mapping == filePool.isMemoryMapping())
+        return;
+
+    filePool.setMemoryMapping(mapping);
+    impl.resetVoices(impl.numVoices_);
+}
+
+void Synth::setSampleCacheDirectory(const fs::path& directory) noexcept
+{
+    Impl& impl = *impl_;
+    impl.resources_.getFilePool().setCacheDirectory(directory);
+}
+
+fs::path Synth::getSampleCacheDirectory() const noexcept
+{
+    Impl& impl = *impl_;
+    return impl.resources_.getFilePool().getCacheDirectory();
+}
+
+SampleStore::Stats Synth::getSampleStoreStats() const noexcept
+{
+    Impl& impl = *impl_;
+    return impl.resources_.getFilePool().getSampleStore().getStats();
+}
+
 void Synth::setPreloadSize(uint32_t preloadSize) noexcept
 {
     Impl& impl = *impl_;
@@ -1962,10 +2350,12 @@ void Synth::Impl::resetAllControllers(int delay) noexcept
     for (int cc = 0; cc < config::numCCs; ++cc)
         midiState.ccEvent(delay, cc, defaultCCValues_[cc]);
 
-    for (auto& voice : voiceManager_) {
+    for (auto& voice : voiceManager_)
         voice.registerPitchWheel(delay, 0);
-        for (int cc = 0; cc < config::numCCs; ++cc)
-            voice.registerCC(delay, cc, defaultCCValues_[cc]);
+
+    for (int cc = 0; cc < config::numCCs; ++cc) {
+        for (Voice* voice : voiceManager_.getVoicesOnPedal(cc))
+            voice->registerCC(delay, cc, defaultCCValues_[cc]);
     }
 
     for (const LayerPtr& layerPtr : layers_) {
@@ -2029,6 +2419,8 @@ void Synth::allSoundOff() noexcept
         voice.reset();
     for (auto& effectBus : impl.effectBuses_)
         effectBus->clear();
+    for (auto& submix : impl.filterSubmixes_)
+        submix->clear();
 }
 
 void Synth::addExternalDefinition(const std::string& id, const std::string& value)
@@ -8,6 +8,7 @@
 #include "AudioSpan.h"
 #include "Resources.h"
 #include "Messaging.h"
+#include "SampleStore.h"
 #include "utility/NumericId.h"
 #include "utility/LeakDetector.h"
 #include <ghc/fs_std.hpp>
@@ -557,6 +558,81 @@ public:
      */
     void setNumVoices(int numVoices) noexcept;
 
+    /**
+     * @brief Get the number of threads which render the voices, including
+     * the calling thread.
+     *
+     * @return int
+     */
+    int getNumRenderThreads() const noexcept;
+    /**
+     * @brief Change the number of threads which render the voices.
+     * The default is 1, which renders all voices on the calling thread.
+     * Above this, the voices are distributed across additional worker
+     * threads which cooperate with the calling thread on each block.
+     * This function creates and joins threads; do not call it
+     * concurrently with the render callback.
+     *
+     * @param numThreads the number of threads, including the calling thread
+     */
+    void setNumRenderThreads(int numThreads) noexcept;
+
+    /**
+     * @brief Check whether the samples are streamed from disk.
+     *
+     * @return bool
+     */
+    bool isDiskStreaming() const noexcept;
+    /**
+     * @brief Change whether the samples are streamed from disk. When enabled,
+     * the frames past the preloaded size are read by the background loaders
+     * into a fixed ring of chunks per voice, so that the memory used scales
+     * with the polyphony instead of the length of the samples.
+     * This resets the voices; do not call it concurrently with the render
+     * callback.
+     *
+     * @param streaming
+     */
+    void setDiskStreaming(bool streaming) noexcept;
+
+    /**
+     * @brief Check whether the uncompressed WAV samples are memory-mapped.
+     *
+     * @return bool
+     */
+    bool isSampleMemoryMapping() const noexcept;
+    /**
+     * @brief Change whether the uncompressed WAV samples are memory-mapped.
+     * When enabled, the voices read the frames past the preloaded size in
+     * place from a mapping of the file, converting them as they go, so that
+     * the system page cache holds the sample data and shares it between the
+     * processes which play the same files. Other files are unaffected.
+     * This resets the voices; do not call it concurrently with the render
+     * callback.
+     *
+     * @param mapping
+     */
+    void setSampleMemoryMapping(bool mapping) noexcept;
+
+    /**
+     * @brief Set the directory where the information and the preloaded
+     * frames of the sample files are cached, to speed up the next loads of
+     * the same samples. An empty path disables the cache, which is the default.
+     *
+     * @param directory
+     */
+    void setSampleCacheDirectory(const fs::path& directory) noexcept;
+    /**
+     * @brief Get the directory of the sample cache, empty if it is disabled.
+     */
+    fs::path getSampleCacheDirectory() const noexcept;
+
+    /**
+     * @brief Get statistics about the sample data, which the synths of the
+     * process share when they play the same samples.
+     */
+    SampleStore::Stats getSampleStoreStats() const noexcept;
+
     /**
      * @brief Set the preloaded file size.
      * This function takes a lock and disables the callback; prefer calling
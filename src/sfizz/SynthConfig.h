@@ -29,6 +29,8 @@ struct SynthConfig
         return freeWheeling ? freeWheelingOscillatorQuality : liveOscillatorQuality;
     }
     int OSFactor { 1 };
+    // Apply the static filters of the voices on shared submixes
+    bool filterSubmixes { true };
     bool sustainCancelsRelease { Default::sustainCancelsRelease };
 };
 }
@@ -2,10 +2,14 @@
 
 #include "Synth.h"
 #include "Effects.h"
+#include "FilterSubmix.h"
 #include "SisterVoiceRing.h"
 #include "TriggerEvent.h"
 #include "VoiceManager.h"
 #include "Layer.h"
+#include "NoteActivationIndex.h"
+#include "Logger.h"
+#include "RenderPool.h"
 #include "BitArray.h"
 #include "modulations/sources/ADSREnvelope.h"
 #include "modulations/sources/Controller.h"
@@ -113,6 +117,55 @@ struct Synth::Impl final: public Parser::Listener {
      */
     void setupModMatrix();
 
+    /**
+     * @brief Size the per-worker storage used to render voices concurrently,
+     * according to the number of workers, effect buses and voices.
+     */
+    void setupRenderWorkers();
+
+    /**
+     * @brief Check whether the per-worker storage is ready to render the
+     * voices concurrently for a block of the given size.
+     *
+     * @param numFrames
+     */
+    bool canRenderVoicesInParallel(size_t numFrames) const noexcept;
+
+    /**
+     * @brief Render all the active voices into the effect bus inputs using
+     * the render workers. The voices of a same region are rendered in
+     * sequence by the same worker, since they share modulation buffers, and
+     * so are the voices of a same filter submix.
+     *
+     * @param numFrames
+     * @param callbackBreakdown
+     */
+    void renderVoicesInParallel(size_t numFrames, CallbackBreakdown& callbackBreakdown) noexcept;
+
+    /**
+     * @brief Get the submix which applies the filter stage of the voices of
+     * a region, or null if the voices must apply it themselves.
+     *
+     * @param region
+     */
+    FilterSubmix* getFilterSubmix(const Region* region) const noexcept;
+
+    /**
+     * @brief Get the submix which applies the filter stage of a voice, as
+     * `getFilterSubmix`, and set the voice to skip it accordingly.
+     *
+     * @param voice
+     */
+    FilterSubmix* setupFilterSubmix(Voice& voice) noexcept;
+
+    /**
+     * @brief Process the filter submixes which were not processed yet in
+     * this cycle, and send their outputs into the effect buses.
+     *
+     * @param numFrames
+     */
+    void processFilterSubmixes(size_t numFrames) noexcept;
+
     /**
      * @brief Get the modification time of all included sfz files
      *
@@ -272,6 +325,10 @@ struct Synth::Impl final: public Parser::Listener {
     std::array<LayerViewVector, 128> upKeyswitchLists_;
     LayerViewVector previousKeyswitchLists_;
     std::array<LayerViewVector, 128> noteActivationLists_;
+    // Indexes of the note activation lists, and the positions of the candidate
+    // layers of a note-on in its list
+    std::array<NoteActivationIndex, 128> noteActivationIndexes_;
+    std::vector<uint32_t> noteOnCandidates_;
     std::array<LayerViewVector, config::numCCs> ccActivationLists_;
 
     // Effect factory and buses
@@ -279,6 +336,10 @@ struct Synth::Impl final: public Parser::Listener {
     typedef std::unique_ptr<EffectBus> EffectBusPtr;
     std::vector<EffectBusPtr> effectBuses_; // 0 is "main", 1-N are "fx1"-"fxN"
 
+    // Submixes of the voices whose regions have the same static filters
+    typedef std::unique_ptr<FilterSubmix> FilterSubmixPtr;
+    std::vector<FilterSubmixPtr> filterSubmixes_;
+
     int samplesPerBlock_ { config::defaultSamplesPerBlock };
     float sampleRate_ { config::defaultSampleRate };
     float volume_ { Default::globalVolume };
@@ -322,6 +383,24 @@ struct Synth::Impl final: public Parser::Listener {
 
     Duration dispatchDuration_ { 0 };
 
+    // Concurrent rendering of the voices
+    struct RenderWorker {
+        std::vector<AudioBuffer<float>> busInputs; // one per effect bus
+        std::vector<bool> busUsed; // whether the bus input has some voices
+        Duration dataDuration { 0 };
+        Duration amplitudeDuration { 0 };
+        Duration filterDuration { 0 };
+        Duration panningDuration { 0 };
+    };
+    struct RenderTask {
+        unsigned voiceBegin { 0 };
+        unsigned voiceEnd { 0 };
+    };
+    RenderPool renderPool_;
+    std::vector<RenderWorker> renderWorkers_;
+    VoiceViewVector renderVoices_;
+    std::vector<RenderTask> renderTasks_;
+
     std::chrono::time_point<std::chrono::high_resolution_clock> lastGarbageCollection_;
 
     Parser parser_;
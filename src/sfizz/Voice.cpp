@@ -16,6 +16,7 @@
 #include "LFO.h"
 #include "MathHelpers.h"
 #include "ModifierHelpers.h"
+#include "NoiseGenerator.h"
 #include "RegionStateful.h"
 #include "TriggerEvent.h"
 #include "modulations/ModId.h"
@@ -28,10 +29,13 @@
 #include "SIMDHelpers.h"
 #include "Smoothers.h"
 #include "FilePool.h"
+#include "FileStream.h"
+#include "MappedSample.h"
 #include "Wavetables.h"
 #include "Tuning.h"
 #include "BufferPool.h"
 #include "SynthConfig.h"
+#include "VoiceDecimator.h"
 #include "utility/Macros.h"
 #include <absl/algorithm/container.h>
 #include <absl/types/span.h>
@@ -65,12 +69,27 @@ struct Voice::Impl
      * @param dest the destination buffer
      * @param indices the integral parts of the source positions
      * @param coeffs the fractional parts of the source positions
+     * @param useAVX2 whether the windowed sincs use their AVX2 kernel
      */
     template <InterpolatorModel M, bool Adding>
     static void fillInterpolated(
         const AudioSpan<const float>& source, const AudioSpan<float>& dest,
         absl::Span<const int> indices, absl::Span<const float> coeffs,
-        absl::Span<const float> addingGains, float mod);
+        absl::Span<const float> addingGains, float mod, bool useAVX2);
+
+    /**
+     * @brief Fill a destination with the source frames at exact positions,
+     *        which need no interpolation.
+     *
+     * @param source the source sample
+     * @param dest the destination buffer
+     * @param indices the source positions
+     * @param addingGains the gains to apply when adding to the destination
+     */
+    template <bool Adding>
+    static void fillExact(
+        const AudioSpan<const float>& source, const AudioSpan<float>& dest,
+        absl::Span<const int> indices, absl::Span<const float> addingGains);
 
     /**
      * @brief Fill a destination with an interpolated source, selecting
@@ -81,12 +100,13 @@ struct Voice::Impl
      * @param indices the integral parts of the source positions
      * @param coeffs the fractional parts of the source positions
      * @param quality the quality level 1-10
+     * @param useAVX2 whether the windowed sincs use their AVX2 kernel
      */
     template <bool Adding>
     static void fillInterpolatedWithQuality(
         const AudioSpan<const float>& source, const AudioSpan<float>& dest,
         absl::Span<const int> indices, absl::Span<const float> coeffs,
-        absl::Span<const float> addingGains, int quality, float mod);
+        absl::Span<const float> addingGains, int quality, float mod, bool useAVX2);
 
     /**
      * @brief Get a S-shaped curve that is applicable to loop crossfading.
@@ -128,6 +148,17 @@ struct Voice::Impl
      */
     void panStageMono(AudioSpan<float> buffer) noexcept;
     void panStageStereo(AudioSpan<float> buffer) noexcept;
+    /**
+     * @brief Compute the envelope of a base value and its modulation. If it
+     * is constant over the block, only the first element is set.
+     *
+     * @param value the base value
+     * @param target the modulation target
+     * @param envelope the envelope to fill
+     * @return whether the envelope is constant, in which case it is not
+     *         empty and its first element holds the value
+     */
+    bool modulatedEnvelope(float value, ModMatrix::TargetId target, absl::Span<float> envelope) noexcept;
     /**
      * @brief Amplitude stage for a mono source
      *
@@ -141,8 +172,20 @@ struct Voice::Impl
      * point intervals for sample-based voices, or phases for generators)
      *
      * @param pitchSpan
+     * @return whether the pitch is constant over the span
+     */
+    bool pitchEnvelope(absl::Span<float> pitchSpan) noexcept;
+
+    /**
+     * @brief Convert the pitch envelope in cents into frequency ratios.
+     * Input and output can refer to the same memory.
+     *
+     * @param pitchSpan the pitch envelope
+     * @param constantPitch whether the pitch is constant over the span
+     * @param baseRatio the ratio to multiply with
+     * @param ratios the output ratios
      */
-    void pitchEnvelope(absl::Span<float> pitchSpan) noexcept;
+    static void pitchRatios(absl::Span<float> pitchSpan, bool constantPitch, float baseRatio, absl::Span<float> ratios) noexcept;
 
     /**
      * @brief Initialize frequency and gain coefficients for the oscillators.
@@ -184,6 +227,11 @@ struct Voice::Impl
      *
      */
     void updateLoopInformation() noexcept;
+    /**
+     * @brief Allocate the buffer which streamed or mapped frames are gathered
+     * into, if the voice needs it, or free it otherwise.
+     */
+    void updateGatherBuffer();
 
     /**
      * @brief Check whether the voice is released
@@ -257,6 +305,10 @@ struct Voice::Impl
     } loop_;
 
     FileDataHolder currentPromise_;
+    std::shared_ptr<FileStream> stream_;
+    const MappedSample* mapped_ { nullptr };
+    bool memoryMapping_ { false };
+    FileAudioBuffer gatherBuffer_;
 
     int samplesPerBlock_ { config::defaultSamplesPerBlock };
     float sampleRate_ { config::defaultSampleRate };
@@ -277,6 +329,7 @@ struct Voice::Impl
     std::unique_ptr<ADSREnvelope> egFilter_;
 
     WavetableOscillator waveOscillators_[config::oscillatorsPerVoice];
+    WavetableUnison waveUnison_;
 
     // unison of oscillators
     unsigned waveUnisonSize_ { 0 };
@@ -289,8 +342,7 @@ struct Voice::Impl
     Duration panningDuration_;
     Duration filterDuration_;
 
-    fast_real_distribution<float> uniformNoiseDist_ { -config::uniformNoiseBounds, config::uniformNoiseBounds };
-    fast_gaussian_generator<float> gaussianNoiseDist_ { 0.0f, config::noiseVariance };
+    NoiseGenerator noiseGenerator_;
 
     Smoother gainSmoother_;
     Smoother bendSmoother_;
@@ -308,7 +360,9 @@ struct Voice::Impl
     ModMatrix::TargetId oscillatorModDepthTarget_;
 
     bool followPower_ { false };
+    bool filterStageShared_ { false };
     PowerFollower powerFollower_;
+    VoiceDecimator decimator_;
 
     ExtendedCCValues extendedCCValues_;
 };
@@ -378,6 +432,7 @@ Voice::Impl::Impl(int voiceNumber, Resources& resources)
 
     for (WavetableOscillator& osc : waveOscillators_)
         osc.init(sampleRate_);
+    waveUnison_.init(sampleRate_);
 
     gainSmoother_.setSmoothing(config::gainSmoothing, sampleRate_);
     xfadeSmoother_.setSmoothing(config::xfadeSmoothing, sampleRate_);
@@ -466,17 +521,37 @@ bool Voice::startVoice(Layer* layer, int delay, const TriggerEvent& event) noexc
             osc.setPhase(phase);
             osc.setQuality(quality);
         }
+        impl.waveUnison_.setWavetable(wave);
+        impl.waveUnison_.setPhase(phase);
+        impl.waveUnison_.setQuality(quality);
         impl.setupOscillatorUnison();
     } else {
         FilePool& filePool = resources.getFilePool();
-        impl.currentPromise_ = filePool.getFilePromise(region.sampleId);
+        const uint64_t startFrame = sampleOffset(region, midiState);
+        impl.currentPromise_ = filePool.getFilePromise(region.sampleId, startFrame);
         if (!impl.currentPromise_) {
             impl.switchState(State::cleanMeUp);
             return false;
         }
         impl.updateLoopInformation();
         impl.speedRatio_ = static_cast<float>(impl.currentPromise_->information.sampleRate / impl.sampleRate_);
-        impl.sourcePosition_ = sampleOffset(region, midiState);
+        impl.sourcePosition_ = startFrame;
+
+        FileData& data = *impl.currentPromise_;
+        const auto fileFrames = static_cast<size_t>(data.information.end + 1);
+        const bool partiallyLoaded = data.getNumPreloadedFrames() < fileFrames && data.availableFrames < fileFrames;
+        impl.mapped_ = (impl.memoryMapping_ && partiallyLoaded) ? data.mappedData.get() : nullptr;
+
+        if (impl.stream_) {
+            if (partiallyLoaded && !impl.mapped_) {
+                impl.stream_->attach(data);
+                impl.stream_->setPlayhead(impl.sourcePosition_, 0, -1);
+                if (impl.stream_->shouldRequestRefill())
+                    filePool.requestStreamRefill(impl.stream_, region.sampleId);
+            } else {
+                impl.stream_->detach();
+            }
+        }
     }
 
     // do Scala retuning and reconvert the frequency into a 12TET key number
@@ -736,6 +811,7 @@ void Voice::setSampleRate(float sampleRate) noexcept
 
     for (WavetableOscillator& osc : impl.waveOscillators_)
         osc.init(impl.sampleRate_);
+    impl.waveUnison_.init(impl.sampleRate_);
 
     for (auto& eg : impl.flexEGs_)
         eg->setSampleRate(sampleRate);
@@ -756,10 +832,8 @@ void Voice::setSampleRate(float sampleRate) noexcept
         eq.setSampleRate(impl.sampleRate_);
 
     impl.powerFollower_.setSampleRate(impl.sampleRate_);
-    downsampleFilter.setType(FilterType::kFilterLpf6p);
-    downsampleFilter.setChannels(2);
-    downsampleFilter.init(sampleRate);
-    downsampleFilter.prepare(0.48f * sampleRate / float(impl.resources_.getSynthConfig().OSFactor), 0.0, 0.0);
+    impl.decimator_.setFactor(impl.resources_.getSynthConfig().OSFactor);
+    impl.decimator_.clear();
 }
 
 void Voice::setSamplesPerBlock(int samplesPerBlock) noexcept
@@ -769,6 +843,12 @@ void Voice::setSamplesPerBlock(int samplesPerBlock) noexcept
     impl.powerFollower_.setSamplesPerBlock(samplesPerBlock);
 }
 
+void Voice::setFilterStageShared(bool shared) noexcept
+{
+    Impl& impl = *impl_;
+    impl.filterStageShared_ = shared;
+}
+
 void Voice::renderBlock(AudioSpan<float> buffer) noexcept
 {
     Impl& impl = *impl_;
@@ -778,8 +858,17 @@ void Voice::renderBlock(AudioSpan<float> buffer) noexcept
     const Region* region = impl.region_;
     if (region == nullptr || region->disabled())
         return;
-    AudioBuffer<float> interBuffer(buffer.getNumChannels(), buffer.getNumFrames() * impl.resources_.getSynthConfig().OSFactor);
-    AudioSpan<float> downsampled_buffer(interBuffer);
+
+    // the pool buffers hold `config::maxOversampling` blocks, so that they
+    // fit the oversampled block whatever the factor
+    BufferPool& bufferPool = impl.resources_.getBufferPool();
+    auto interBuffer = bufferPool.getStereoBuffer(buffer.getNumFrames() * impl.resources_.getSynthConfig().OSFactor);
+    if (!interBuffer) {
+        DBG("[sfizz] Could not get an oversampling buffer for the voice");
+        return;
+    }
+
+    AudioSpan<float> downsampled_buffer(*interBuffer);
     downsampled_buffer.fill(0.0f);
 
     const auto delay = min(static_cast<size_t>(impl.initialDelay_), downsampled_buffer.getNumFrames());
@@ -797,27 +886,16 @@ void Voice::renderBlock(AudioSpan<float> buffer) noexcept
     if (region->isStereo()) {
         impl.ampStageStereo(downsampled_buffer);
         impl.panStageStereo(downsampled_buffer);
-        impl.filterStageStereo(downsampled_buffer);
+        if (!impl.filterStageShared_)
+            impl.filterStageStereo(downsampled_buffer);
     } else {
         impl.ampStageMono(downsampled_buffer);
-        impl.filterStageMono(downsampled_buffer);
+        if (!impl.filterStageShared_)
+            impl.filterStageMono(downsampled_buffer);
         impl.panStageMono(downsampled_buffer);
     }
 
-    if (impl.resources_.getSynthConfig().OSFactor > 1)
-	downsampleFilter.process(downsampled_buffer, downsampled_buffer, 0.48f * impl.sampleRate_ / float(impl.resources_.getSynthConfig().OSFactor) / float(impl.resources_.getSynthConfig().OSFactor), 0.0, 0.0, downsampled_buffer.getNumFrames());
-
-    for (size_t i = 0; i < buffer.getNumChannels(); ++i)
-{
-    for (size_t j = 0; j < buffer.getNumFrames(); ++j)
-{
-    buffer[i][j] = downsampled_buffer[i][j * impl.resources_.getSynthConfig().OSFactor];
-    if (impl.resources_.getSynthConfig().OSFactor > 1)
-    for (int k = 1; k < impl.resources_.getSynthConfig().OSFactor; ++k)
-         buffer[i][j] += downsampled_buffer[i][j * impl.resources_.getSynthConfig().OSFactor + k];
-    buffer[i][j] /= float(impl.resources_.getSynthConfig().OSFactor);
-}
-}
+    impl.decimator_.process(downsampled_buffer, buffer);
 
     if (!region->flexAmpEG) {
         if (!impl.egAmplitude_.isSmoothing())
@@ -982,18 +1060,14 @@ void Voice::Impl::panStageMono(AudioSpan<float> buffer) noexcept
     if (!modulationSpan)
         return;
 
-    ModMatrix& mm = resources_.getModMatrix();
-
     // Prepare for stereo output
     copy<float>(leftBuffer, rightBuffer);
 
     // Apply panning
-    fill(*modulationSpan, region_->pan);
-    if (float* mod = mm.getModulation(panTarget_)) {
-        for (size_t i = 0; i < numSamples; ++i)
-            (*modulationSpan)[i] += mod[i];
-    }
-    pan(*modulationSpan, leftBuffer, rightBuffer);
+    if (modulatedEnvelope(region_->pan, panTarget_, *modulationSpan))
+        pan1(modulationSpan->front(), leftBuffer, rightBuffer);
+    else
+        pan(*modulationSpan, leftBuffer, rightBuffer);
 }
 
 void Voice::Impl::panStageStereo(AudioSpan<float> buffer) noexcept
@@ -1009,36 +1083,45 @@ void Voice::Impl::panStageStereo(AudioSpan<float> buffer) noexcept
     if (!modulationSpan)
         return;
 
-    ModMatrix& mm = resources_.getModMatrix();
-
     // Apply panning
-    fill(*modulationSpan, region_->pan);
-    if (float* mod = mm.getModulation(panTarget_)) {
-        for (size_t i = 0; i < numSamples; ++i)
-            (*modulationSpan)[i] += mod[i];
-    }
-    pan(*modulationSpan, leftBuffer, rightBuffer);
+    if (modulatedEnvelope(region_->pan, panTarget_, *modulationSpan))
+        pan1(modulationSpan->front(), leftBuffer, rightBuffer);
+    else
+        pan(*modulationSpan, leftBuffer, rightBuffer);
 
     // Apply the width/position process
-    fill(*modulationSpan, region_->width);
-    if (float* mod = mm.getModulation(widthTarget_)) {
-        for (size_t i = 0; i < numSamples; ++i)
-            (*modulationSpan)[i] += mod[i];
-    }
-    width(*modulationSpan, leftBuffer, rightBuffer);
+    if (modulatedEnvelope(region_->width, widthTarget_, *modulationSpan))
+        width1(modulationSpan->front(), leftBuffer, rightBuffer);
+    else
+        width(*modulationSpan, leftBuffer, rightBuffer);
 
-    fill(*modulationSpan, region_->position);
-    if (float* mod = mm.getModulation(positionTarget_)) {
-        for (size_t i = 0; i < numSamples; ++i)
-            (*modulationSpan)[i] += mod[i];
-    }
-    pan(*modulationSpan, leftBuffer, rightBuffer);
+    if (modulatedEnvelope(region_->position, positionTarget_, *modulationSpan))
+        pan1(modulationSpan->front(), leftBuffer, rightBuffer);
+    else
+        pan(*modulationSpan, leftBuffer, rightBuffer);
 
     // add +3dB to compensate for the 2 pan stages (-3dB each stage)
     applyGain1(1.4125375446227544f, leftBuffer);
     applyGain1(1.4125375446227544f, rightBuffer);
 }
 
+bool Voice::Impl::modulatedEnvelope(float value, ModMatrix::TargetId target, absl::Span<float> envelope) noexcept
+{
+    if (envelope.empty())
+        return false;
+
+    ModMatrix& mm = resources_.getModMatrix();
+    const float* mod = mm.getModulation(target);
+    if (!mod || allWithin<float>(mod, mod[0], mod[0], envelope.size())) {
+        envelope.front() = mod ? value + mod[0] : value;
+        return true;
+    }
+
+    fill(envelope, value);
+    add<float>(absl::MakeConstSpan(mod, envelope.size()), envelope);
+    return false;
+}
+
 void Voice::Impl::filterStageMono(AudioSpan<float> buffer) noexcept
 {
     ScopedTiming logger { filterDuration_ };
@@ -1093,38 +1176,64 @@ void Voice::Impl::fillWithData(AudioSpan<float> buffer) noexcept
     // calculate interpolation data
     //   indices: integral position in the source audio
     //   coeffs: fractional position normalized 0-1
+    //   exactPositions: whether all the coeffs are zero
     auto coeffs = bufferPool.getBuffer(numSamples);
     auto indices = bufferPool.getIndexBuffer(numSamples);
     if (!indices || !coeffs)
         return;
+    bool exactPositions = false;
     {
         auto jumps = bufferPool.getBuffer(numSamples);
         if (!jumps)
             return;
 
         absl::Span<float> pitch = *jumps; // temporary
-        pitchEnvelope(pitch);
+        const bool constantPitch = pitchEnvelope(pitch);
 
         float baseRatio = pitchRatio_ * speedRatio_;
-        for (size_t i = 0; i < numSamples; ++i)
-            (*jumps)[i] = baseRatio * centsFactor(pitch[i]);
 
-        // Take the first sample if the voice just started
-        if (age_ == 0)
-            jumps->front() = 0.0f;
+        // A constant pitch at an integer ratio, starting from an exact frame,
+        // only ever lands on exact frames: step the indices directly and
+        // copy the frames instead of interpolating them
+        const float blockRatio = baseRatio * centsFactor(pitch.front());
+        exactPositions = constantPitch && floatPositionOffset_ == 0.0f
+            && blockRatio >= 1.0f && blockRatio == std::floor(blockRatio);
+
+        if (exactPositions) {
+            const int step = static_cast<int>(blockRatio);
+            // Take the first sample if the voice just started
+            int position = sourcePosition_ + (age_ == 0 ? 0 : step);
+            for (size_t i = 0; i < numSamples; ++i, position += step)
+                (*indices)[i] = position;
+            fill<float>(*coeffs, 0.0f);
+        } else {
+            pitchRatios(pitch, constantPitch, baseRatio, *jumps);
+
+            // Take the first sample if the voice just started
+            if (age_ == 0)
+                jumps->front() = 0.0f;
 
-        jumps->front() += floatPositionOffset_;
-        cumsum<float>(*jumps, *jumps);
-        sfzInterpolationCast<float>(*jumps, *indices, *coeffs);
-        add1<int>(sourcePosition_, *indices);
+            jumps->front() += floatPositionOffset_;
+            cumsum<float>(*jumps, *jumps);
+            sfzInterpolationCast<float>(*jumps, *indices, *coeffs);
+            add1<int>(sourcePosition_, *indices);
+        }
     }
 
     // Update loop characteristics with the current CC state
     updateLoopInformation();
     const auto loop = this->loop_;
 
+    // When streaming or reading a mapped file, the source only holds the
+    // preloaded frames and the frames are rather gathered from the stream or
+    // the mapping around the indices of each partition
+    FileStream* stream = (stream_ && stream_->isAttached()) ? stream_.get() : nullptr;
+    const bool gathering = stream || mapped_;
+    const size_t sourceFrames = gathering ?
+        static_cast<size_t>(currentPromise_->information.end + 1) : source.getNumFrames();
+
     // Looping logic
-    const bool hasLoopSamples = static_cast<size_t>(loop.end) < source.getNumFrames();
+    const bool hasLoopSamples = static_cast<size_t>(loop.end) < sourceFrames;
     const bool loopCountReached = region_->loopCount && loop_.restarts >= *region_->loopCount;
     const bool loopContinuous = (region_->loopMode == LoopMode::loop_continuous);
     const bool loopSustain = (region_->loopMode == LoopMode::loop_sustain) && !released();
@@ -1168,7 +1277,7 @@ void Voice::Impl::fillWithData(AudioSpan<float> buffer) noexcept
         numPartitions = 1;
     }
 
-    const auto sampleEnd = min( int(sampleEnd_), int(currentPromise_->information.end), int(source.getNumFrames())) - 1;
+    const auto sampleEnd = min( int(sampleEnd_), int(currentPromise_->information.end), int(sourceFrames)) - 1;
 
     int blockRestarts { 0 };
     int oldIndex {};
@@ -1216,6 +1325,7 @@ void Voice::Impl::fillWithData(AudioSpan<float> buffer) noexcept
             if ((*indices)[i] >= sampleEnd) {
                 fill<int>(indices->subspan(i), sampleEnd);
                 fill<float>(coeffs->subspan(i), 0x1.fffffep-1);
+                exactPositions = false;
                 break;
             }
             i++;
@@ -1235,13 +1345,49 @@ void Voice::Impl::fillWithData(AudioSpan<float> buffer) noexcept
                 off(int(i), true);
                 fill<int>(indices->subspan(i), sampleEnd);
                 fill<float>(coeffs->subspan(i), 0x1.fffffep-1);
+                exactPositions = false;
                 break;
             }
         }
     }
 
+    SpanHolder<absl::Span<int>> gatherIndices;
+    if (gathering) {
+        if (stream)
+            stream->setPlayhead(indices->front(), min(loop.start, loop.xfInStart), shouldLoop ? loop.end : -1);
+        gatherIndices = bufferPool.getIndexBuffer(numSamples);
+        if (!gatherIndices)
+            return;
+    }
+
+    // Copy the frames which the indices read from the stream or the mapping
+    // into the gather buffer, and rebase the indices onto it. An empty source
+    // is returned if the indices spread further than the gather buffer.
+    const auto gatherFrames = [&](absl::Span<int> gathered) -> AudioSpan<const float> {
+        const auto range = std::minmax_element(gathered.begin(), gathered.end());
+        const int first = *range.first - config::excessFileFrames;
+        const int last = *range.second + config::excessFileFrames;
+        AudioSpan<float> scratch = AudioSpan<float>(gatherBuffer_);
+        const auto numFrames = static_cast<size_t>(last - first + 1);
+        if (numFrames > scratch.getNumFrames())
+            return {};
+
+        if (source.getNumChannels() == 1)
+            scratch = AudioSpan<float>({ scratch.getChannel(0) }, numFrames);
+        else
+            scratch = scratch.first(numFrames);
+
+        if (stream)
+            stream->read(*currentPromise_, first, scratch);
+        else
+            mapped_->read(first, scratch);
+        subtract1<int>(first, gathered);
+        return scratch;
+    };
+
     // interpolation processing
     const int quality = getCurrentSampleQuality();
+    const bool useAVX2 = interpolatorsUseAVX2();
 
     for (unsigned ptNo = 0; ptNo < numPartitions; ++ptNo) {
         // current partition
@@ -1259,8 +1405,23 @@ void Voice::Impl::fillWithData(AudioSpan<float> buffer) noexcept
         if (quality == 0 && pitchRatio_ * speedRatio_ <= 0.5f / float(resources_.getSynthConfig().OSFactor))
             mod = 0.5f / (pitchRatio_ * speedRatio_);
 
-        fillInterpolatedWithQuality<false>(
-            source, ptBuffer, ptIndices, ptCoeffs, {}, quality, mod);
+        if (gathering) {
+            absl::Span<int> ptGatherIndices = gatherIndices->subspan(ptStart, ptSize);
+            absl::c_copy(ptIndices, ptGatherIndices.begin());
+            const AudioSpan<const float> gathered = gatherFrames(ptGatherIndices);
+            if (gathered.getNumFrames() == 0)
+                ptBuffer.fill(0.0f);
+            else if (exactPositions)
+                fillExact<false>(gathered, ptBuffer, ptGatherIndices, {});
+            else
+                fillInterpolatedWithQuality<false>(
+                    gathered, ptBuffer, ptGatherIndices, ptCoeffs, {}, quality, mod, useAVX2);
+        } else if (exactPositions) {
+            fillExact<false>(source, ptBuffer, ptIndices, {});
+        } else {
+            fillInterpolatedWithQuality<false>(
+                source, ptBuffer, ptIndices, ptCoeffs, {}, quality, mod, useAVX2);
+        }
 
         if (ptType == kPartitionLoopXfade) {
             auto xfTemp1 = bufferPool.getBuffer(numSamples);
@@ -1349,8 +1510,23 @@ void Voice::Impl::fillWithData(AudioSpan<float> buffer) noexcept
                         xfCurve[i] = clamp(xfInCurvePos[i], 0.0f, 1.0f);
                 }
                 // apply in curve
-                fillInterpolatedWithQuality<true>(
-                    source, xfInBuffer, xfInIndices, xfInCoeffs, xfCurve, quality, mod);
+                if (!gathering) {
+                    if (exactPositions)
+                        fillExact<true>(source, xfInBuffer, xfInIndices, xfCurve);
+                    else
+                        fillInterpolatedWithQuality<true>(
+                            source, xfInBuffer, xfInIndices, xfInCoeffs, xfCurve, quality, mod, useAVX2);
+                }
+                else if (applySize > 0) {
+                    const AudioSpan<const float> gathered = gatherFrames(xfInIndices);
+                    if (gathered.getNumFrames() > 0) {
+                        if (exactPositions)
+                            fillExact<true>(gathered, xfInBuffer, xfInIndices, xfCurve);
+                        else
+                            fillInterpolatedWithQuality<true>(
+                                gathered, xfInBuffer, xfInIndices, xfInCoeffs, xfCurve, quality, mod, useAVX2);
+                    }
+                }
             }
         }
     }
@@ -1358,6 +1534,9 @@ void Voice::Impl::fillWithData(AudioSpan<float> buffer) noexcept
     sourcePosition_ = indices->back();
     floatPositionOffset_ = coeffs->back();
 
+    if (stream && stream->shouldRequestRefill())
+        resources_.getFilePool().requestStreamRefill(stream_, region_->sampleId);
+
 #if 1
     ASSERT(!hasNanInf(buffer.getConstSpan(0)));
     ASSERT(!hasNanInf(buffer.getConstSpan(1)));
@@ -1370,40 +1549,49 @@ template <InterpolatorModel M, bool Adding>
 void Voice::Impl::fillInterpolated(
     const AudioSpan<const float>& source, const AudioSpan<float>& dest,
     absl::Span<const int> indices, absl::Span<const float> coeffs,
-    absl::Span<const float> addingGains, float mod)
-{
-    auto* ind = indices.data();
-    auto* coeff = coeffs.data();
-    auto* addingGain = addingGains.data();
-    auto leftSource = source.getConstSpan(0);
-    auto left = dest.getChannel(0);
-    if (source.getNumChannels() == 1) {
-        while (ind < indices.end()) {
-            auto output = interpolate<M>(&leftSource[*ind], *coeff, mod);
-            IF_CONSTEXPR(Adding) {
-                float g = *addingGain++;
-                *left += g * output;
-            }
+    absl::Span<const float> addingGains, float mod, bool useAVX2)
+{
+    const float* rightSource = nullptr;
+    float* right = nullptr;
+    if (source.getNumChannels() > 1) {
+        rightSource = source.getConstSpan(1).data();
+        right = dest.getChannel(1);
+    }
+
+    interpolateBlock<M, Adding>(
+        source.getConstSpan(0).data(), rightSource, dest.getChannel(0), right,
+        indices.data(), coeffs.data(), addingGains.data(), indices.size(), mod, useAVX2);
+}
+
+template <bool Adding>
+void Voice::Impl::fillExact(
+    const AudioSpan<const float>& source, const AudioSpan<float>& dest,
+    absl::Span<const int> indices, absl::Span<const float> addingGains)
+{
+    const unsigned size = static_cast<unsigned>(indices.size());
+    if (size == 0)
+        return;
+
+    // the frames are usually consecutive, and then copied as a whole
+    bool consecutive = true;
+    for (unsigned i = 1; i < size && consecutive; ++i)
+        consecutive = indices[i] == indices[0] + static_cast<int>(i);
+
+    for (size_t c = 0, numChannels = source.getNumChannels(); c < numChannels; ++c) {
+        const float* input = source.getConstSpan(c).data();
+        float* output = dest.getChannel(c);
+        if (consecutive) {
+            IF_CONSTEXPR (Adding)
+                multiplyAdd<float>(addingGains.data(), &input[indices[0]], output, size);
             else
-                *left = output;
-            incrementAll(ind, left, coeff);
-        }
-    } else {
-        auto right = dest.getChannel(1);
-        auto rightSource = source.getConstSpan(1);
-        while (ind < indices.end()) {
-            auto leftOutput = interpolate<M>(&leftSource[*ind], *coeff, mod);
-            auto rightOutput = interpolate<M>(&rightSource[*ind], *coeff, mod);
-            IF_CONSTEXPR(Adding) {
-                float g = *addingGain++;
-                *left += g * leftOutput;
-                *right += g * rightOutput;
-            }
-            else {
-                *left = leftOutput;
-                *right = rightOutput;
+                copy<float>(&input[indices[0]], output, size);
+        } else {
+            for (unsigned i = 0; i < size; ++i) {
+                IF_CONSTEXPR (Adding)
+                    output[i] += addingGains[i] * input[indices[i]];
+                else
+                    output[i] = input[indices[i]];
             }
-            incrementAll(ind, left, right, coeff);
         }
     }
 }
@@ -1412,19 +1600,19 @@ template <bool Adding>
 void Voice::Impl::fillInterpolatedWithQuality(
     const AudioSpan<const float>& source, const AudioSpan<float>& dest,
     absl::Span<const int> indices, absl::Span<const float> coeffs,
-    absl::Span<const float> addingGains, int quality, float mod)
+    absl::Span<const float> addingGains, int quality, float mod, bool useAVX2)
 {
     switch (clamp(quality, 0, 10)) {
     case 0:
         {
             constexpr auto itp = kInterpolatorLoFi;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 1:
         {
             constexpr auto itp = kInterpolatorLinear;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 2:
@@ -1436,55 +1624,55 @@ void Voice::Impl::fillInterpolatedWithQuality(
             // Hermite polynomial, has less pass-band attenuation
             constexpr auto itp = kInterpolatorHermite3;
 #endif
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 3:
         {
             constexpr auto itp = kInterpolatorSinc8;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 4:
         {
             constexpr auto itp = kInterpolatorSinc12;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 5:
         {
             constexpr auto itp = kInterpolatorSinc16;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 6:
         {
             constexpr auto itp = kInterpolatorSinc24;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 7:
         {
             constexpr auto itp = kInterpolatorSinc36;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 8:
         {
             constexpr auto itp = kInterpolatorSinc48;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 9:
         {
             constexpr auto itp = kInterpolatorSinc60;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     case 10:
         {
             constexpr auto itp = kInterpolatorSinc72;
-            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod);
+            fillInterpolated<itp, Adding>(source, dest, indices, coeffs, addingGains, mod, useAVX2);
         }
         break;
     }
@@ -1510,20 +1698,11 @@ void Voice::Impl::fillWithGenerator(AudioSpan<float> buffer) noexcept
     const auto rightSpan  = buffer.getSpan(1);
 
     if (region_->sampleId->filename() == "*noise") {
-        auto gen = [&]() {
-            return uniformNoiseDist_(Random::randomGenerator);
-        };
-        absl::c_generate(leftSpan, gen);
-        absl::c_generate(rightSpan, gen);
+        noiseGenerator_.fillUniform(leftSpan, config::uniformNoiseBounds);
+        noiseGenerator_.fillUniform(rightSpan, config::uniformNoiseBounds);
     } else if (region_->sampleId->filename() == "*gnoise") {
-        // You need to wrap in a lambda, otherwise generate will
-        // make a copy of the gaussian distribution *along with its state*
-        // leading to periodic behavior....
-        auto gen = [&]() {
-            return gaussianNoiseDist_();
-        };
-        absl::c_generate(leftSpan, gen);
-        absl::c_generate(rightSpan, gen);
+        noiseGenerator_.fillGaussian(leftSpan, 0.0f, config::noiseVariance);
+        noiseGenerator_.fillGaussian(rightSpan, 0.0f, config::noiseVariance);
     } else {
         const size_t numFrames = buffer.getNumFrames();
 
@@ -1535,13 +1714,11 @@ void Voice::Impl::fillWithGenerator(AudioSpan<float> buffer) noexcept
             return;
 
         absl::Span<float> pitch = *frequencies; // temporary
-        pitchEnvelope(pitch);
+        const bool constantPitch = pitchEnvelope(pitch);
 
         const float keycenterFrequency = midiNoteFrequency(pitchKeycenter_);
         const float baseRatio = pitchRatio_ * keycenterFrequency;
-
-        for (size_t i = 0; i < numFrames; ++i)
-            (*frequencies)[i] = baseRatio * centsFactor(pitch[i]);
+        pitchRatios(pitch, constantPitch, baseRatio, *frequencies);
 
         auto detuneSpan = bufferPool.getBuffer(numFrames);
         if (!detuneSpan)
@@ -1566,36 +1743,15 @@ void Voice::Impl::fillWithGenerator(AudioSpan<float> buffer) noexcept
         }
         else if (oscillatorMode <= 0 && oscillatorMulti >= 3) {
             // unison oscillator
-            auto tempSpan = bufferPool.getBuffer(numFrames);
-            auto tempLeftSpan = bufferPool.getBuffer(numFrames);
-            auto tempRightSpan = bufferPool.getBuffer(numFrames);
-            if (!tempSpan || !tempLeftSpan || !tempRightSpan)
-                return;
-
             const float* detuneMod = modMatrix.getModulation(oscillatorDetuneTarget_);
-            for (unsigned u = 0, uSize = waveUnisonSize_; u < uSize; ++u) {
-                WavetableOscillator& osc = waveOscillators_[u];
-                osc.setQuality(quality);
-                if (!detuneMod)
-                    fill(*detuneSpan, waveDetuneRatio_[u]);
-                else {
-                    for (size_t i = 0; i < numFrames; ++i)
-                        (*detuneSpan)[i] = centsFactor(detuneMod[i]);
-                    applyGain1(waveDetuneRatio_[u], *detuneSpan);
-                }
-                osc.processModulated(frequencies->data(), detuneSpan->data(), tempSpan->data(), numFrames);
-                if (u == 0) {
-                    applyGain1<float>(waveLeftGain_[u], *tempSpan, *tempLeftSpan);
-                    applyGain1<float>(waveRightGain_[u], *tempSpan, *tempRightSpan);
-                }
-                else {
-                    multiplyAdd1<float>(waveLeftGain_[u], *tempSpan, *tempLeftSpan);
-                    multiplyAdd1<float>(waveRightGain_[u], *tempSpan, *tempRightSpan);
-                }
+            if (detuneMod) {
+                for (size_t i = 0; i < numFrames; ++i)
+                    (*detuneSpan)[i] = centsFactor(detuneMod[i]);
             }
-
-            copy<float>(*tempLeftSpan, leftSpan);
-            copy<float>(*tempRightSpan, rightSpan);
+            waveUnison_.setQuality(quality);
+            waveUnison_.processModulated(
+                frequencies->data(), detuneMod ? detuneSpan->data() : nullptr,
+                leftSpan.data(), rightSpan.data(), numFrames);
         }
         else {
             // modulated oscillator
@@ -1712,6 +1868,9 @@ void Voice::reset() noexcept
     impl.switchState(State::idle);
     impl.region_ = nullptr;
     impl.currentPromise_.reset();
+    impl.mapped_ = nullptr;
+    if (impl.stream_)
+        impl.stream_->detach();
     impl.sourcePosition_ = 0;
     impl.age_ = 0;
     impl.count_ = 1;
@@ -1729,7 +1888,7 @@ void Voice::reset() noexcept
 
     for (auto& eq : impl.equalizers_)
         eq.reset();
-    downsampleFilter.clear();
+    impl.decimator_.clear();
 
     removeVoiceFromRing();
 }
@@ -1745,6 +1904,17 @@ void Voice::Impl::resetLoopInformation() noexcept
     loop_.restarts = 0;
 }
 
+void Voice::Impl::updateGatherBuffer()
+{
+    if (stream_ || memoryMapping_) {
+        if (gatherBuffer_.getNumChannels() == 0)
+            gatherBuffer_.addChannels(2);
+        gatherBuffer_.resize(static_cast<size_t>(FileStream::ringFrames()));
+    } else {
+        gatherBuffer_ = FileAudioBuffer();
+    }
+}
+
 void Voice::Impl::updateLoopInformation() noexcept
 {
     if (!region_ || !currentPromise_)
@@ -1889,6 +2059,26 @@ void Voice::setAmplitudeLFOEnabledPerVoice(bool haveAmplitudeLFO)
         impl.lfoAmplitude_.reset();
 }
 
+void Voice::setDiskStreaming(bool streaming)
+{
+    Impl& impl = *impl_;
+    if (streaming) {
+        if (!impl.stream_)
+            impl.stream_ = std::make_shared<FileStream>();
+    }
+    else
+        impl.stream_.reset();
+
+    impl.updateGatherBuffer();
+}
+
+void Voice::setSampleMemoryMapping(bool mapping)
+{
+    Impl& impl = *impl_;
+    impl.memoryMapping_ = mapping;
+    impl.updateGatherBuffer();
+}
+
 void Voice::setPitchLFOEnabledPerVoice(bool havePitchLFO)
 {
     Impl& impl = *impl_;
@@ -1961,6 +2151,12 @@ void Voice::Impl::setupOscillatorUnison()
         waveRightGain_[i] = g;
     }
 
+    waveUnison_.resize(m);
+    for (int i = 0; i < m; ++i) {
+        waveUnison_.setDetuneRatio(i, waveDetuneRatio_[i]);
+        waveUnison_.setGains(i, waveLeftGain_[i], waveRightGain_[i]);
+    }
+
 #if 0
     fprintf(stderr, "\n");
     fprintf(stderr, "# Left:\n");
@@ -1986,9 +2182,11 @@ void Voice::Impl::switchState(State s)
     }
 }
 
-void Voice::Impl::pitchEnvelope(absl::Span<float> pitchSpan) noexcept
+bool Voice::Impl::pitchEnvelope(absl::Span<float> pitchSpan) noexcept
 {
     const size_t numFrames = pitchSpan.size();
+    if (numFrames == 0)
+        return true;
 
     const MidiState& midiState = resources_.getMidiState();
     const EventVector& events = midiState.getPitchEvents();
@@ -2002,10 +2200,33 @@ void Voice::Impl::pitchEnvelope(absl::Span<float> pitchSpan) noexcept
         linearEnvelope(events, pitchSpan, bendLambda);
     bendSmoother_.process(pitchSpan, pitchSpan);
 
+    // Without a bend event in the block, the bend is only moved by the smoother
+    bool constant = events.size() == 1
+        && allWithin<float>(pitchSpan, pitchSpan.front(), pitchSpan.front());
+
     ModMatrix& mm = resources_.getModMatrix();
 
-    if (float* mod = mm.getModulation(pitchTarget_))
+    if (float* mod = mm.getModulation(pitchTarget_)) {
+        constant = constant && allWithin<float>(mod, mod[0], mod[0], numFrames);
         add<float>(absl::MakeSpan(mod, numFrames), pitchSpan);
+    }
+
+    return constant;
+}
+
+void Voice::Impl::pitchRatios(absl::Span<float> pitchSpan, bool constantPitch, float baseRatio, absl::Span<float> ratios) noexcept
+{
+    if (pitchSpan.empty())
+        return;
+
+    if (constantPitch) {
+        fill<float>(ratios, baseRatio * centsFactor(pitchSpan.front()));
+        return;
+    }
+
+    applyGain1<float>(1.0f / 1200.0f, pitchSpan, pitchSpan);
+    sfz::exp2<float>(pitchSpan, ratios);
+    applyGain1<float>(baseRatio, ratios, ratios);
 }
 
 void Voice::Impl::resetSmoothers() noexcept
@@ -105,6 +105,13 @@ public:
      * @return int
      */
     int getSamplesPerBlock() const noexcept;
+    /**
+     * @brief Set whether the filters and equalizers of the region are applied
+     * by a shared submix, in which case the voice skips its filter stage.
+     *
+     * @param shared
+     */
+    void setFilterStageShared(bool shared) noexcept;
 
     /**
      * @brief Start playing a region after a short delay for different triggers (note on, off, cc)
@@ -358,6 +365,20 @@ public:
      * @param haveFilterLFO
      */
     void setFilterLFOEnabledPerVoice(bool haveFilterLFO);
+    /**
+     * @brief Set whether this voice streams its samples from disk, which
+     * allocates or frees its streaming ring.
+     *
+     * @param streaming
+     */
+    void setDiskStreaming(bool streaming);
+    /**
+     * @brief Set whether this voice reads the memory-mapped samples in place,
+     * which allocates or frees its gather buffer.
+     *
+     * @param mapping
+     */
+    void setSampleMemoryMapping(bool mapping);
     /**
      * @brief Release the voice after a given delay
      *
@@ -416,7 +437,6 @@ public:
      * @brief Get the trigger event
      */
     const TriggerEvent& getTriggerEvent();
-    sfz::Filter downsampleFilter;
 
     /**
      * @brief Get the extended CC values
@@ -0,0 +1,352 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "VoiceDecimator.h"
+#include "OversamplerHelpers.h"
+#include "SIMDConfig.h"
+#include "MathHelpers.h"
+#include "utility/Debug.h"
+#include <absl/memory/memory.h>
+#include <algorithm>
+#include <cstring>
+#if SFIZZ_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace sfz {
+
+namespace {
+
+/**
+ * @brief Coefficients of the half-band stage which takes a signal at `Factor`
+ * times the output rate down to half of it.
+ */
+template <int Factor> struct DecimatorStage;
+
+#define SFIZZ_DECIMATOR_STAGE(F)                                                \
+    template <> struct DecimatorStage<F> {                                      \
+        static constexpr int numCoeffs = sizeof(OSCoeffs##F##x) / sizeof(double); \
+        static const double* coeffs() noexcept { return OSCoeffs##F##x; }       \
+    }
+
+SFIZZ_DECIMATOR_STAGE(2);
+SFIZZ_DECIMATOR_STAGE(4);
+SFIZZ_DECIMATOR_STAGE(8);
+SFIZZ_DECIMATOR_STAGE(16);
+SFIZZ_DECIMATOR_STAGE(32);
+SFIZZ_DECIMATOR_STAGE(64);
+SFIZZ_DECIMATOR_STAGE(128);
+
+#undef SFIZZ_DECIMATOR_STAGE
+
+#if SFIZZ_HAVE_SSE2
+/**
+ * @brief A half-band stage which decimates both channels at once.
+ *
+ * This is the polyphase allpass structure of HIIR, with the vector lanes
+ * holding the left and right samples of the two polyphase paths:
+ * `{ L0, R0, L1, R1 }`. The allpass sections of the two paths are
+ * processed in pairs, and an odd last section only applies to path 0.
+ */
+template <int NC>
+class StereoHalfbandStage {
+public:
+    static constexpr int numSections = (NC + 1) / 2;
+
+    void setCoefs(const double* coefs) noexcept
+    {
+        for (int k = 0; k < numSections; ++k) {
+            const float c0 = static_cast<float>(coefs[2 * k]);
+            const float c1 = (2 * k + 1 < NC) ? static_cast<float>(coefs[2 * k + 1]) : 0.0f;
+            coefs_[k] = _mm_setr_ps(c0, c0, c1, c1);
+        }
+    }
+
+    void clear() noexcept
+    {
+        for (int k = 0; k < numSections; ++k) {
+            x_[k] = _mm_setzero_ps();
+            y_[k] = _mm_setzero_ps();
+        }
+    }
+
+    /**
+     * @brief Decimate `numFrames` stereo frames. The input is either two
+     * planar channels or interleaved stereo in `in0`, and same for the output.
+     * The interleaved output may overwrite the input it was computed from.
+     */
+    template <bool PlanarInput, bool PlanarOutput>
+    void process(const float* in0, const float* in1, float* out0, float* out1, long numFrames) noexcept
+    {
+        __m128 x[numSections];
+        __m128 y[numSections];
+        for (int k = 0; k < numSections; ++k) {
+            x[k] = x_[k];
+            y[k] = y_[k];
+        }
+
+        const __m128 oddMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, 0, 0));
+
+        for (long i = 0; i < numFrames; ++i) {
+            __m128 spl;
+            if (PlanarInput) {
+                // { L[2i], R[2i], L[2i+1], R[2i+1] } then swap the halves
+                const __m128 left = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in0 + 2 * i));
+                const __m128 right = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in1 + 2 * i));
+                const __m128 both = _mm_unpacklo_ps(left, right);
+                spl = _mm_shuffle_ps(both, both, _MM_SHUFFLE(1, 0, 3, 2));
+            } else {
+                const __m128 both = _mm_loadu_ps(in0 + 4 * i);
+                spl = _mm_shuffle_ps(both, both, _MM_SHUFFLE(1, 0, 3, 2));
+            }
+
+            for (int k = 0; k < numSections; ++k) {
+                const __m128 tmp = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(spl, y[k]), coefs_[k]), x[k]);
+                if (NC % 2 == 1 && k == numSections - 1) {
+                    x[k] = spl;
+                    y[k] = tmp;
+                    spl = _mm_or_ps(_mm_and_ps(oddMask, tmp), _mm_andnot_ps(oddMask, spl));
+                } else {
+                    x[k] = spl;
+                    y[k] = tmp;
+                    spl = tmp;
+                }
+            }
+
+            const __m128 sum = _mm_mul_ps(_mm_set1_ps(0.5f), _mm_add_ps(spl, _mm_movehl_ps(spl, spl)));
+            if (PlanarOutput) {
+                _mm_store_ss(out0 + i, sum);
+                _mm_store_ss(out1 + i, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+            } else {
+                _mm_storel_pi(reinterpret_cast<__m64*>(out0 + 2 * i), sum);
+            }
+        }
+
+        for (int k = 0; k < numSections; ++k) {
+            x_[k] = x[k];
+            y_[k] = y[k];
+        }
+    }
+
+private:
+    __m128 coefs_[numSections];
+    __m128 x_[numSections];
+    __m128 y_[numSections];
+};
+
+/**
+ * @brief A stereo chain of half-band stages from `Factor` down to 1.
+ * The first stage reads the planar channels and all the intermediate stages
+ * work interleaved and in place in the left channel buffer, which is allowed
+ * since every stage writes behind the position it reads.
+ */
+template <int Factor, bool PlanarInput>
+struct DecimatorChain {
+    DecimatorChain()
+    {
+        stage.setCoefs(DecimatorStage<Factor>::coeffs());
+        clear();
+    }
+
+    void clear() noexcept
+    {
+        stage.clear();
+        next.clear();
+    }
+
+    void process(float* left, float* right, float* outLeft, float* outRight, long numFrames) noexcept
+    {
+        stage.template process<PlanarInput, false>(left, right, left, nullptr, numFrames * (Factor / 2));
+        next.process(left, nullptr, outLeft, outRight, numFrames);
+    }
+
+    StereoHalfbandStage<DecimatorStage<Factor>::numCoeffs> stage;
+    DecimatorChain<Factor / 2, false> next;
+};
+
+template <bool PlanarInput>
+struct DecimatorChain<2, PlanarInput> {
+    DecimatorChain()
+    {
+        stage.setCoefs(DecimatorStage<2>::coeffs());
+        clear();
+    }
+
+    void clear() noexcept
+    {
+        stage.clear();
+    }
+
+    void process(float* left, float* right, float* outLeft, float* outRight, long numFrames) noexcept
+    {
+        stage.template process<PlanarInput, true>(left, right, outLeft, outRight, numFrames);
+    }
+
+    StereoHalfbandStage<DecimatorStage<2>::numCoeffs> stage;
+};
+
+template <int Factor>
+struct StereoDecimator {
+    void clear() noexcept { chain.clear(); }
+
+    void process(float* left, float* right, float* outLeft, float* outRight, long numFrames) noexcept
+    {
+        chain.process(left, right, outLeft, outRight, numFrames);
+    }
+
+    DecimatorChain<Factor, true> chain;
+};
+#else
+/**
+ * @brief A mono chain of half-band stages from `Factor` down to 1.
+ * All the stages but the last one run in place in the input buffer, which is
+ * allowed by HIIR since every stage writes behind the position it reads.
+ */
+template <int Factor>
+struct DecimatorChain {
+    DecimatorChain() { stage.set_coefs(DecimatorStage<Factor>::coeffs()); }
+
+    void clear() noexcept
+    {
+        stage.clear_buffers();
+        next.clear();
+    }
+
+    void process(float* input, float* output, long numFrames) noexcept
+    {
+        stage.process_block(input, input, numFrames * (Factor / 2));
+        next.process(input, output, numFrames);
+    }
+
+    hiir::Downsampler2x<DecimatorStage<Factor>::numCoeffs> stage;
+    DecimatorChain<Factor / 2> next;
+};
+
+template <>
+struct DecimatorChain<2> {
+    DecimatorChain() { stage.set_coefs(DecimatorStage<2>::coeffs()); }
+
+    void clear() noexcept
+    {
+        stage.clear_buffers();
+    }
+
+    void process(float* input, float* output, long numFrames) noexcept
+    {
+        stage.process_block(output, input, numFrames);
+    }
+
+    hiir::Downsampler2x<DecimatorStage<2>::numCoeffs> stage;
+};
+
+template <int Factor>
+struct StereoDecimator {
+    void clear() noexcept
+    {
+        chains[0].clear();
+        chains[1].clear();
+    }
+
+    void process(float* left, float* right, float* outLeft, float* outRight, long numFrames) noexcept
+    {
+        chains[0].process(left, outLeft, numFrames);
+        chains[1].process(right, outRight, numFrames);
+    }
+
+    DecimatorChain<Factor> chains[2];
+};
+#endif
+
+} // namespace
+
+struct VoiceDecimator::Cascade {
+    virtual ~Cascade() {}
+    virtual void clear() noexcept = 0;
+    virtual void process(float* left, float* right, float* outLeft, float* outRight, long numFrames) noexcept = 0;
+};
+
+template <int Factor>
+struct VoiceDecimator::CascadeImpl final : VoiceDecimator::Cascade {
+    void clear() noexcept override
+    {
+        decimator.clear();
+    }
+
+    void process(float* left, float* right, float* outLeft, float* outRight, long numFrames) noexcept override
+    {
+        decimator.process(left, right, outLeft, outRight, numFrames);
+    }
+
+    StereoDecimator<Factor> decimator;
+};
+
+VoiceDecimator::VoiceDecimator()
+{
+}
+
+VoiceDecimator::~VoiceDecimator()
+{
+}
+
+bool VoiceDecimator::canProcess(int factor) noexcept
+{
+    return factor >= 1 && factor <= 128 && (factor & (factor - 1)) == 0;
+}
+
+void VoiceDecimator::setFactor(int factor)
+{
+    if (!canProcess(factor)) {
+        DBG("[sfizz] Unsupported voice decimation factor: " << factor);
+        factor = std::min(128, static_cast<int>(nextPow2(static_cast<uint32_t>(std::max(1, factor)))));
+    }
+
+    if (factor == factor_ && (factor == 1 || cascade_))
+        return;
+
+    factor_ = factor;
+    switch (factor) {
+    case 2: cascade_ = absl::make_unique<CascadeImpl<2>>(); break;
+    case 4: cascade_ = absl::make_unique<CascadeImpl<4>>(); break;
+    case 8: cascade_ = absl::make_unique<CascadeImpl<8>>(); break;
+    case 16: cascade_ = absl::make_unique<CascadeImpl<16>>(); break;
+    case 32: cascade_ = absl::make_unique<CascadeImpl<32>>(); break;
+    case 64: cascade_ = absl::make_unique<CascadeImpl<64>>(); break;
+    case 128: cascade_ = absl::make_unique<CascadeImpl<128>>(); break;
+    default: cascade_.reset(); break;
+    }
+}
+
+void VoiceDecimator::clear() noexcept
+{
+    if (cascade_)
+        cascade_->clear();
+}
+
+void VoiceDecimator::process(AudioSpan<float> input, AudioSpan<float> output) noexcept
+{
+    const size_t numFrames = output.getNumFrames();
+    const size_t numChannels = std::min<size_t>(2, std::min(input.getNumChannels(), output.getNumChannels()));
+    ASSERT(input.getNumFrames() >= numFrames * static_cast<size_t>(factor_));
+
+    if (numFrames == 0)
+        return;
+
+    if (!cascade_) {
+        for (size_t c = 0; c < numChannels; ++c)
+            std::memcpy(output.getChannel(c), input.getChannel(c), numFrames * sizeof(float));
+        return;
+    }
+
+    if (numChannels < 2) {
+        DBG("[sfizz] The voice decimator expects stereo buffers");
+        return;
+    }
+
+    cascade_->process(input.getChannel(0), input.getChannel(1),
+        output.getChannel(0), output.getChannel(1), static_cast<long>(numFrames));
+}
+
+} // namespace sfz
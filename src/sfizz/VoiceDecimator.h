@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include "AudioSpan.h"
+#include <memory>
+
+namespace sfz {
+
+/**
+ * @brief Brings an oversampled stereo voice back to the output rate.
+ *
+ * The decimation is a cascade of polyphase half-band IIR stages, using the
+ * same HIIR designs as the oversampler of the effects. Each stage only
+ * computes the samples which it keeps, and the cascade is instantiated at
+ * compile time for every power-of-two factor up to 128.
+ */
+class VoiceDecimator {
+public:
+    VoiceDecimator();
+    ~VoiceDecimator();
+
+    /**
+     * @brief Set the decimation factor. This may allocate.
+     *
+     * @param factor a power of two between 1 and 128
+     */
+    void setFactor(int factor);
+
+    /**
+     * @brief Get the decimation factor
+     */
+    int getFactor() const noexcept { return factor_; }
+
+    /**
+     * @brief Reset the filter memories
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Decimate a stereo block. The input is used as scratch space and
+     * its content is undefined afterwards.
+     *
+     * @param input the oversampled input, of `factor` times the output frames
+     * @param output the decimated output
+     */
+    void process(AudioSpan<float> input, AudioSpan<float> output) noexcept;
+
+    /**
+     * @brief Check whether a factor is supported
+     */
+    static bool canProcess(int factor) noexcept;
+
+private:
+    struct Cascade;
+    template <int Factor> struct CascadeImpl;
+
+    int factor_ { 1 };
+    std::unique_ptr<Cascade> cascade_;
+};
+
+} // namespace sfz
@@ -18,7 +18,11 @@ void VoiceManager::onVoiceStateChanging(NumericId<Voice> id, Voice::State state)
         const Region* region = voice->getRegion();
         const uint32_t group = region->group;
         RegionSet::removeVoiceFromHierarchy(region, voice);
-        swapAndPopFirst(activeVoices_, [voice](const Voice* v) { return v == voice; });
+        // keep the order of the voices, which the voice stealers use
+        auto it = absl::c_find(activeVoices_, voice);
+        if (it != activeVoices_.end())
+            activeVoices_.erase(it);
+        indexVoiceEvents(voice, false);
         ASSERT(polyphonyGroups_.contains(group));
         polyphonyGroups_[group].removeVoice(voice);
     } else if (state == Voice::State::playing) {
@@ -26,12 +30,89 @@ void VoiceManager::onVoiceStateChanging(NumericId<Voice> id, Voice::State state)
         const Region* region = voice->getRegion();
         const uint32_t group = region->group;
         activeVoices_.push_back(voice);
+        indexVoiceEvents(voice, true);
         RegionSet::registerVoiceInHierarchy(region, voice);
         ASSERT(polyphonyGroups_.contains(group));
         polyphonyGroups_[group].registerVoice(voice);
     }
 }
 
+template <class Key>
+static void updateVoiceIndex(absl::flat_hash_map<Key, std::vector<Voice*>>& index, Key key, Voice* voice, bool active, size_t numVoices) noexcept
+{
+    if (active) {
+        std::vector<Voice*>& voices = index[key];
+        // the lists are iterated while voices start, they must not reallocate
+        if (voices.capacity() < numVoices)
+            voices.reserve(numVoices);
+        voices.push_back(voice);
+    } else {
+        auto it = index.find(key);
+        if (it != index.end())
+            swapAndPopFirst(it->second, [voice](const Voice* v) { return v == voice; });
+    }
+}
+
+void VoiceManager::indexVoiceEvents(Voice* voice, bool active) noexcept
+{
+    const Region* region = voice->getRegion();
+    if (region == nullptr)
+        return;
+
+    const TriggerEvent& event = voice->getTriggerEvent();
+    if ((event.type == TriggerEventType::NoteOn || event.type == TriggerEventType::NoteOff)
+        && event.number >= 0 && event.number < 128) {
+        std::vector<Voice*>& voices = noteVoices_[event.number];
+        if (active)
+            voices.push_back(voice);
+        else
+            swapAndPopFirst(voices, [voice](const Voice* v) { return v == voice; });
+    }
+
+    const size_t numVoices = list_.size();
+    updateVoiceIndex(pedalVoices_, static_cast<int>(region->sustainCC), voice, active, numVoices);
+    if (region->sostenutoCC != region->sustainCC)
+        updateVoiceIndex(pedalVoices_, static_cast<int>(region->sostenutoCC), voice, active, numVoices);
+
+    if (region->offBy)
+        updateVoiceIndex(offByVoices_, *region->offBy, voice, active, numVoices);
+}
+
+void VoiceManager::ensureEventIndexes(const Region& region) noexcept
+{
+    const size_t numVoices = static_cast<size_t>(getNumEffectiveVoices());
+    pedalVoices_[region.sustainCC].reserve(numVoices);
+    pedalVoices_[region.sostenutoCC].reserve(numVoices);
+    if (region.offBy)
+        offByVoices_[*region.offBy].reserve(numVoices);
+}
+
+absl::Span<Voice* const> VoiceManager::getVoicesOnNote(int noteNumber) const noexcept
+{
+    if (noteNumber < 0 || noteNumber >= 128)
+        return {};
+
+    return noteVoices_[noteNumber];
+}
+
+absl::Span<Voice* const> VoiceManager::getVoicesOnPedal(int ccNumber) const noexcept
+{
+    auto it = pedalVoices_.find(ccNumber);
+    if (it == pedalVoices_.end())
+        return {};
+
+    return it->second;
+}
+
+absl::Span<Voice* const> VoiceManager::getVoicesOffBy(int64_t group) const noexcept
+{
+    auto it = offByVoices_.find(group);
+    if (it == offByVoices_.end())
+        return {};
+
+    return it->second;
+}
+
 const Voice* VoiceManager::getVoiceById(NumericId<Voice> id) const noexcept
 {
     const size_t size = list_.size();
@@ -62,6 +143,8 @@ void VoiceManager::reset()
 
     polyphonyGroups_.clear();
     polyphonyGroups_.emplace(0, PolyphonyGroup{});
+    pedalVoices_.clear();
+    offByVoices_.clear();
     setStealingAlgorithm(StealingAlgorithm::Oldest);
 }
 
@@ -108,6 +191,12 @@ void VoiceManager::clear()
 {
     for (auto& pg : polyphonyGroups_)
         pg.second.removeAllVoices();
+    for (auto& voices : noteVoices_)
+        voices.clear();
+    for (auto& voices : pedalVoices_)
+        voices.second.clear();
+    for (auto& voices : offByVoices_)
+        voices.second.clear();
     list_.clear();
     activeVoices_.clear();
 }
@@ -167,6 +256,12 @@ void VoiceManager::requireNumVoices(int numVoices, Resources& resources)
     list_.reserve(numEffectiveVoices);
     temp_.reserve(numEffectiveVoices);
     activeVoices_.reserve(numEffectiveVoices);
+    for (auto& voices : noteVoices_)
+        voices.reserve(numEffectiveVoices);
+    for (auto& voices : pedalVoices_)
+        voices.second.reserve(numEffectiveVoices);
+    for (auto& voices : offByVoices_)
+        voices.second.reserve(numEffectiveVoices);
 
     for (int i = 0; i < numEffectiveVoices; ++i) {
         list_.emplace_back(i, resources);
@@ -207,9 +302,7 @@ void VoiceManager::checkNotePolyphony(const Region* region, int delay, const Tri
             return lhsTrigger.value < rhsTrigger.value;
         });
     } else if (region->selfMask == SelfMask::dontMask) {
-        absl::c_sort(temp_, [](const Voice* lhs, const Voice* rhs) {
-            return lhs->getAge() > rhs->getAge();
-        });
+        // the active voices are already ordered from the oldest
     } else {
         ASSERTFALSE;
     }
@@ -13,6 +13,8 @@
 #include "Resources.h"
 #include "Voice.h"
 #include "VoiceStealing.h"
+#include <absl/types/span.h>
+#include <array>
 #include <vector>
 
 namespace sfz {
@@ -72,6 +74,45 @@ struct VoiceManager final : public Voice::StateListener
      */
     void setGroupPolyphony(int groupIdx, unsigned polyphony) noexcept;
 
+    /**
+     * @brief Ensures that the voice indexes exist for the events which
+     * concern the voices of this region, so that starting a voice does not
+     * allocate. Call this for each new region.
+     *
+     * @param region
+     */
+    void ensureEventIndexes(const Region& region) noexcept;
+
+    /**
+     * @brief Get the active voices which were triggered by a note event
+     * of this number, which can be a note on or a note off.
+     *
+     * The voices started during the iteration of the result may be added at
+     * its end, outside of the span.
+     *
+     * @param noteNumber
+     * @return absl::Span<Voice* const>
+     */
+    absl::Span<Voice* const> getVoicesOnNote(int noteNumber) const noexcept;
+
+    /**
+     * @brief Get the active voices whose region uses this controller as
+     * sustain or sostenuto pedal.
+     *
+     * @param ccNumber
+     * @return absl::Span<Voice* const>
+     */
+    absl::Span<Voice* const> getVoicesOnPedal(int ccNumber) const noexcept;
+
+    /**
+     * @brief Get the active voices whose region can be turned off by the
+     * given group (`off_by`).
+     *
+     * @param group
+     * @return absl::Span<Voice* const>
+     */
+    absl::Span<Voice* const> getVoicesOffBy(int64_t group) const noexcept;
+
     /**
      * @brief Get a view into a given polyphony group
      *
@@ -136,10 +177,23 @@ private:
     int numRequiredVoices_ { config::numVoices };
     int getNumEffectiveVoices() const noexcept { return config::calculateActualVoices(numRequiredVoices_); }
     std::vector<Voice> list_;
+    // The active voices, in the order they started
     std::vector<Voice*> activeVoices_;
     std::vector<Voice*> temp_;
     // These are the `group=` groups where you can off voices
     absl::flat_hash_map<int, PolyphonyGroup> polyphonyGroups_;
+    // Indexes of the active voices by the events which concern them
+    std::array<std::vector<Voice*>, 128> noteVoices_;
+    absl::flat_hash_map<int, std::vector<Voice*>> pedalVoices_;
+    absl::flat_hash_map<int64_t, std::vector<Voice*>> offByVoices_;
+
+    /**
+     * @brief Add or remove a voice from the event indexes
+     *
+     * @param voice
+     * @param active
+     */
+    void indexVoiceEvents(Voice* voice, bool active) noexcept;
     std::unique_ptr<VoiceStealer> stealer_ { absl::make_unique<OldestStealer>() };
 
     /**
@@ -18,6 +18,10 @@ namespace sfz {
 template<class F, class G>
 Voice* genericPolyphonyCheck(absl::Span<Voice*> candidates, unsigned polyphony, F&& voiceCond, G&& candidateCond)
 {
+    // the candidates include the voices which are not counted
+    if (candidates.size() < polyphony)
+        return {};
+
     Voice* candidate = nullptr;
     unsigned numPlaying = 0;
     for (const auto& voice : candidates) {
@@ -60,19 +64,20 @@ Voice* FirstStealer::checkPolyphony(absl::Span<Voice*> candidates, unsigned maxP
         [=](const Voice*, const Voice* c) { return c == nullptr; });
 }
 
+// The candidates are ordered from the oldest, so the first one is kept
 Voice* OldestStealer::checkRegionPolyphony(const Region* region, absl::Span<Voice*> candidates)
 {
     ASSERT(region);
     return genericPolyphonyCheck(candidates, region->polyphony,
         [=](const Voice* v) { return (!ignoreVoice(v) && v->getRegion() == region); },
-        [=](const Voice* v, const Voice* c) { return (c == nullptr || v->getAge() > c->getAge()); });
+        [=](const Voice*, const Voice* c) { return c == nullptr; });
 }
 
 Voice* OldestStealer::checkPolyphony(absl::Span<Voice*> candidates, unsigned maxPolyphony)
 {
     return genericPolyphonyCheck(candidates, maxPolyphony,
         [=](const Voice* v) { return (!ignoreVoice(v)); },
-        [=](const Voice* v, const Voice* c) { return (c == nullptr || v->getAge() > c->getAge()); });
+        [=](const Voice*, const Voice* c) { return c == nullptr; });
 }
 
 /**
@@ -84,80 +89,77 @@ Voice* OldestStealer::checkPolyphony(absl::Span<Voice*> candidates, unsigned max
  * their sound, but it's reasonable for sounds with a quick attack and longer
  * release.
  *
- * @param voices
+ * The candidates are ordered from the oldest, and the sister voices are next
+ * to each other since they start together.
+ *
+ * @param candidates
+ * @param polyphony
+ * @param voiceCond a functor with signature bool(Voice* voice)
  * @return sfz::Voice*
  */
-sfz::Voice* stealEnvelopeAndAge(absl::Span<Voice*> voices) noexcept
+template<class F>
+sfz::Voice* stealEnvelopeAndAge(absl::Span<Voice*> candidates, unsigned polyphony, F&& voiceCond) noexcept
 {
-    absl::c_sort(voices, voiceOrdering);
+    if (candidates.size() < polyphony)
+        return {};
 
-    const auto sumPower = absl::c_accumulate(voices, 0.0f, [](float sum, const Voice* v) {
-        return sum + v->getAveragePower();
-    });
+    Voice* oldest = nullptr;
+    unsigned numPlaying = 0;
+    float sumPower = 0.0f;
+    for (Voice* voice : candidates) {
+        if (voiceCond(voice)) {
+            if (oldest == nullptr)
+                oldest = voice;
+            sumPower += voice->getAveragePower();
+            numPlaying += 1;
+        }
+    }
+
+    if (oldest == nullptr || numPlaying < polyphony)
+        return {};
 
     const auto powerThreshold = sumPower
-        / static_cast<float>(voices.size()) * config::stealingPowerCoeff;
+        / static_cast<float>(numPlaying) * config::stealingPowerCoeff;
     const auto ageThreshold =
-        static_cast<int>(voices.front()->getAge() * config::stealingAgeCoeff);
+        static_cast<int>(oldest->getAge() * config::stealingAgeCoeff);
 
-    Voice* returnedVoice = voices.front();
-    unsigned idx = 0;
-    while (idx < voices.size()) {
-        const auto ref = voices[idx];
+    const Voice* ref = nullptr;
+    for (Voice* voice : candidates) {
+        // Jump over the sister voices in the set
+        if (!voiceCond(voice) || (ref && sisterVoices(ref, voice)))
+            continue;
 
+        ref = voice;
         if (ref->getAge() <= ageThreshold) {
             // Went too far, we'll kill the oldest note.
             break;
         }
 
         float maxPower { 0.0f };
-        SisterVoiceRing::applyToRing(ref, [&](Voice* v) {
+        SisterVoiceRing::applyToRing(voice, [&](Voice* v) {
             maxPower = max(maxPower, v->getAveragePower());
         });
 
-        if (maxPower < powerThreshold) {
-            returnedVoice = ref;
-            break;
-        }
-
-        // Jump over the sister voices in the set
-        do { idx++; }
-        while (idx < voices.size() && sisterVoices(ref, voices[idx]));
+        if (maxPower < powerThreshold)
+            return voice;
     }
 
-    return returnedVoice;
+    return oldest;
 }
 
 Voice* EnvelopeAndAgeStealer::checkRegionPolyphony(const Region* region, absl::Span<Voice*> candidates)
 {
     ASSERT(region);
-    temp_.clear();
-    absl::c_copy_if(candidates, std::back_inserter(temp_), [=](Voice* v) {
-            return (!ignoreVoice(v) && v->getRegion() == region);
+    return stealEnvelopeAndAge(candidates, region->polyphony, [=](const Voice* v) {
+        return (!ignoreVoice(v) && v->getRegion() == region);
     });
-
-    if (temp_.size() >= region->polyphony)
-        return stealEnvelopeAndAge(absl::MakeSpan(temp_));
-
-    return {};
 }
 
 Voice* EnvelopeAndAgeStealer::checkPolyphony(absl::Span<Voice*> candidates, unsigned maxPolyphony)
 {
-    temp_.clear();
-    absl::c_copy_if(candidates, std::back_inserter(temp_), [=](Voice* v) {
-            return !ignoreVoice(v);
+    return stealEnvelopeAndAge(candidates, maxPolyphony, [=](const Voice* v) {
+        return !ignoreVoice(v);
     });
-
-    if (temp_.size() >= maxPolyphony)
-        return stealEnvelopeAndAge(absl::MakeSpan(temp_));
-
-    return {};
-}
-
-EnvelopeAndAgeStealer::EnvelopeAndAgeStealer()
-{
-    temp_.reserve(config::maxVoices);
 }
 
 }
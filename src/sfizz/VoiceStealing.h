@@ -22,6 +22,13 @@ enum class StealingAlgorithm {
     EnvelopeAndAge
 };
 
+/**
+ * @brief A voice stealing algorithm.
+ *
+ * The candidates are given in the order the voices started, from the oldest.
+ * Since all the active voices age together, this order does not change as
+ * they play, and the stealers use it instead of sorting the candidates.
+ */
 class VoiceStealer
 {
 public:
@@ -61,11 +68,8 @@ public:
 class EnvelopeAndAgeStealer final : public VoiceStealer
 {
 public:
-    EnvelopeAndAgeStealer();
     Voice* checkRegionPolyphony(const Region* region, absl::Span<Voice*> candidates) final;
     Voice* checkPolyphony(absl::Span<Voice*> candidates, unsigned maxPolyphony) final;
-private:
-    std::vector<Voice*> temp_;
 };
 
 }
@@ -10,6 +10,11 @@
 #include "MathHelpers.h"
 #include "absl/meta/type_traits.h"
 #include <kiss_fftr.h>
+#include <algorithm>
+#include <iterator>
+#if SIMDE_NATURAL_VECTOR_SIZE_GE(128)
+#include <simde/x86/sse2.h>
+#endif
 
 namespace sfz {
 
@@ -183,6 +188,262 @@ void WavetableOscillator::processModulated(const float* frequencies, const float
     }
 }
 
+//------------------------------------------------------------------------------
+constexpr unsigned WavetableUnison::maxSize;
+
+void WavetableUnison::init(double sampleRate)
+{
+    _sampleInterval = 1.0 / sampleRate;
+    _multi = WavetableMulti::getSilenceWavetable();
+    clear();
+}
+
+void WavetableUnison::clear()
+{
+    std::fill(std::begin(_phases), std::end(_phases), 0.0f);
+}
+
+void WavetableUnison::setWavetable(const WavetableMulti* wave)
+{
+    _multi = wave ? wave : WavetableMulti::getSilenceWavetable();
+}
+
+void WavetableUnison::setPhase(float phase)
+{
+    ASSERT(phase >= 0.0f && phase <= 1.0f);
+    std::fill(std::begin(_phases), std::end(_phases), phase);
+}
+
+void WavetableUnison::resize(unsigned size)
+{
+    ASSERT(size <= maxSize);
+    size = std::min<unsigned>(size, maxSize);
+
+    // the unused lanes are also computed, silently
+    for (unsigned i = std::min(_size, size); i < maxSize; ++i) {
+        _detuneRatios[i] = 1.0f;
+        _leftGains[i] = 0.0f;
+        _rightGains[i] = 0.0f;
+    }
+
+    _size = size;
+}
+
+void WavetableUnison::setDetuneRatio(unsigned index, float ratio)
+{
+    ASSERT(index < _size);
+    _detuneRatios[index] = ratio;
+}
+
+void WavetableUnison::setGains(unsigned index, float left, float right)
+{
+    ASSERT(index < _size);
+    _leftGains[index] = left;
+    _rightGains[index] = right;
+}
+
+#if SIMDE_NATURAL_VECTOR_SIZE_GE(128)
+/**
+   Interpolation of 4 lanes at once, from the points at offsets -1 to 2 of
+   each lane, which are transposed such as `x[k]` holds the offset `k - 1`.
+   These are equivalent to `Interpolator` in a single lane.
+ */
+template <InterpolatorModel M>
+struct LaneInterpolator;
+
+template <>
+struct LaneInterpolator<kInterpolatorNearest> {
+    static inline simde__m128 process(const simde__m128 (&x)[4], simde__m128 coeff)
+    {
+        const simde__m128 mask = simde_mm_cmpgt_ps(coeff, simde_mm_set1_ps(0.5f));
+        return simde_mm_or_ps(simde_mm_and_ps(mask, x[2]), simde_mm_andnot_ps(mask, x[1]));
+    }
+};
+
+template <>
+struct LaneInterpolator<kInterpolatorLinear> {
+    static inline simde__m128 process(const simde__m128 (&x)[4], simde__m128 coeff)
+    {
+        const simde__m128 y0 = simde_mm_mul_ps(x[1], simde_mm_sub_ps(simde_mm_set1_ps(1.0f), coeff));
+        return simde_mm_add_ps(y0, simde_mm_mul_ps(x[2], coeff));
+    }
+};
+
+template <>
+struct LaneInterpolator<kInterpolatorHermite3> {
+    static inline simde__m128 process(const simde__m128 (&x)[4], simde__m128 coeff)
+    {
+        // the polynomials `hermite3` at offsets -1 to 2, expanded on the
+        // interval [0, 1) of the coefficient
+        const simde__m128 c = coeff;
+        const simde__m128 c2 = simde_mm_mul_ps(c, c);
+        const simde__m128 c3 = simde_mm_mul_ps(c2, c);
+        const simde__m128 half = simde_mm_set1_ps(0.5f);
+        const simde__m128 h0 = simde_mm_sub_ps(c2, simde_mm_mul_ps(half, simde_mm_add_ps(c3, c)));
+        const simde__m128 h1 = simde_mm_add_ps(simde_mm_set1_ps(1.0f), simde_mm_sub_ps(
+            simde_mm_mul_ps(simde_mm_set1_ps(1.5f), c3), simde_mm_mul_ps(simde_mm_set1_ps(2.5f), c2)));
+        const simde__m128 h2 = simde_mm_add_ps(simde_mm_mul_ps(half, c), simde_mm_sub_ps(
+            simde_mm_mul_ps(simde_mm_set1_ps(2.0f), c2), simde_mm_mul_ps(simde_mm_set1_ps(1.5f), c3)));
+        const simde__m128 h3 = simde_mm_mul_ps(half, simde_mm_sub_ps(c3, c2));
+        simde__m128 y = simde_mm_mul_ps(h0, x[0]);
+        y = simde_mm_add_ps(y, simde_mm_mul_ps(h1, x[1]));
+        y = simde_mm_add_ps(y, simde_mm_mul_ps(h2, x[2]));
+        y = simde_mm_add_ps(y, simde_mm_mul_ps(h3, x[3]));
+        return y;
+    }
+};
+
+/**
+   Load the points around the indices of 4 lanes, and transpose them.
+ */
+static inline void loadLanePoints(const float* table, const int* indices, simde__m128 (&x)[4])
+{
+    x[0] = simde_mm_loadu_ps(table + indices[0] - 1);
+    x[1] = simde_mm_loadu_ps(table + indices[1] - 1);
+    x[2] = simde_mm_loadu_ps(table + indices[2] - 1);
+    x[3] = simde_mm_loadu_ps(table + indices[3] - 1);
+    SIMDE_MM_TRANSPOSE4_PS(x[0], x[1], x[2], x[3]);
+}
+
+template <InterpolatorModel M, bool Dual>
+void WavetableUnison::processModulatedLanes(const float* frequencies, const float* detuneRatios, float* left, float* right, unsigned nframes)
+{
+    constexpr unsigned numLanes = 4;
+    const unsigned numPacks = (_size + numLanes - 1) / numLanes;
+
+    const WavetableMulti& multi = *_multi;
+    const simde__m128 tableSize = simde_mm_set1_ps(static_cast<float>(multi.tableSize()));
+    const simde__m128 sampleInterval = simde_mm_set1_ps(_sampleInterval);
+    const simde__m128 zero = simde_mm_setzero_ps();
+    const simde__m128 one = simde_mm_set1_ps(1.0f);
+
+    simde__m128 phases[maxSize / numLanes];
+    for (unsigned p = 0; p < numPacks; ++p)
+        phases[p] = simde_mm_loadu_ps(&_phases[p * numLanes]);
+
+    for (unsigned i = 0; i < nframes; ++i) {
+        const float frequency = frequencies[i];
+        const simde__m128 commonRatio = simde_mm_set1_ps(detuneRatios ? detuneRatios[i] : 1.0f);
+
+        // all the members read the table of the base frequency
+        WavetableMulti::DualTable dt;
+        if (Dual)
+            dt = multi.getInterpolationPairForFrequency(frequency);
+        else {
+            dt.table1 = multi.getTableForFrequency(frequency).data();
+            dt.table2 = nullptr;
+            dt.delta = 0.0f;
+        }
+
+        simde__m128 sumLeft = zero;
+        simde__m128 sumRight = zero;
+
+        for (unsigned p = 0; p < numPacks; ++p) {
+            simde__m128 phase = phases[p];
+
+            const simde__m128 position = simde_mm_mul_ps(phase, tableSize);
+            const simde__m128i index = simde_mm_cvttps_epi32(position);
+            const simde__m128 frac = simde_mm_sub_ps(position, simde_mm_cvtepi32_ps(index));
+            int indices[numLanes];
+            simde_mm_storeu_si128(reinterpret_cast<simde__m128i*>(indices), index);
+
+            simde__m128 x[4];
+            loadLanePoints(dt.table1, indices, x);
+            simde__m128 y = LaneInterpolator<M>::process(x, frac);
+            if (Dual) {
+                loadLanePoints(dt.table2, indices, x);
+                const simde__m128 y2 = LaneInterpolator<M>::process(x, frac);
+                y = simde_mm_add_ps(
+                    simde_mm_mul_ps(simde_mm_set1_ps(1 - dt.delta), y),
+                    simde_mm_mul_ps(simde_mm_set1_ps(dt.delta), y2));
+            }
+
+            const unsigned lane = p * numLanes;
+            sumLeft = simde_mm_add_ps(sumLeft, simde_mm_mul_ps(simde_mm_loadu_ps(&_leftGains[lane]), y));
+            sumRight = simde_mm_add_ps(sumRight, simde_mm_mul_ps(simde_mm_loadu_ps(&_rightGains[lane]), y));
+
+            // increment and wrap, like the single oscillator
+            const simde__m128 detune = simde_mm_mul_ps(simde_mm_loadu_ps(&_detuneRatios[lane]), commonRatio);
+            const simde__m128 phaseInc = simde_mm_mul_ps(simde_mm_set1_ps(frequency), simde_mm_mul_ps(detune, sampleInterval));
+            phase = simde_mm_add_ps(phase, phaseInc);
+            phase = simde_mm_sub_ps(phase, simde_mm_cvtepi32_ps(simde_mm_cvttps_epi32(phase)));
+            phase = simde_mm_add_ps(phase, simde_mm_and_ps(simde_mm_cmplt_ps(phase, zero), one));
+            phases[p] = phase;
+        }
+
+        left[i] = simde_vaddvq_f32(sumLeft);
+        right[i] = simde_vaddvq_f32(sumRight);
+    }
+
+    for (unsigned p = 0; p < numPacks; ++p)
+        simde_mm_storeu_ps(&_phases[p * numLanes], phases[p]);
+}
+#else
+template <InterpolatorModel M, bool Dual>
+void WavetableUnison::processModulatedLanes(const float* frequencies, const float* detuneRatios, float* left, float* right, unsigned nframes)
+{
+    const WavetableMulti& multi = *_multi;
+    const unsigned tableSize = multi.tableSize();
+    const float sampleInterval = _sampleInterval;
+
+    for (unsigned i = 0; i < nframes; ++i) {
+        const float frequency = frequencies[i];
+        const float commonRatio = detuneRatios ? detuneRatios[i] : 1.0f;
+
+        WavetableMulti::DualTable dt;
+        if (Dual)
+            dt = multi.getInterpolationPairForFrequency(frequency);
+        else {
+            dt.table1 = multi.getTableForFrequency(frequency).data();
+            dt.table2 = nullptr;
+            dt.delta = 0.0f;
+        }
+
+        float sumLeft = 0.0f;
+        float sumRight = 0.0f;
+
+        for (unsigned u = 0; u < _size; ++u) {
+            const float phase = _phases[u];
+            const float position = phase * tableSize;
+            const unsigned index = static_cast<unsigned>(position);
+            const float frac = position - index;
+            float y = interpolate<M>(&dt.table1[index], frac, 1.0);
+            if (Dual)
+                y = (1 - dt.delta) * y + dt.delta * interpolate<M>(&dt.table2[index], frac, 1.0);
+
+            sumLeft += _leftGains[u] * y;
+            sumRight += _rightGains[u] * y;
+
+            const float phaseInc = frequency * ((_detuneRatios[u] * commonRatio) * sampleInterval);
+            _phases[u] = incrementAndWrap(phase, phaseInc);
+        }
+
+        left[i] = sumLeft;
+        right[i] = sumRight;
+    }
+}
+#endif
+
+void WavetableUnison::processModulated(const float* frequencies, const float* detuneRatios, float* left, float* right, unsigned nframes)
+{
+    int quality = clamp(_quality, 0, 3);
+
+    switch (quality) {
+    case 0:
+        processModulatedLanes<kInterpolatorNearest, false>(frequencies, detuneRatios, left, right, nframes);
+        break;
+    case 1:
+        processModulatedLanes<kInterpolatorLinear, false>(frequencies, detuneRatios, left, right, nframes);
+        break;
+    case 2:
+        processModulatedLanes<kInterpolatorHermite3, false>(frequencies, detuneRatios, left, right, nframes);
+        break;
+    case 3:
+        processModulatedLanes<kInterpolatorHermite3, true>(frequencies, detuneRatios, left, right, nframes);
+        break;
+    }
+}
+
 //------------------------------------------------------------------------------
 void HarmonicProfile::generate(
     absl::Span<float> table, double amplitude, double cutoff) const
@@ -525,10 +786,10 @@ bool WavetablePool::createFileWave(FilePool& filePool, const std::string& filena
     if (fileHandle->information.numChannels > 1)
         DBG("[sfizz] Only the first channel of " << filename << " will be used to create the wavetable");
 
-    auto audioData = fileHandle->preloadedData.getConstSpan(0);
+    auto audioData = fileHandle->getPreloadedData().getConstSpan(0);
 
     // an even size is required for FFT
-    static_assert(absl::remove_reference_t<decltype(fileHandle->preloadedData)>::PaddingRight > 0,
+    static_assert(FileAudioBuffer::PaddingRight > 0,
                   "Right padding is required on the audio file buffer");
     if (audioData.size() & 1)
         audioData = absl::MakeConstSpan(audioData.data(), audioData.size() + 1);
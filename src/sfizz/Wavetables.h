@@ -94,6 +94,98 @@ private:
     LEAK_DETECTOR(WavetableOscillator);
 };
 
+/**
+   A bank of detuned wavetable oscillators playing in unison, mixed in stereo.
+
+   The members play the same wavetable and they share the mipmap selected for
+   the base frequency. They are processed together in SIMD lanes: the phases
+   advance in parallel, each table is read once per frame for all the
+   members, and the results are summed directly into the stereo outputs.
+   Each member gives the same signal as a `WavetableOscillator` with the same
+   settings.
+ */
+class WavetableUnison {
+public:
+    // maximum number of members, rounded to a multiple of the SIMD lanes
+    static constexpr unsigned maxSize = (config::oscillatorsPerVoice + 3) / 4 * 4;
+
+    /**
+       Initialize with the given sample rate.
+       Run it once after instantiating.
+     */
+    void init(double sampleRate);
+
+    /**
+       Reset the oscillation of all the members to the initial phase.
+     */
+    void clear();
+
+    /**
+       Set the wavetable to generate with this unison.
+     */
+    void setWavetable(const WavetableMulti* wave);
+
+    /**
+       Set the current phase of all the members, between 0 and 1 excluded.
+     */
+    void setPhase(float phase);
+
+    /**
+       Set the quality of the oscillators. (cf. `WavetableOscillator::setQuality`)
+     */
+    void setQuality(int q) { _quality = q; }
+
+    /**
+       Get the quality of the oscillators.
+     */
+    int quality() const { return _quality; }
+
+    /**
+       Get the number of members of the unison.
+     */
+    unsigned size() const { return _size; }
+
+    /**
+       Set the number of members of the unison, up to `maxSize`.
+       The new members have a unit detune ratio and null gains.
+     */
+    void resize(unsigned size);
+
+    /**
+       Set the detune ratio of a member, relative to the base frequency.
+     */
+    void setDetuneRatio(unsigned index, float ratio);
+
+    /**
+       Set the stereo gains of a member.
+     */
+    void setGains(unsigned index, float left, float right);
+
+    /**
+       Compute a cycle of the unison, with varying frequency, and write the
+       mix of the members into the stereo outputs.
+       `detuneRatios` is a common detune applied to all the members, and it
+       may be null.
+     */
+    void processModulated(const float* frequencies, const float* detuneRatios, float* left, float* right, unsigned nframes);
+
+private:
+    template <InterpolatorModel M, bool Dual>
+    void processModulatedLanes(const float* frequencies, const float* detuneRatios, float* left, float* right, unsigned nframes);
+
+private:
+    // member states, as structures of arrays
+    float _phases[maxSize] {};
+    float _detuneRatios[maxSize] {};
+    float _leftGains[maxSize] {};
+    float _rightGains[maxSize] {};
+    unsigned _size = 0;
+    float _sampleInterval = 0.0f;
+    const WavetableMulti* _multi = nullptr;
+    int _quality = 1;
+    LEAK_DETECTOR(WavetableUnison);
+};
+
 /**
    A description of the harmonics of a particular wave form
  */
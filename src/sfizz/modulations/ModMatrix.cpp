@@ -11,6 +11,7 @@
 #include "Buffer.h"
 #include "Config.h"
 #include "SIMDHelpers.h"
+#include "RenderPool.h"
 #include "utility/Debug.h"
 #include <absl/container/flat_hash_map.h>
 #include <absl/strings/string_view.h>
@@ -24,15 +25,32 @@ struct ModMatrix::Impl {
     uint32_t samplesPerBlock_ {};
 
     uint32_t numFrames_ {};
-    NumericId<Voice> currentVoiceId_ {};
-    NumericId<Region> currentRegionId_ {};
 
-    float currentVoiceTriggerValue_ {};
+    // the voice being processed, one per render worker
+    struct VoiceContext {
+        NumericId<Voice> voiceId {};
+        NumericId<Region> regionId {};
+        float triggerValue {};
+        // the source depths of a connection with a depth modulation
+        Buffer<float> depthBuffer;
+    };
+
+    std::vector<VoiceContext> voiceContexts_ { 1 };
 
+    VoiceContext& currentVoiceContext() noexcept
+    {
+        const unsigned workerIndex = RenderPool::currentWorkerIndex();
+        ASSERT(workerIndex < voiceContexts_.size());
+        return voiceContexts_[workerIndex];
+    }
+
+    // The buffers are ready when their epoch is the current one of their
+    // scope, so that starting a cycle or a voice does not reset any flag
     struct Source {
         ModKey key;
         ModGenerator* gen {};
-        bool bufferReady {};
+        uint32_t epochSlot {};
+        uint64_t readyEpoch {};
         Buffer<float> buffer;
     };
 
@@ -43,11 +61,29 @@ struct ModMatrix::Impl {
         float velToDepth_ {};
     };
 
+    // A connection compiled for the target it modulates
+    struct Operation {
+        uint32_t source {};
+        // the region of a per-voice source, which is used only by its voices
+        NumericId<Region> sourceRegion {};
+        TargetId sourceDepthModId {};
+        float sourceDepth {};
+        float velToDepth {};
+    };
+
     struct Target {
         ModKey key;
         uint32_t region {};
         absl::flat_hash_map<uint32_t, ConnectionData> connectedSources;
-        bool bufferReady {};
+        uint32_t epochSlot {};
+        uint64_t readyEpoch {};
+        bool multiplicative {};
+        // the operations of the target, and the targets to evaluate before
+        // it in the compiled program
+        uint32_t operationsBegin {};
+        uint32_t operationsEnd {};
+        uint32_t dependenciesBegin {};
+        uint32_t dependenciesEnd {};
         Buffer<float> buffer;
     };
 
@@ -63,6 +99,42 @@ struct ModMatrix::Impl {
 
     std::vector<Source> sources_;
     std::vector<Target> targets_;
+
+    // The epoch of the cycle, followed by the one of each region, which
+    // advance as the cycles and the voices begin
+    std::vector<uint64_t> epochs_ { 1 };
+
+    // The program compiled by `init`: the operations of the targets, and for
+    // each target, the targets it depends on in topological order, followed
+    // by itself
+    std::vector<Operation> operations_;
+    std::vector<uint32_t> dependencies_;
+
+    static uint32_t epochSlot(const ModKey& key) noexcept
+    {
+        return (key.flags() & kModIsPerVoice) ? (key.region().number() + 1) : 0;
+    }
+
+    template <class T>
+    bool isReady(const T& item) const noexcept
+    {
+        return item.readyEpoch == epochs_[item.epochSlot];
+    }
+
+    template <class T>
+    void setReady(T& item) noexcept
+    {
+        item.readyEpoch = epochs_[item.epochSlot];
+    }
+
+    bool isAccessible(const Target& target, NumericId<Region> regionId) const noexcept
+    {
+        // only accept per-voice targets of the same region
+        return !(target.key.flags() & kModIsPerVoice) || regionId == target.key.region();
+    }
+
+    void collectDependencies(uint32_t targetIndex, std::vector<bool>& visited);
+    void evaluate(Target& target, VoiceContext& context) noexcept;
 };
 
 ModMatrix::ModMatrix()
@@ -89,6 +161,9 @@ void ModMatrix::clear()
     impl.sourceIndicesForRegion_.clear();
     impl.targetIndicesForRegion_.clear();
     impl.maxRegionIdx_ = -1;
+    impl.epochs_.assign(1, 1);
+    impl.operations_.clear();
+    impl.dependencies_.clear();
 }
 
 void ModMatrix::setSampleRate(double sampleRate)
@@ -104,6 +179,15 @@ void ModMatrix::setSampleRate(double sampleRate)
         source.gen->setSampleRate(sampleRate);
 }
 
+void ModMatrix::setNumWorkers(unsigned numWorkers)
+{
+    Impl& impl = *impl_;
+    impl.voiceContexts_.resize(std::max(1u, numWorkers));
+
+    for (Impl::VoiceContext& context : impl.voiceContexts_)
+        context.depthBuffer.resize(impl.samplesPerBlock_);
+}
+
 void ModMatrix::setSamplesPerBlock(unsigned samplesPerBlock)
 {
     Impl& impl = *impl_;
@@ -119,6 +203,8 @@ void ModMatrix::setSamplesPerBlock(unsigned samplesPerBlock)
     }
     for (Impl::Target &target : impl.targets_)
         target.buffer.resize(samplesPerBlock);
+    for (Impl::VoiceContext& context : impl.voiceContexts_)
+        context.depthBuffer.resize(samplesPerBlock);
 }
 
 ModMatrix::SourceId ModMatrix::registerSource(const ModKey& key, ModGenerator& gen)
@@ -137,7 +223,7 @@ ModMatrix::SourceId ModMatrix::registerSource(const ModKey& key, ModGenerator& g
     Impl::Source &source = impl.sources_.back();
     source.key = key;
     source.gen = &gen;
-    source.bufferReady = false;
+    source.epochSlot = Impl::epochSlot(key);
     source.buffer.resize(impl.samplesPerBlock_);
 
     impl.sourceIndex_[key] = id.number();
@@ -163,7 +249,8 @@ ModMatrix::TargetId ModMatrix::registerTarget(const ModKey& key)
 
     Impl::Target &target = impl.targets_.back();
     target.key = key;
-    target.bufferReady = false;
+    target.epochSlot = Impl::epochSlot(key);
+    target.multiplicative = (key.flags() & kModIsMultiplicative) != 0;
     target.buffer.resize(impl.samplesPerBlock_);
 
     impl.targetIndex_[key] = id.number();
@@ -225,6 +312,7 @@ void ModMatrix::init()
         const size_t numRegions = impl.maxRegionIdx_ + 1;
         impl.sourceIndicesForRegion_.resize(numRegions);
         impl.targetIndicesForRegion_.resize(numRegions);
+        impl.epochs_.resize(numRegions + 1, 1);
     }
 
     for (unsigned i = 0; i < impl.sources_.size(); ++i) {
@@ -253,6 +341,73 @@ void ModMatrix::init()
             impl.targetIndicesForRegion_[target.key.region().number()].push_back(i);
         }
     }
+
+    // compile the connections of each target
+    impl.operations_.clear();
+    for (Impl::Target& target : impl.targets_) {
+        const bool perVoiceTarget = target.key.flags() & kModIsPerVoice;
+        target.operationsBegin = static_cast<uint32_t>(impl.operations_.size());
+
+        for (const auto& cs : target.connectedSources) {
+            const Impl::Source& source = impl.sources_[cs.first];
+            const bool perVoiceSource = source.key.flags() & kModIsPerVoice;
+
+            // the voices of a region never use the sources of another one
+            if (perVoiceTarget && perVoiceSource && source.key.region() != target.key.region())
+                continue;
+
+            Impl::Operation op;
+            op.source = cs.first;
+            op.sourceDepth = cs.second.sourceDepth_;
+            op.sourceDepthModId = cs.second.sourceDepthModId_;
+            if (perVoiceSource) {
+                op.sourceRegion = source.key.region();
+                op.velToDepth = cs.second.velToDepth_;
+            }
+            impl.operations_.push_back(op);
+        }
+
+        // apply the sources in a fixed order, rather than the one of the map
+        std::sort(impl.operations_.begin() + target.operationsBegin, impl.operations_.end(),
+            [](const Impl::Operation& lhs, const Impl::Operation& rhs) { return lhs.source < rhs.source; });
+
+        target.operationsEnd = static_cast<uint32_t>(impl.operations_.size());
+    }
+
+    // order the targets which modulate the depths before the targets
+    // they modulate
+    impl.dependencies_.clear();
+    std::vector<bool> visited(impl.targets_.size());
+    for (uint32_t i = 0; i < impl.targets_.size(); ++i) {
+        Impl::Target& target = impl.targets_[i];
+        target.dependenciesBegin = static_cast<uint32_t>(impl.dependencies_.size());
+        impl.collectDependencies(i, visited);
+        target.dependenciesEnd = static_cast<uint32_t>(impl.dependencies_.size());
+
+        // the visited targets are the ones collected
+        for (uint32_t d = target.dependenciesBegin; d < target.dependenciesEnd; ++d)
+            visited[impl.dependencies_[d]] = false;
+    }
+}
+
+void ModMatrix::Impl::collectDependencies(uint32_t targetIndex, std::vector<bool>& visited)
+{
+    // mark the target before its dependencies, so a cycle stops here
+    // and reads the buffer as it is
+    visited[targetIndex] = true;
+
+    const Target& target = targets_[targetIndex];
+    for (uint32_t o = target.operationsBegin; o < target.operationsEnd; ++o) {
+        const TargetId depthModId = operations_[o].sourceDepthModId;
+        if (!depthModId)
+            continue;
+
+        const uint32_t depthModIndex = depthModId.number();
+        if (depthModIndex < targets_.size() && !visited[depthModIndex])
+            collectDependencies(depthModIndex, visited);
+    }
+
+    dependencies_.push_back(targetIndex);
 }
 
 void ModMatrix::initVoice(NumericId<Voice> voiceId, NumericId<Region> regionId, unsigned delay)
@@ -300,13 +455,22 @@ void ModMatrix::beginCycle(unsigned numFrames)
 
     impl.numFrames_ = numFrames;
 
+    // invalidate the per-cycle buffers
+    ++impl.epochs_[0];
+}
+
+void ModMatrix::prepareGlobalModulations()
+{
+    Impl& impl = *impl_;
+    const uint32_t numFrames = impl.numFrames_;
+
     for (auto idx: impl.sourceIndicesForGlobal_) {
         Impl::Source& source = impl.sources_[idx];
-        source.bufferReady = false;
-    }
-    for (auto idx: impl.targetIndicesForGlobal_) {
-        Impl::Target& target = impl.targets_[idx];
-        target.bufferReady = false;
+        if (!impl.isReady(source)) {
+            absl::Span<float> buffer(source.buffer.data(), numFrames);
+            source.gen->generate(source.key, {}, buffer);
+            impl.setReady(source);
+        }
     }
 }
 
@@ -317,7 +481,7 @@ void ModMatrix::endCycle()
 
     for (auto idx: impl.sourceIndicesForGlobal_) {
         Impl::Source& source = impl.sources_[idx];
-        if (!source.bufferReady) {
+        if (!impl.isReady(source)) {
             absl::Span<float> buffer(source.buffer.data(), numFrames);
             source.gen->generateDiscarded(source.key, {}, buffer);
         }
@@ -329,32 +493,26 @@ void ModMatrix::endCycle()
 void ModMatrix::beginVoice(NumericId<Voice> voiceId, NumericId<Region> regionId, float triggerValue)
 {
     Impl& impl = *impl_;
+    Impl::VoiceContext& context = impl.currentVoiceContext();
 
-    impl.currentVoiceId_ = voiceId;
-    impl.currentRegionId_ = regionId;
-
-    impl.currentVoiceTriggerValue_ = triggerValue;
+    context.voiceId = voiceId;
+    context.regionId = regionId;
+    context.triggerValue = triggerValue;
 
     ASSERT(regionId);
+    ASSERT(static_cast<size_t>(regionId.number()) + 1 < impl.epochs_.size());
 
-    const auto idNumber = static_cast<size_t>(regionId.number());
-    for (auto idx: impl.sourceIndicesForRegion_[idNumber]) {
-        Impl::Source& source = impl.sources_[idx];
-        source.bufferReady = false;
-    }
-
-    for (auto idx: impl.targetIndicesForRegion_[idNumber]) {
-        Impl::Target& target = impl.targets_[idx];
-        target.bufferReady = false;
-    }
+    // invalidate the per-voice buffers of the region
+    ++impl.epochs_[regionId.number() + 1];
 }
 
 void ModMatrix::endVoice()
 {
     Impl& impl = *impl_;
+    Impl::VoiceContext& context = impl.currentVoiceContext();
     const uint32_t numFrames = impl.numFrames_;
-    const NumericId<Voice> voiceId = impl.currentVoiceId_;
-    const NumericId<Region> regionId = impl.currentRegionId_;
+    const NumericId<Voice> voiceId = context.voiceId;
+    const NumericId<Region> regionId = context.regionId;
 
     ASSERT(regionId);
     ASSERT(static_cast<size_t>(regionId.number()) < impl.sourceIndicesForRegion_.size());
@@ -363,16 +521,15 @@ void ModMatrix::endVoice()
 
     for (auto idx: impl.sourceIndicesForRegion_[idNumber]) {
         const Impl::Source& source = impl.sources_[idx];
-        if (!source.bufferReady) {
+        if (!impl.isReady(source)) {
             absl::Span<float> buffer(source.buffer.data(), numFrames);
             source.gen->generateDiscarded(source.key, voiceId, buffer);
         }
     }
 
-    impl.currentVoiceId_ = {};
-    impl.currentRegionId_ = {};
-
-    impl.currentVoiceTriggerValue_ = 0.0f;
+    context.voiceId = {};
+    context.regionId = {};
+    context.triggerValue = 0.0f;
 }
 
 float* ModMatrix::getModulation(TargetId targetId)
@@ -381,112 +538,111 @@ float* ModMatrix::getModulation(TargetId targetId)
         return nullptr;
 
     Impl& impl = *impl_;
-    const NumericId<Region> regionId = impl.currentRegionId_;
-    const float triggerValue = impl.currentVoiceTriggerValue_;
-    const uint32_t targetIndex = targetId.number();
-    Impl::Target &target = impl.targets_[targetIndex];
-    const int targetFlags = target.key.flags();
+    Impl::VoiceContext& context = impl.currentVoiceContext();
+    const NumericId<Region> regionId = context.regionId;
+    Impl::Target &target = impl.targets_[targetId.number()];
 
-    const uint32_t numFrames = impl.numFrames_;
-    absl::Span<float> buffer(target.buffer.data(), numFrames);
-
-    // only accept per-voice targets of the same region
-    if ((targetFlags & kModIsPerVoice) && regionId != target.key.region())
+    if (!impl.isAccessible(target, regionId))
         return nullptr;
 
     // check if already processed
-    if (target.bufferReady)
-        return buffer.data();
+    if (impl.isReady(target))
+        return target.buffer.data();
 
     // set the ready flag to prevent a cycle
     // in case there is, be sure to initialize the buffer
-    target.bufferReady = true;
+    impl.setReady(target);
+
+    // run the program of the target: its dependencies in order, then itself
+    ASSERT(target.dependenciesEnd > target.dependenciesBegin);
+    for (uint32_t d = target.dependenciesBegin; d + 1 < target.dependenciesEnd; ++d) {
+        Impl::Target& dependency = impl.targets_[impl.dependencies_[d]];
+        if (impl.isAccessible(dependency, regionId) && !impl.isReady(dependency)) {
+            impl.setReady(dependency);
+            impl.evaluate(dependency, context);
+        }
+    }
+    impl.evaluate(target, context);
+
+    return target.buffer.data();
+}
 
-    auto sourcesPos = target.connectedSources.begin();
-    auto sourcesEnd = target.connectedSources.end();
+void ModMatrix::Impl::evaluate(Target& target, VoiceContext& context) noexcept
+{
+    const NumericId<Region> regionId = context.regionId;
+    const float triggerValue = context.triggerValue;
+    const uint32_t numFrames = numFrames_;
+    absl::Span<float> buffer(target.buffer.data(), numFrames);
+    absl::Span<float> depthBuffer(context.depthBuffer.data(), numFrames);
+    const bool multiplicative = target.multiplicative;
     bool isFirstSource = true;
 
     // generate sources in their dedicated buffers
     // then add or multiply, depending on target flags
-    while (sourcesPos != sourcesEnd) {
-        Impl::Source &source = impl.sources_[sourcesPos->first];
-        const int sourceFlags = source.key.flags();
+    for (uint32_t o = target.operationsBegin; o < target.operationsEnd; ++o) {
+        const Operation& op = operations_[o];
 
         // only accept per-voice sources of the same region
-        bool useThisSource = true;
-        if (sourceFlags & kModIsPerVoice)
-            useThisSource = (regionId == source.key.region());
+        if (op.sourceRegion && op.sourceRegion != regionId)
+            continue;
 
-        if (useThisSource) {
-            absl::Span<float> sourceBuffer(source.buffer.data(), numFrames);
+        Source &source = sources_[op.source];
+        absl::Span<const float> sourceBuffer(source.buffer.data(), numFrames);
 
-            // unless source is already done, process it
-            if (!source.bufferReady) {
-                source.gen->generate(source.key, impl.currentVoiceId_, sourceBuffer);
-                source.bufferReady = true;
-            }
+        // unless source is already done, process it
+        if (!isReady(source)) {
+            source.gen->generate(source.key, context.voiceId, absl::MakeSpan(source.buffer.data(), numFrames));
+            setReady(source);
+        }
 
-            float sourceDepth = sourcesPos->second.sourceDepth_;
-            if (sourceFlags & kModIsPerVoice) {
-                const float velToDepth = sourcesPos->second.velToDepth_;
-                sourceDepth += triggerValue * velToDepth;
-            }
+        const float sourceDepth = op.sourceDepth + triggerValue * op.velToDepth;
 
-            const float* sourceDepthMod = getModulation(sourcesPos->second.sourceDepthModId_);
-
-            if (isFirstSource) {
-                if (sourceDepth == 1 && !sourceDepthMod)
-                    copy(absl::Span<const float>(sourceBuffer), buffer);
-                else if (!sourceDepthMod) {
-                    for (uint32_t i = 0; i < numFrames; ++i)
-                        buffer[i] = sourceDepth * sourceBuffer[i];
-                }
-                else if (targetFlags & kModIsMultiplicative) {
-                    for (uint32_t i = 0; i < numFrames; ++i)
-                        buffer[i] = (sourceDepth * sourceDepthMod[i]) * sourceBuffer[i];
-                }
-                else {
-                    ASSERT(targetFlags & kModIsAdditive);
-                    for (uint32_t i = 0; i < numFrames; ++i)
-                        buffer[i] = (sourceDepth + sourceDepthMod[i]) * sourceBuffer[i];
-                }
-                isFirstSource = false;
-            }
+        // the depth modulation was evaluated before, unless it belongs to
+        // another region
+        const float* sourceDepthMod = nullptr;
+        if (op.sourceDepthModId) {
+            const Target& depthModTarget = targets_[op.sourceDepthModId.number()];
+            if (isAccessible(depthModTarget, regionId))
+                sourceDepthMod = depthModTarget.buffer.data();
+        }
+
+        // compute the modulated depth of the source
+        if (sourceDepthMod) {
+            absl::Span<const float> depthMod(sourceDepthMod, numFrames);
+            if (multiplicative)
+                applyGain1(sourceDepth, depthMod, depthBuffer);
             else {
-                if (targetFlags & kModIsMultiplicative) {
-                    if (!sourceDepthMod)
-                        multiplyMul1<float>(sourceDepth, sourceBuffer, buffer);
-                    else {
-                        for (uint32_t i = 0; i < numFrames; ++i)
-                            buffer[i] *= (sourceDepth * sourceDepthMod[i]) * sourceBuffer[i];
-                    }
-                }
-                else {
-                    ASSERT(targetFlags & kModIsAdditive);
-                    if (!sourceDepthMod)
-                        multiplyAdd1<float>(sourceDepth, sourceBuffer, buffer);
-                    else {
-                        for (uint32_t i = 0; i < numFrames; ++i)
-                            buffer[i] += (sourceDepth + sourceDepthMod[i]) * sourceBuffer[i];
-                    }
-                }
+                copy(depthMod, depthBuffer);
+                add1(sourceDepth, depthBuffer);
             }
         }
 
-        ++sourcesPos;
-    }
-
-    // if there were no source, fill output with the neutral element
-    if (isFirstSource) {
-        if (targetFlags & kModIsMultiplicative)
-            fill(buffer, 1.0f);
+        if (isFirstSource) {
+            if (sourceDepthMod)
+                applyGain<float>(depthBuffer, sourceBuffer, buffer);
+            else if (sourceDepth == 1)
+                copy(sourceBuffer, buffer);
+            else
+                applyGain1(sourceDepth, sourceBuffer, buffer);
+            isFirstSource = false;
+        }
+        else if (multiplicative) {
+            if (sourceDepthMod)
+                multiplyMul<float>(depthBuffer, sourceBuffer, buffer);
+            else
+                multiplyMul1(sourceDepth, sourceBuffer, buffer);
+        }
         else {
-            ASSERT(targetFlags & kModIsAdditive);
-            fill(buffer, 0.0f);
+            if (sourceDepthMod)
+                multiplyAdd<float>(depthBuffer, sourceBuffer, buffer);
+            else
+                multiplyAdd1(sourceDepth, sourceBuffer, buffer);
         }
     }
 
-    return buffer.data();
+    // if there were no source, fill output with the neutral element
+    if (isFirstSource)
+        fill(buffer, multiplicative ? 1.0f : 0.0f);
 }
 
 bool ModMatrix::validTarget(TargetId id) const
@@ -46,6 +46,14 @@ public:
      */
     void setSampleRate(double sampleRate);
 
+    /**
+     * @brief Set the number of render workers which can process voices
+     * concurrently. Each worker keeps track of its own current voice.
+     *
+     * @param numWorkers number of render workers
+     */
+    void setNumWorkers(unsigned numWorkers);
+
     /**
      * @brief Resize the modulation buffers.
      *
@@ -99,7 +107,9 @@ public:
     bool connect(SourceId sourceId, TargetId targetId, float sourceDepth, const ModKey& sourceDepthMod, float velToDepth);
 
     /**
-     * @brief Reinitialize modulation sources overall.
+     * @brief Reinitialize modulation sources overall, and compile the
+     * connections into a program which evaluates each target after the
+     * targets modulating its source depths.
      * This must be called once after setting up the matrix.
      */
     void init();
@@ -123,12 +133,19 @@ public:
 
     /**
      * @brief Start modulation processing for the entire cycle.
-     * This clears all the buffers.
+     * This invalidates all the buffers which are per-cycle.
      *
      * @param numFrames
      */
     void beginCycle(unsigned numFrames);
 
+    /**
+     * @brief Generate all the per-cycle sources ahead of the voices.
+     * Afterwards, the voices of distinct regions can be processed
+     * concurrently, because they do not share any modulation buffer.
+     */
+    void prepareGlobalModulations();
+
     /**
      * @brief End modulation processing for the entire cycle.
      * This performs a dummy run of any unused modulations.
@@ -137,7 +154,7 @@ public:
 
     /**
      * @brief Start modulation processing for a given voice.
-     * This clears all the buffers which are per-voice.
+     * This invalidates the buffers which are per-voice in its region.
      *
      * @param voiceId the identifier of the current voice
      * @param regionId the identifier of the region of the current voice
@@ -275,6 +275,56 @@ void sfz::Sfizz::setNumVoices(int numVoices) noexcept
     synth->synth.setNumVoices(numVoices);
 }
 
+int sfz::Sfizz::getNumRenderThreads() const noexcept
+{
+    return synth->synth.getNumRenderThreads();
+}
+
+void sfz::Sfizz::setNumRenderThreads(int numThreads) noexcept
+{
+    synth->synth.setNumRenderThreads(numThreads);
+}
+
+bool sfz::Sfizz::isDiskStreaming() const noexcept
+{
+    return synth->synth.isDiskStreaming();
+}
+
+void sfz::Sfizz::setDiskStreaming(bool streaming) noexcept
+{
+    synth->synth.setDiskStreaming(streaming);
+}
+
+bool sfz::Sfizz::isSampleMemoryMapping() const noexcept
+{
+    return synth->synth.isSampleMemoryMapping();
+}
+
+void sfz::Sfizz::setSampleMemoryMapping(bool mapping) noexcept
+{
+    synth->synth.setSampleMemoryMapping(mapping);
+}
+
+void sfz::Sfizz::setSampleCacheDirectory(const std::string& directory) noexcept
+{
+    synth->synth.setSampleCacheDirectory(directory);
+}
+
+sfz::Sfizz::SampleStoreStats sfz::Sfizz::getSampleStoreStats() const noexcept
+{
+    const SampleStore::Stats stats = synth->synth.getSampleStoreStats();
+    SampleStoreStats result;
+    result.numUsers = stats.numUsers;
+    result.numSamples = stats.numSamples;
+    result.numSharedSamples = stats.numSharedSamples;
+    result.preloadedBytes = stats.preloadedBytes;
+    result.loadedBytes = stats.loadedBytes;
+    result.savedBytes = stats.savedBytes;
+    result.numHits = static_cast<size_t>(stats.numHits);
+    result.numMisses = static_cast<size_t>(stats.numMisses);
+    return result;
+}
+
 bool sfz::Sfizz::setOversamplingFactor(int) noexcept
 {
     return true;
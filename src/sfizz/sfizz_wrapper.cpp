@@ -258,6 +258,54 @@ int sfizz_get_num_voices(sfizz_synth_t* synth)
     return synth->synth.getNumVoices();
 }
 
+void sfizz_set_num_render_threads(sfizz_synth_t* synth, int num_threads)
+{
+    synth->synth.setNumRenderThreads(num_threads);
+}
+
+int sfizz_get_num_render_threads(sfizz_synth_t* synth)
+{
+    return synth->synth.getNumRenderThreads();
+}
+
+void sfizz_set_disk_streaming(sfizz_synth_t* synth, bool streaming)
+{
+    synth->synth.setDiskStreaming(streaming);
+}
+
+bool sfizz_get_disk_streaming(sfizz_synth_t* synth)
+{
+    return synth->synth.isDiskStreaming();
+}
+
+void sfizz_set_sample_memory_mapping(sfizz_synth_t* synth, bool mapping)
+{
+    synth->synth.setSampleMemoryMapping(mapping);
+}
+
+bool sfizz_get_sample_memory_mapping(sfizz_synth_t* synth)
+{
+    return synth->synth.isSampleMemoryMapping();
+}
+
+void sfizz_set_sample_cache_directory(sfizz_synth_t* synth, const char* directory)
+{
+    synth->synth.setSampleCacheDirectory(directory ? directory : "");
+}
+
+void sfizz_get_sample_store_stats(sfizz_synth_t* synth, sfizz_sample_store_stats_t* stats)
+{
+    const sfz::SampleStore::Stats storeStats = synth->synth.getSampleStoreStats();
+    stats->num_users = storeStats.numUsers;
+    stats->num_samples = storeStats.numSamples;
+    stats->num_shared_samples = storeStats.numSharedSamples;
+    stats->preloaded_bytes = storeStats.preloadedBytes;
+    stats->loaded_bytes = storeStats.loadedBytes;
+    stats->saved_bytes = storeStats.savedBytes;
+    stats->num_hits = static_cast<size_t>(storeStats.numHits);
+    stats->num_misses = static_cast<size_t>(storeStats.numMisses);
+}
+
 int sfizz_get_num_buffers(sfizz_synth_t* synth)
 {
     return synth->synth.getAllocatedBuffers();
@@ -6,6 +6,7 @@
 
 #pragma once
 #include <stdint.h>
+#include <string.h>
 
 constexpr uintptr_t ByteAlignmentMask(unsigned N) { return N - 1; }
 
@@ -49,3 +50,57 @@ bool willAlign(const T* ptr1, const T* ptr2, Args... rest)
 {
     return willAlign<N>(ptr1, ptr2) && willAlign<N>(ptr2, rest...);
 }
+
+// Coefficients of a polynomial approximation of 2^x over [-0.5, 0.5],
+// highest degree first (Cephes exp2f, relative error 1.7e-7)
+constexpr float exp2Coeffs[6] {
+    1.535336188319500e-4f, 1.339887440266574e-3f, 9.618437357674640e-3f,
+    5.550332471162809e-2f, 2.402264791363012e-1f, 6.931472028550421e-1f,
+};
+
+// Limits of the exponents with normal results
+constexpr float exp2Min = -126.0f;
+constexpr float exp2Max = 126.0f;
+
+// Scalar version of the vector approximations of 2^x, for the unaligned ends.
+// It is static to give each instruction set its own copy.
+static inline float exp2Approx(float x) noexcept
+{
+    x = x < exp2Min ? exp2Min : (x > exp2Max ? exp2Max : x);
+    const int n = static_cast<int>(x < 0.0f ? x - 0.5f : x + 0.5f);
+    const float f = x - static_cast<float>(n);
+
+    float p = exp2Coeffs[0];
+    for (unsigned i = 1; i < 6; ++i)
+        p = p * f + exp2Coeffs[i];
+    p = p * f + 1.0f;
+
+    const uint32_t bits = static_cast<uint32_t>(n + 127) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// Coefficients of a polynomial approximation of cos(pi/2 x) over [-1, 1], in
+// powers of x^2, highest degree first (Taylor series, absolute error 7e-9)
+constexpr float panCosCoeffs[7] {
+    4.710874778818e-7f, -2.520204237306e-5f, 9.192602748394e-4f,
+    -2.086348076335e-2f, 2.536695079010e-1f, -1.233700550136f, 1.0f,
+};
+
+// Scalar version of the vector approximations of the pan law, for the unaligned ends
+static inline float panCosApprox(float x) noexcept
+{
+    const float x2 = x * x;
+    float p = panCosCoeffs[0];
+    for (unsigned i = 1; i < 7; ++i)
+        p = p * x2 + panCosCoeffs[i];
+    return p > 0.0f ? p : 0.0f;
+}
+
+// Normalize a pan or width value within [-1, 1] to [0, 1]
+static inline float panNormalize(float value) noexcept
+{
+    const float x = (value + 1.0f) * 0.5f;
+    return x < 0.0f ? 0.0f : (x > 1.0f ? 1.0f : x);
+}
@@ -8,14 +8,123 @@
 #include "../SIMDConfig.h"
 #include "../MathHelpers.h"
 #include "Common.h"
+#include <algorithm>
 
 #if SFIZZ_HAVE_AVX
 #include <immintrin.h>
 using Type = float;
 constexpr unsigned TypeAlignment = 8;
 constexpr unsigned ByteAlignment = TypeAlignment * sizeof(Type);
+
+// Broadcast the last element of a register to all of its elements
+static inline __m256 broadcastLast(__m256 x) noexcept
+{
+    const auto upper = _mm256_permute_ps(x, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_permute2f128_ps(upper, upper, 0x11);
+}
+
+// Sum the elements of a register
+static inline float horizontalSum(__m256 x) noexcept
+{
+    auto sum = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(sum);
+}
+
+// The pan law cos(pi/2 x), for x within [0, 1]
+static inline __m256 panCos(__m256 x) noexcept
+{
+    const auto x2 = _mm256_mul_ps(x, x);
+    auto p = _mm256_set1_ps(panCosCoeffs[0]);
+    for (unsigned i = 1; i < 7; ++i)
+        p = _mm256_add_ps(_mm256_mul_ps(p, x2), _mm256_set1_ps(panCosCoeffs[i]));
+    return _mm256_max_ps(p, _mm256_setzero_ps());
+}
+
+// Normalize pan or width values within [-1, 1] to [0, 1]
+static inline __m256 panNormalize(__m256 x) noexcept
+{
+    x = _mm256_mul_ps(_mm256_add_ps(x, _mm256_set1_ps(1.0f)), _mm256_set1_ps(0.5f));
+    return _mm256_min_ps(_mm256_max_ps(x, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+}
+
+// The end of the whole registers from a pointer. The accumulating operations
+// start their registers at the first element rather than at an aligned one:
+// the buffers are only 16-byte aligned, and their rounding would otherwise
+// depend on the address of the buffer.
+template <class T>
+static inline const T* lastWholeRegister(const T* pointer, const T* sentinel) noexcept
+{
+    return pointer + (sentinel - pointer) / TypeAlignment * TypeAlignment;
+}
+#endif
+
+bool helpersAVXBuilt() noexcept
+{
+    return SFIZZ_HAVE_AVX;
+}
+
+void readInterleavedAVX(const float* input, float* outputLeft, float* outputRight, unsigned inputSize) noexcept
+{
+    const auto* sentinel = input + inputSize - 1;
+
+#if SFIZZ_HAVE_AVX
+    // Only the left output is aligned, the other accesses are unaligned
+    const auto* lastAligned = prevAligned<ByteAlignment>(outputLeft + inputSize / 2);
+    while (unaligned<ByteAlignment>(outputLeft) && outputLeft < lastAligned) {
+        *outputLeft++ = *input++;
+        *outputRight++ = *input++;
+    }
+
+    while (outputLeft < lastAligned) {
+        const auto register0 = _mm256_loadu_ps(input);
+        const auto register1 = _mm256_loadu_ps(input + TypeAlignment);
+        // gather the frames 0-1 and 4-5 in the lower lane, 2-3 and 6-7 in the upper one,
+        // then deinterleave within the lanes
+        const auto lower = _mm256_permute2f128_ps(register0, register1, 0x20);
+        const auto upper = _mm256_permute2f128_ps(register0, register1, 0x31);
+        _mm256_store_ps(outputLeft, _mm256_shuffle_ps(lower, upper, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm256_storeu_ps(outputRight, _mm256_shuffle_ps(lower, upper, _MM_SHUFFLE(3, 1, 3, 1)));
+        incrementAll<TypeAlignment>(input, input, outputLeft, outputRight);
+    }
+#endif
+
+    while (input < sentinel) {
+        *outputLeft++ = *input++;
+        *outputRight++ = *input++;
+    }
+}
+
+void writeInterleavedAVX(const float* inputLeft, const float* inputRight, float* output, unsigned outputSize) noexcept
+{
+    const auto* sentinel = output + outputSize - 1;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(output + outputSize - TypeAlignment);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned) {
+        *output++ = *inputLeft++;
+        *output++ = *inputRight++;
+    }
+
+    while (output < lastAligned) {
+        const auto lInRegister = _mm256_loadu_ps(inputLeft);
+        const auto rInRegister = _mm256_loadu_ps(inputRight);
+        // frames 0-1 and 4-5 in the low register, 2-3 and 6-7 in the high one
+        const auto low = _mm256_unpacklo_ps(lInRegister, rInRegister);
+        const auto high = _mm256_unpackhi_ps(lInRegister, rInRegister);
+        _mm256_store_ps(output, _mm256_permute2f128_ps(low, high, 0x20));
+        _mm256_store_ps(output + TypeAlignment, _mm256_permute2f128_ps(low, high, 0x31));
+        incrementAll<TypeAlignment>(output, output, inputLeft, inputRight);
+    }
 #endif
 
+    while (output < sentinel) {
+        *output++ = *inputLeft++;
+        *output++ = *inputRight++;
+    }
+}
+
 void gain1AVX(float gain, const float* input, float* output, unsigned size) noexcept
 {
     const auto* sentinel = output + size;
@@ -23,11 +132,11 @@ void gain1AVX(float gain, const float* input, float* output, unsigned size) noex
 #if SFIZZ_HAVE_AVX
     const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
     const auto mmGain = _mm256_set1_ps(gain);
-    while (unaligned<ByteAlignment>(input, output) && output < lastAligned)
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
         *output++ = gain * (*input++);
 
     while (output < lastAligned) {
-        _mm256_store_ps(output, _mm256_mul_ps(mmGain, _mm256_load_ps(input)));
+        _mm256_store_ps(output, _mm256_mul_ps(mmGain, _mm256_loadu_ps(input)));
         incrementAll<TypeAlignment>(input, output);
     }
 #endif
@@ -42,15 +151,566 @@ void gainAVX(const float* gain, const float* input, float* output, unsigned size
 
 #if SFIZZ_HAVE_AVX
     const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
-    while (unaligned<ByteAlignment>(input, output) && output < lastAligned)
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
         *output++ = (*gain++) * (*input++);
 
     while (output < lastAligned) {
-        _mm256_store_ps(output, _mm256_mul_ps(_mm256_load_ps(gain), _mm256_load_ps(input)));
-        incrementAll<TypeAlignment>(input, output);
+        _mm256_store_ps(output, _mm256_mul_ps(_mm256_loadu_ps(gain), _mm256_loadu_ps(input)));
+        incrementAll<TypeAlignment>(gain, input, output);
     }
 #endif
 
     while (output < sentinel)
         *output++ = (*gain++) * (*input++);
 }
+
+void divideAVX(const float* input, const float* divisor, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ = (*input++) / (*divisor++);
+
+    while (output < lastAligned) {
+        _mm256_store_ps(output, _mm256_div_ps(_mm256_loadu_ps(input), _mm256_loadu_ps(divisor)));
+        incrementAll<TypeAlignment>(divisor, input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ = (*input++) / (*divisor++);
+}
+
+void multiplyAddAVX(const float* gain, const float* input, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ += (*gain++) * (*input++);
+
+    while (output < lastAligned) {
+        auto mmOut = _mm256_load_ps(output);
+        mmOut = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(gain), _mm256_loadu_ps(input)), mmOut);
+        _mm256_store_ps(output, mmOut);
+        incrementAll<TypeAlignment>(gain, input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ += (*gain++) * (*input++);
+}
+
+void multiplyAdd1AVX(float gain, const float* input, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ += gain * (*input++);
+
+    const auto mmGain = _mm256_set1_ps(gain);
+    while (output < lastAligned) {
+        auto mmOut = _mm256_load_ps(output);
+        mmOut = _mm256_add_ps(_mm256_mul_ps(mmGain, _mm256_loadu_ps(input)), mmOut);
+        _mm256_store_ps(output, mmOut);
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ += gain * (*input++);
+}
+
+void multiplyMulAVX(const float* gain, const float* input, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ *= (*gain++) * (*input++);
+
+    while (output < lastAligned) {
+        auto mmOut = _mm256_load_ps(output);
+        mmOut = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(gain), _mm256_loadu_ps(input)), mmOut);
+        _mm256_store_ps(output, mmOut);
+        incrementAll<TypeAlignment>(gain, input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ *= (*gain++) * (*input++);
+}
+
+void multiplyMul1AVX(float gain, const float* input, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ *= gain * (*input++);
+
+    const auto mmGain = _mm256_set1_ps(gain);
+    while (output < lastAligned) {
+        auto mmOut = _mm256_load_ps(output);
+        mmOut = _mm256_mul_ps(_mm256_mul_ps(mmGain, _mm256_loadu_ps(input)), mmOut);
+        _mm256_store_ps(output, mmOut);
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ *= gain * (*input++);
+}
+
+float linearRampAVX(float* output, float start, float step, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastRegister = lastWholeRegister<float>(output, sentinel);
+    auto mmStart = _mm256_set1_ps(start - step);
+    const auto mmStep = _mm256_set_ps(8 * step, 7 * step, 6 * step, 5 * step, 4 * step, 3 * step, 2 * step, step);
+    while (output < lastRegister) {
+        mmStart = _mm256_add_ps(mmStart, mmStep);
+        _mm256_storeu_ps(output, mmStart);
+        mmStart = broadcastLast(mmStart);
+        incrementAll<TypeAlignment>(output);
+    }
+    start = _mm256_cvtss_f32(mmStart) + step;
+#endif
+
+    while (output < sentinel) {
+        *output++ = start;
+        start += step;
+    }
+    return start;
+}
+
+float multiplicativeRampAVX(float* output, float start, float step, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastRegister = lastWholeRegister<float>(output, sentinel);
+    float powers[TypeAlignment];
+    powers[0] = step;
+    for (unsigned i = 1; i < TypeAlignment; ++i)
+        powers[i] = powers[i - 1] * step;
+
+    auto mmStart = _mm256_set1_ps(start / step);
+    const auto mmStep = _mm256_loadu_ps(powers);
+    while (output < lastRegister) {
+        mmStart = _mm256_mul_ps(mmStart, mmStep);
+        _mm256_storeu_ps(output, mmStart);
+        mmStart = broadcastLast(mmStart);
+        incrementAll<TypeAlignment>(output);
+    }
+    start = _mm256_cvtss_f32(mmStart) * step;
+#endif
+
+    while (output < sentinel) {
+        *output++ = start;
+        start *= step;
+    }
+    return start;
+}
+
+void addAVX(const float* input, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ += *input++;
+
+    while (output < lastAligned) {
+        _mm256_store_ps(output, _mm256_add_ps(_mm256_load_ps(output), _mm256_loadu_ps(input)));
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ += *input++;
+}
+
+void add1AVX(float value, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ += value;
+
+    const auto mmValue = _mm256_set1_ps(value);
+    while (output < lastAligned) {
+        _mm256_store_ps(output, _mm256_add_ps(_mm256_load_ps(output), mmValue));
+        incrementAll<TypeAlignment>(output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ += value;
+}
+
+void subtractAVX(const float* input, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ -= *input++;
+
+    while (output < lastAligned) {
+        _mm256_store_ps(output, _mm256_sub_ps(_mm256_load_ps(output), _mm256_loadu_ps(input)));
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ -= *input++;
+}
+
+void subtract1AVX(float value, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ -= value;
+
+    const auto mmValue = _mm256_set1_ps(value);
+    while (output < lastAligned) {
+        _mm256_store_ps(output, _mm256_sub_ps(_mm256_load_ps(output), mmValue));
+        incrementAll<TypeAlignment>(output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ -= value;
+}
+
+void copyAVX(const float* input, float* output, unsigned size) noexcept
+{
+    // The sentinel is the input here
+    const auto* sentinel = input + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(output + size);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ = *input++;
+
+    while (output < lastAligned) {
+        _mm256_store_ps(output, _mm256_loadu_ps(input));
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    std::copy(input, sentinel, output);
+}
+
+float meanAVX(const float* vector, unsigned size) noexcept
+{
+    const auto* sentinel = vector + size;
+
+    float result { 0.0f };
+    if (size == 0)
+        return result;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastRegister = lastWholeRegister<float>(vector, sentinel);
+    auto mmSums = _mm256_setzero_ps();
+    while (vector < lastRegister) {
+        mmSums = _mm256_add_ps(mmSums, _mm256_loadu_ps(vector));
+        incrementAll<TypeAlignment>(vector);
+    }
+
+    result += horizontalSum(mmSums);
+#endif
+
+    while (vector < sentinel)
+        result += *vector++;
+
+    return result / static_cast<float>(size);
+}
+
+float sumSquaresAVX(const float* vector, unsigned size) noexcept
+{
+    const auto* sentinel = vector + size;
+
+    float result { 0.0f };
+    if (size == 0)
+        return result;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastRegister = lastWholeRegister<float>(vector, sentinel);
+    auto mmSums = _mm256_setzero_ps();
+    while (vector < lastRegister) {
+        const auto mmValues = _mm256_loadu_ps(vector);
+        mmSums = _mm256_add_ps(mmSums, _mm256_mul_ps(mmValues, mmValues));
+        incrementAll<TypeAlignment>(vector);
+    }
+
+    result += horizontalSum(mmSums);
+#endif
+
+    while (vector < sentinel) {
+        result += (*vector) * (*vector);
+        vector++;
+    }
+
+    return result;
+}
+
+void cumsumAVX(const float* input, float* output, unsigned size) noexcept
+{
+    if (size == 0)
+        return;
+
+    const auto* sentinel = output + size;
+    *output++ = *input++;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastRegister = lastWholeRegister<float>(output, sentinel);
+    const auto mmZero = _mm256_setzero_ps();
+    auto mmOutput = _mm256_set1_ps(*(output - 1));
+    while (output < lastRegister) {
+        auto mmOffset = _mm256_loadu_ps(input);
+        // prefix sums within the 128-bit lanes, shifting by 1 then 2 elements
+        mmOffset = _mm256_add_ps(mmOffset,
+            _mm256_blend_ps(_mm256_permute_ps(mmOffset, _MM_SHUFFLE(2, 1, 0, 0)), mmZero, 0x11));
+        mmOffset = _mm256_add_ps(mmOffset,
+            _mm256_blend_ps(_mm256_permute_ps(mmOffset, _MM_SHUFFLE(1, 0, 0, 0)), mmZero, 0x33));
+        // carry the sum of the lower lane into the upper one
+        const auto mmLowerSum = _mm256_permute_ps(mmOffset, _MM_SHUFFLE(3, 3, 3, 3));
+        mmOffset = _mm256_add_ps(mmOffset, _mm256_permute2f128_ps(mmLowerSum, mmLowerSum, 0x08));
+        mmOutput = _mm256_add_ps(mmOutput, mmOffset);
+        _mm256_storeu_ps(output, mmOutput);
+        mmOutput = broadcastLast(mmOutput);
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    while (output < sentinel) {
+        *output = *(output - 1) + *input;
+        incrementAll(input, output);
+    }
+}
+
+void diffAVX(const float* input, float* output, unsigned size) noexcept
+{
+    if (size == 0)
+        return;
+
+    const auto* sentinel = output + size;
+    *output++ = *input++;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned) {
+        *output = *input - *(input - 1);
+        incrementAll(input, output);
+    }
+
+    // the previous elements are read unaligned, one element behind
+    while (output < lastAligned) {
+        _mm256_store_ps(output, _mm256_sub_ps(_mm256_loadu_ps(input), _mm256_loadu_ps(input - 1)));
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    while (output < sentinel) {
+        *output = *input - *(input - 1);
+        incrementAll(input, output);
+    }
+}
+
+void clampAllAVX(float* input, float low, float high, unsigned size) noexcept
+{
+    if (size == 0)
+        return;
+
+    const auto* sentinel = input + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(input) && input < lastAligned){
+        const float clampedAbove = *input > high ? high : *input;
+        *input = clampedAbove < low ? low : clampedAbove;
+        incrementAll(input);
+    }
+
+    const auto mmLow = _mm256_set1_ps(low);
+    const auto mmHigh = _mm256_set1_ps(high);
+    while (input < lastAligned) {
+        const auto mmIn = _mm256_load_ps(input);
+        _mm256_store_ps(input, _mm256_max_ps(_mm256_min_ps(mmIn, mmHigh), mmLow));
+        incrementAll<TypeAlignment>(input);
+    }
+#endif
+
+    while (input < sentinel) {
+        const float clampedAbove = *input > high ? high : *input;
+        *input = clampedAbove < low ? low : clampedAbove;
+        incrementAll(input);
+    }
+}
+
+bool allWithinAVX(const float* input, float low, float high, unsigned size) noexcept
+{
+    if (size == 0)
+        return true;
+
+    if (low > high)
+        std::swap(low, high);
+
+    const auto* sentinel = input + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(input) && input < lastAligned){
+        if (*input < low || *input > high)
+            return false;
+
+        incrementAll(input);
+    }
+
+    const auto mmLow = _mm256_set1_ps(low);
+    const auto mmHigh = _mm256_set1_ps(high);
+    while (input < lastAligned) {
+        const auto mmIn = _mm256_load_ps(input);
+        const auto mmOutside = _mm256_or_ps(
+            _mm256_cmp_ps(mmIn, mmLow, _CMP_LT_OQ), _mm256_cmp_ps(mmIn, mmHigh, _CMP_GT_OQ));
+        if (_mm256_movemask_ps(mmOutside) != 0)
+            return false;
+
+        incrementAll<TypeAlignment>(input);
+    }
+#endif
+
+    while (input < sentinel) {
+        if (*input < low || *input > high)
+            return false;
+
+        incrementAll(input);
+    }
+
+    return true;
+}
+
+void exp2AVX(const float* input, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ = exp2Approx(*input++);
+
+    const auto mmMin = _mm256_set1_ps(exp2Min);
+    const auto mmMax = _mm256_set1_ps(exp2Max);
+    while (output < lastAligned) {
+        // split into the nearest integer and a fraction within [-0.5, 0.5]
+        const auto mmIn = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(input), mmMin), mmMax);
+        const auto mmInteger = _mm256_round_ps(mmIn, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        const auto mmFraction = _mm256_sub_ps(mmIn, mmInteger);
+
+        auto mmPoly = _mm256_set1_ps(exp2Coeffs[0]);
+        for (unsigned i = 1; i < 6; ++i)
+            mmPoly = _mm256_add_ps(_mm256_mul_ps(mmPoly, mmFraction), _mm256_set1_ps(exp2Coeffs[i]));
+        mmPoly = _mm256_add_ps(_mm256_mul_ps(mmPoly, mmFraction), _mm256_set1_ps(1.0f));
+
+        // 2^integer, built in the exponent bits; AVX lacks the integer shifts,
+        // so the biased exponent is shifted as a float before the conversion
+        const auto mmExponent = _mm256_mul_ps(_mm256_add_ps(mmInteger, _mm256_set1_ps(127.0f)), _mm256_set1_ps(8388608.0f));
+        const auto mmScale = _mm256_castsi256_ps(_mm256_cvtps_epi32(mmExponent));
+        _mm256_store_ps(output, _mm256_mul_ps(mmPoly, mmScale));
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ = exp2Approx(*input++);
+}
+
+void panAVX(const float* panEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
+{
+    const auto* sentinel = leftBuffer + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(leftBuffer) && leftBuffer < lastAligned) {
+        const float p = panNormalize(*panEnvelope);
+        *leftBuffer *= panCosApprox(p);
+        *rightBuffer *= panCosApprox(1.0f - p);
+        incrementAll(panEnvelope, leftBuffer, rightBuffer);
+    }
+
+    const auto mmOne = _mm256_set1_ps(1.0f);
+    while (leftBuffer < lastAligned) {
+        const auto mmPan = panNormalize(_mm256_loadu_ps(panEnvelope));
+        _mm256_store_ps(leftBuffer, _mm256_mul_ps(_mm256_load_ps(leftBuffer), panCos(mmPan)));
+        _mm256_storeu_ps(rightBuffer, _mm256_mul_ps(_mm256_loadu_ps(rightBuffer), panCos(_mm256_sub_ps(mmOne, mmPan))));
+        incrementAll<TypeAlignment>(panEnvelope, leftBuffer, rightBuffer);
+    }
+#endif
+
+    while (leftBuffer < sentinel) {
+        const float p = panNormalize(*panEnvelope);
+        *leftBuffer *= panCosApprox(p);
+        *rightBuffer *= panCosApprox(1.0f - p);
+        incrementAll(panEnvelope, leftBuffer, rightBuffer);
+    }
+}
+
+void widthAVX(const float* widthEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
+{
+    const auto* sentinel = leftBuffer + size;
+
+#if SFIZZ_HAVE_AVX
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(leftBuffer) && leftBuffer < lastAligned) {
+        const float w = panNormalize(*widthEnvelope);
+        const float coeff1 = panCosApprox(w);
+        const float coeff2 = panCosApprox(1.0f - w);
+        const float l = *leftBuffer;
+        const float r = *rightBuffer;
+        *leftBuffer = l * coeff2 + r * coeff1;
+        *rightBuffer = l * coeff1 + r * coeff2;
+        incrementAll(widthEnvelope, leftBuffer, rightBuffer);
+    }
+
+    const auto mmOne = _mm256_set1_ps(1.0f);
+    while (leftBuffer < lastAligned) {
+        const auto mmWidth = panNormalize(_mm256_loadu_ps(widthEnvelope));
+        const auto mmCoeff1 = panCos(mmWidth);
+        const auto mmCoeff2 = panCos(_mm256_sub_ps(mmOne, mmWidth));
+        const auto mmLeft = _mm256_load_ps(leftBuffer);
+        const auto mmRight = _mm256_loadu_ps(rightBuffer);
+        _mm256_store_ps(leftBuffer, _mm256_add_ps(_mm256_mul_ps(mmLeft, mmCoeff2), _mm256_mul_ps(mmRight, mmCoeff1)));
+        _mm256_storeu_ps(rightBuffer, _mm256_add_ps(_mm256_mul_ps(mmLeft, mmCoeff1), _mm256_mul_ps(mmRight, mmCoeff2)));
+        incrementAll<TypeAlignment>(widthEnvelope, leftBuffer, rightBuffer);
+    }
+#endif
+
+    while (leftBuffer < sentinel) {
+        const float w = panNormalize(*widthEnvelope);
+        const float coeff1 = panCosApprox(w);
+        const float coeff2 = panCosApprox(1.0f - w);
+        const float l = *leftBuffer;
+        const float r = *rightBuffer;
+        *leftBuffer = l * coeff2 + r * coeff1;
+        *rightBuffer = l * coeff1 + r * coeff2;
+        incrementAll(widthEnvelope, leftBuffer, rightBuffer);
+    }
+}
@@ -6,5 +6,31 @@
 
 #pragma once
 
-void gain1AVX(float gain, const float* input, float* output, unsigned size) noexcept;
+/* These are the AVX versions of the SIMDHelpers */
+/* Whether this file was built for AVX; otherwise the helpers run the scalar code */
+bool helpersAVXBuilt() noexcept;
+void readInterleavedAVX(const float* input, float* outputLeft, float* outputRight, unsigned inputSize) noexcept;
+void writeInterleavedAVX(const float* inputLeft, const float* inputRight, float* output, unsigned outputSize) noexcept;
 void gainAVX(const float* gain, const float* input, float* output, unsigned size) noexcept;
+void gain1AVX(float gain, const float* input, float* output, unsigned size) noexcept;
+void divideAVX(const float* input, const float* divisor, float* output, unsigned size) noexcept;
+void multiplyAddAVX(const float* gain, const float* input, float* output, unsigned size) noexcept;
+void multiplyAdd1AVX(float gain, const float* input, float* output, unsigned size) noexcept;
+void multiplyMulAVX(const float* gain, const float* input, float* output, unsigned size) noexcept;
+void multiplyMul1AVX(float gain, const float* input, float* output, unsigned size) noexcept;
+float linearRampAVX(float* output, float start, float step, unsigned size) noexcept;
+float multiplicativeRampAVX(float* output, float start, float step, unsigned size) noexcept;
+void addAVX(const float* input, float* output, unsigned size) noexcept;
+void add1AVX(float value, float* output, unsigned size) noexcept;
+void subtractAVX(const float* input, float* output, unsigned size) noexcept;
+void subtract1AVX(float value, float* output, unsigned size) noexcept;
+void copyAVX(const float* input, float* output, unsigned size) noexcept;
+float meanAVX(const float* vector, unsigned size) noexcept;
+float sumSquaresAVX(const float* vector, unsigned size) noexcept;
+void cumsumAVX(const float* input, float* output, unsigned size) noexcept;
+void diffAVX(const float* input, float* output, unsigned size) noexcept;
+void clampAllAVX(float* input, float low, float high, unsigned size) noexcept;
+bool allWithinAVX(const float* input, float low, float high, unsigned size) noexcept;
+void exp2AVX(const float* input, float* output, unsigned size) noexcept;
+void panAVX(const float* panEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept;
+void widthAVX(const float* widthEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept;
@@ -15,6 +15,23 @@
 using Type = float;
 constexpr unsigned TypeAlignment = 4;
 constexpr unsigned ByteAlignment = TypeAlignment * sizeof(Type);
+
+// The pan law cos(pi/2 x), for x within [0, 1]
+static inline __m128 panCos(__m128 x) noexcept
+{
+    const auto x2 = _mm_mul_ps(x, x);
+    auto p = _mm_set1_ps(panCosCoeffs[0]);
+    for (unsigned i = 1; i < 7; ++i)
+        p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(panCosCoeffs[i]));
+    return _mm_max_ps(p, _mm_setzero_ps());
+}
+
+// Normalize pan or width values within [-1, 1] to [0, 1]
+static inline __m128 panNormalize(__m128 x) noexcept
+{
+    x = _mm_mul_ps(_mm_add_ps(x, _mm_set1_ps(1.0f)), _mm_set1_ps(0.5f));
+    return _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
 #endif
 
 void readInterleavedSSE(const float* input, float* outputLeft, float* outputRight, unsigned inputSize) noexcept
@@ -587,3 +604,108 @@ bool allWithinSSE(const float* input, float low, float high, unsigned size) noex
 
     return true;
 }
+
+void exp2SSE(const float* input, float* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+
+#if SFIZZ_HAVE_SSE2
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(output) && output < lastAligned)
+        *output++ = exp2Approx(*input++);
+
+    const auto mmMin = _mm_set1_ps(exp2Min);
+    const auto mmMax = _mm_set1_ps(exp2Max);
+    while (output < lastAligned) {
+        // split into the nearest integer and a fraction within [-0.5, 0.5]
+        const auto mmIn = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input), mmMin), mmMax);
+        const auto mmInteger = _mm_cvtps_epi32(mmIn);
+        const auto mmFraction = _mm_sub_ps(mmIn, _mm_cvtepi32_ps(mmInteger));
+
+        auto mmPoly = _mm_set1_ps(exp2Coeffs[0]);
+        for (unsigned i = 1; i < 6; ++i)
+            mmPoly = _mm_add_ps(_mm_mul_ps(mmPoly, mmFraction), _mm_set1_ps(exp2Coeffs[i]));
+        mmPoly = _mm_add_ps(_mm_mul_ps(mmPoly, mmFraction), _mm_set1_ps(1.0f));
+
+        // 2^integer, built in the exponent bits
+        const auto mmScale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(mmInteger, _mm_set1_epi32(127)), 23));
+        _mm_store_ps(output, _mm_mul_ps(mmPoly, mmScale));
+        incrementAll<TypeAlignment>(input, output);
+    }
+#endif
+
+    while (output < sentinel)
+        *output++ = exp2Approx(*input++);
+}
+
+void panSSE(const float* panEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
+{
+    const auto* sentinel = leftBuffer + size;
+
+#if SFIZZ_HAVE_SSE2
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(leftBuffer) && leftBuffer < lastAligned) {
+        const float p = panNormalize(*panEnvelope);
+        *leftBuffer *= panCosApprox(p);
+        *rightBuffer *= panCosApprox(1.0f - p);
+        incrementAll(panEnvelope, leftBuffer, rightBuffer);
+    }
+
+    const auto mmOne = _mm_set1_ps(1.0f);
+    while (leftBuffer < lastAligned) {
+        const auto mmPan = panNormalize(_mm_loadu_ps(panEnvelope));
+        _mm_store_ps(leftBuffer, _mm_mul_ps(_mm_load_ps(leftBuffer), panCos(mmPan)));
+        _mm_storeu_ps(rightBuffer, _mm_mul_ps(_mm_loadu_ps(rightBuffer), panCos(_mm_sub_ps(mmOne, mmPan))));
+        incrementAll<TypeAlignment>(panEnvelope, leftBuffer, rightBuffer);
+    }
+#endif
+
+    while (leftBuffer < sentinel) {
+        const float p = panNormalize(*panEnvelope);
+        *leftBuffer *= panCosApprox(p);
+        *rightBuffer *= panCosApprox(1.0f - p);
+        incrementAll(panEnvelope, leftBuffer, rightBuffer);
+    }
+}
+
+void widthSSE(const float* widthEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept
+{
+    const auto* sentinel = leftBuffer + size;
+
+#if SFIZZ_HAVE_SSE2
+    const auto* lastAligned = prevAligned<ByteAlignment>(sentinel);
+    while (unaligned<ByteAlignment>(leftBuffer) && leftBuffer < lastAligned) {
+        const float w = panNormalize(*widthEnvelope);
+        const float coeff1 = panCosApprox(w);
+        const float coeff2 = panCosApprox(1.0f - w);
+        const float l = *leftBuffer;
+        const float r = *rightBuffer;
+        *leftBuffer = l * coeff2 + r * coeff1;
+        *rightBuffer = l * coeff1 + r * coeff2;
+        incrementAll(widthEnvelope, leftBuffer, rightBuffer);
+    }
+
+    const auto mmOne = _mm_set1_ps(1.0f);
+    while (leftBuffer < lastAligned) {
+        const auto mmWidth = panNormalize(_mm_loadu_ps(widthEnvelope));
+        const auto mmCoeff1 = panCos(mmWidth);
+        const auto mmCoeff2 = panCos(_mm_sub_ps(mmOne, mmWidth));
+        const auto mmLeft = _mm_load_ps(leftBuffer);
+        const auto mmRight = _mm_loadu_ps(rightBuffer);
+        _mm_store_ps(leftBuffer, _mm_add_ps(_mm_mul_ps(mmLeft, mmCoeff2), _mm_mul_ps(mmRight, mmCoeff1)));
+        _mm_storeu_ps(rightBuffer, _mm_add_ps(_mm_mul_ps(mmLeft, mmCoeff1), _mm_mul_ps(mmRight, mmCoeff2)));
+        incrementAll<TypeAlignment>(widthEnvelope, leftBuffer, rightBuffer);
+    }
+#endif
+
+    while (leftBuffer < sentinel) {
+        const float w = panNormalize(*widthEnvelope);
+        const float coeff1 = panCosApprox(w);
+        const float coeff2 = panCosApprox(1.0f - w);
+        const float l = *leftBuffer;
+        const float r = *rightBuffer;
+        *leftBuffer = l * coeff2 + r * coeff1;
+        *rightBuffer = l * coeff1 + r * coeff2;
+        incrementAll(widthEnvelope, leftBuffer, rightBuffer);
+    }
+}
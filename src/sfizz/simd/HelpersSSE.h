@@ -29,3 +29,6 @@ void cumsumSSE(const float* input, float* output, unsigned size) noexcept;
 void diffSSE(const float* input, float* output, unsigned size) noexcept;
 void clampAllSSE(float* input, float low, float high, unsigned size) noexcept;
 bool allWithinSSE(const float* input, float low, float high, unsigned size) noexcept;
+void exp2SSE(const float* input, float* output, unsigned size) noexcept;
+void panSSE(const float* panEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept;
+void widthSSE(const float* widthEnvelope, float* leftBuffer, float* rightBuffer, unsigned size) noexcept;
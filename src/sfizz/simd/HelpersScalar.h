@@ -6,6 +6,7 @@
 
 #pragma once
 #include <algorithm>
+#include <cmath>
 
 template<class T>
 inline void readInterleavedScalar(const T* input, T* outputLeft, T* outputRight, unsigned inputSize) noexcept
@@ -236,3 +237,13 @@ bool allWithinScalar(const T* input, T low, T high, unsigned size ) noexcept
 
     return true;
 }
+
+template <class T>
+void exp2Scalar(const T* input, T* output, unsigned size) noexcept
+{
+    const auto* sentinel = output + size;
+    while (output < sentinel) {
+        *output = std::exp2(*input);
+        incrementAll(input, output);
+    }
+}
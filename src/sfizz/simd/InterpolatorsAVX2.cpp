@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "InterpolatorsAVX2.h"
+#include "../SIMDConfig.h"
+
+#if SFIZZ_HAVE_AVX2
+#include <immintrin.h>
+
+// Interpolated lookups in the sinc table, 8 at once. The indices are those
+// of the frames 0, 1, 4, 5 in `ia` and 2, 3, 6, 7 in `ib`, and each gather
+// loads the pairs of consecutive values to interpolate between.
+static inline __m256 sincLookupX8(const float* table, __m128i ia, __m128i ib, __m256 mu) noexcept
+{
+    const double* pairs = reinterpret_cast<const double*>(table);
+    const __m256 pa = _mm256_castpd_ps(_mm256_i32gather_pd(pairs, ia, sizeof(float)));
+    const __m256 pb = _mm256_castpd_ps(_mm256_i32gather_pd(pairs, ib, sizeof(float)));
+    const __m256 y0 = _mm256_shuffle_ps(pa, pb, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 y1 = _mm256_shuffle_ps(pa, pb, _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm256_add_ps(y0, _mm256_mul_ps(mu, _mm256_sub_ps(y1, y0)));
+}
+
+// Load 4 consecutive points of 8 frames from an offset, one point per register
+static inline void loadQuadsX8(const float* source, const int* ind, int offset, __m256 x[4]) noexcept
+{
+    // frames 0-3 in the lower lane, frames 4-7 in the upper lane
+    for (int k = 0; k < 4; ++k) {
+        x[k] = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(&source[ind[k] + offset])),
+            _mm_loadu_ps(&source[ind[k + 4] + offset]), 1);
+    }
+
+    // transpose the 4x4 blocks of both lanes
+    const __m256 t0 = _mm256_unpacklo_ps(x[0], x[1]);
+    const __m256 t1 = _mm256_unpacklo_ps(x[2], x[3]);
+    const __m256 t2 = _mm256_unpackhi_ps(x[0], x[1]);
+    const __m256 t3 = _mm256_unpackhi_ps(x[2], x[3]);
+    x[0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    x[1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    x[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    x[3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+#endif
+
+bool sincInterpolatorAVX2Built() noexcept
+{
+    return SFIZZ_HAVE_AVX2;
+}
+
+void sincInterpolateAVX2(
+    const float* table, unsigned points, unsigned tableSize,
+    const float* leftSource, const float* rightSource, float* left, float* right,
+    const int* indices, const float* coeffs, const float* addingGains,
+    unsigned size) noexcept
+{
+    // the table index of x is (x + points / 2) * scale, see AbstractWindowedSinc
+    const float scale = static_cast<float>((tableSize - 1) / points);
+    const float halfPoints = points / 2.0f;
+    const int j0 = 1 - static_cast<int>(points) / 2;
+    const bool stereo = rightSource != nullptr;
+
+#if SFIZZ_HAVE_AVX2
+    const __m256 mmScale = _mm256_set1_ps(scale);
+    const __m128i mmStep = _mm_set1_epi32(static_cast<int>(scale));
+
+    // 8 frames at once, the frames in the lanes of the registers
+    unsigned n = 0;
+    for (; n + 8 <= size; n += 8) {
+        const int* ind = &indices[n];
+
+        // table position of the first point, offset by half the points; the
+        // scale is integral, so the next points share the fractional part
+        const __m256 ix = _mm256_mul_ps(
+            _mm256_sub_ps(_mm256_set1_ps(j0 + halfPoints), _mm256_loadu_ps(&coeffs[n])), mmScale);
+        const __m256i i0 = _mm256_cvttps_epi32(ix);
+        const __m256 mu = _mm256_sub_ps(ix, _mm256_cvtepi32_ps(i0));
+        const __m256i i0Pairs = _mm256_permutevar8x32_epi32(i0, _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7));
+        __m128i ia = _mm256_castsi256_si128(i0Pairs);
+        __m128i ib = _mm256_extracti128_si256(i0Pairs, 1);
+
+        __m256 yl = _mm256_setzero_ps();
+        __m256 yr = _mm256_setzero_ps();
+
+        for (unsigned i = 0; i < points; i += 4) {
+            __m256 l[4];
+            __m256 r[4];
+            loadQuadsX8(leftSource, ind, j0 + static_cast<int>(i), l);
+            if (stereo)
+                loadQuadsX8(rightSource, ind, j0 + static_cast<int>(i), r);
+            for (unsigned k = 0; k < 4; ++k) {
+                const __m256 h = sincLookupX8(table, ia, ib, mu);
+                yl = _mm256_add_ps(yl, _mm256_mul_ps(h, l[k]));
+                if (stereo)
+                    yr = _mm256_add_ps(yr, _mm256_mul_ps(h, r[k]));
+                ia = _mm_add_epi32(ia, mmStep);
+                ib = _mm_add_epi32(ib, mmStep);
+            }
+        }
+
+        if (addingGains) {
+            const __m256 gains = _mm256_loadu_ps(&addingGains[n]);
+            yl = _mm256_add_ps(_mm256_loadu_ps(&left[n]), _mm256_mul_ps(gains, yl));
+            if (stereo)
+                yr = _mm256_add_ps(_mm256_loadu_ps(&right[n]), _mm256_mul_ps(gains, yr));
+        }
+        _mm256_storeu_ps(&left[n], yl);
+        if (stereo)
+            _mm256_storeu_ps(&right[n], yr);
+    }
+#else
+    unsigned n = 0;
+#endif
+
+    // the remaining frames one at a time
+    for (; n < size; ++n) {
+        const float* l = &leftSource[indices[n] + j0];
+        const float* r = stereo ? &rightSource[indices[n] + j0] : nullptr;
+        float yl = 0.0f;
+        float yr = 0.0f;
+        for (unsigned i = 0; i < points; ++i) {
+            const float ix = (j0 - coeffs[n] + halfPoints + i) * scale;
+            const int i0 = static_cast<int>(ix);
+            const float h = table[i0] + (ix - i0) * (table[i0 + 1] - table[i0]);
+            yl += h * l[i];
+            if (stereo)
+                yr += h * r[i];
+        }
+
+        left[n] = addingGains ? left[n] + addingGains[n] * yl : yl;
+        if (stereo)
+            right[n] = addingGains ? right[n] + addingGains[n] * yr : yr;
+    }
+}
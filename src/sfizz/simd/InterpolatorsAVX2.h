@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+
+/* Whether this file was built for AVX2; otherwise the kernel runs the scalar code */
+bool sincInterpolatorAVX2Built() noexcept;
+
+/**
+ * @brief Windowed-sinc interpolation of a block of frames, AVX2 version
+ *
+ * @param table the lookup table of the windowed sinc
+ * @param points the number of points of the windowed sinc, multiple of 4
+ * @param tableSize the size of the lookup table
+ * @param leftSource the left (or mono) source channel
+ * @param rightSource the right source channel, or nullptr if the source is mono
+ * @param left the left output channel
+ * @param right the right output channel, unused if the source is mono
+ * @param indices the integer positions in the source
+ * @param coeffs the interpolation coefficients
+ * @param addingGains the gains to add to the outputs with, or nullptr to replace the outputs
+ * @param size the number of frames
+ */
+void sincInterpolateAVX2(
+    const float* table, unsigned points, unsigned tableSize,
+    const float* leftSource, const float* rightSource, float* left, float* right,
+    const int* indices, const float* coeffs, const float* addingGains,
+    unsigned size) noexcept;
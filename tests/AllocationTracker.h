@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Count the heap allocations made by the current thread through the
+ * global `operator new`, during the lifetime of the object.
+ *
+ * The test executable replaces the global allocation operators to keep a
+ * per-thread counter, so that the allocations of background threads do not
+ * interfere with the measurement.
+ */
+class ScopedAllocationCounter {
+public:
+    ScopedAllocationCounter() noexcept;
+    ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+    ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+    /**
+     * @brief Get the number of allocations since the construction
+     */
+    size_t getNumAllocations() const noexcept;
+
+private:
+    size_t initialCount_ {};
+};
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-2-Clause
+
+// This code is part of the sfizz library and is licensed under a BSD 2-clause
+// license. You should have receive a LICENSE.md file along with the code.
+// If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
+
+#include "sfizz/Synth.h"
+#include "sfizz/AudioBuffer.h"
+#include "sfizz/SIMDHelpers.h"
+#include "AllocationTracker.h"
+#include "catch2/catch.hpp"
+#include <new>
+
+namespace {
+/**
+ * @brief Render a few blocks to let the synth settle, then count the
+ * allocations made while rendering more blocks.
+ */
+size_t countRenderAllocations(sfz::Synth& synth, sfz::AudioBuffer<float>& buffer, unsigned numBlocks = 16)
+{
+    synth.renderBlock(buffer);
+
+    ScopedAllocationCounter counter;
+    for (unsigned i = 0; i < numBlocks; ++i)
+        synth.renderBlock(buffer);
+
+    return counter.getNumAllocations();
+}
+}
+
+TEST_CASE("[Allocations] Sanity check of the allocation counter")
+{
+    static void* volatile memory;
+    ScopedAllocationCounter counter;
+    REQUIRE( counter.getNumAllocations() == 0 );
+    memory = ::operator new(16);
+    ::operator delete(memory);
+    REQUIRE( counter.getNumAllocations() == 1 );
+}
+
+TEST_CASE("[Allocations] Rendering voices does not allocate")
+{
+    constexpr size_t blockSize { 256 };
+    sfz::Synth synth;
+    synth.setSamplesPerBlock(blockSize);
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/allocations.sfz", R"(
+        <region> sample=*sine key=60
+        <region> sample=*saw key=62 lfo1_freq=3 lfo1_pitch=50
+        <region> sample=*triangle key=64 fil_type=lpf_2p cutoff=800
+    )");
+    synth.noteOn(0, 60, 100);
+    synth.noteOn(10, 62, 100);
+    synth.noteOn(20, 64, 100);
+    sfz::AudioBuffer<float> buffer { 2, blockSize };
+    REQUIRE( countRenderAllocations(synth, buffer) == 0 );
+    REQUIRE( synth.getNumActiveVoices() == 3 );
+}
+
+TEST_CASE("[Allocations] Rendering oversampled voices does not allocate")
+{
+    constexpr size_t blockSize { 256 };
+    sfz::Synth synth;
+    synth.setSampleRate(48000);
+    synth.setSamplesPerBlock(blockSize);
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/allocations_oversampled.sfz", R"(
+        <control> hint_min_samplerate=192000
+        <region> sample=*sine key=60
+        <region> sample=*saw key=62
+    )");
+    synth.noteOn(0, 60, 100);
+    synth.noteOn(0, 62, 100);
+    sfz::AudioBuffer<float> buffer { 2, blockSize };
+    REQUIRE( countRenderAllocations(synth, buffer) == 0 );
+    REQUIRE( synth.getNumActiveVoices() == 2 );
+    // the voices get their oversampled buffers and play
+    REQUIRE( sfz::sumSquares<float>(buffer.getConstSpan(0)) > 0.0f );
+    REQUIRE( sfz::sumSquares<float>(buffer.getConstSpan(1)) > 0.0f );
+}
@@ -7,6 +7,10 @@
 #include "TestHelpers.h"
 #include "sfizz/Synth.h"
 #include "sfizz/Voice.h"
+#include "sfizz/FileStream.h"
+#include "sfizz/MappedSample.h"
+#include "sfizz/SampleCache.h"
+#include "sfizz/AudioReader.h"
 #include "sfizz/SfzHelpers.h"
 #include "sfizz/parser/Parser.h"
 #include "sfizz/modulations/ModId.h"
@@ -686,3 +690,339 @@ TEST_CASE("[Files] Key center from audio file")
     REQUIRE(synth.getRegionView(4)->pitchKeycenter == 10);
     REQUIRE(synth.getRegionView(5)->pitchKeycenter == 62);
 }
+
+TEST_CASE("[Files] Disk streaming fills the ring ahead of the playhead")
+{
+    Synth synth;
+    synth.setDiskStreaming(true);
+    REQUIRE( synth.isDiskStreaming() );
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/disk_streaming.sfz", R"(
+        <region> sample=kick.wav
+    )");
+    REQUIRE( synth.getNumRegions() == 1 );
+
+    const fs::path path = fs::current_path() / "tests/TestFiles/kick.wav";
+    const auto fileId = synth.getRegionView(0)->sampleId;
+    FilePool& filePool = synth.getResources().getFilePool();
+    FileDataHolder data = filePool.getFilePromise(fileId);
+    REQUIRE( data );
+    const auto numFrames = static_cast<size_t>(data->information.end + 1);
+    const auto preloadedFrames = static_cast<int64_t>(data->getNumPreloadedFrames());
+    REQUIRE( preloadedFrames < static_cast<int64_t>(numFrames) );
+
+    std::vector<float> expected(numFrames);
+    AudioReaderPtr reader = createAudioReader(path, false);
+    REQUIRE( reader->channels() == 1 );
+    REQUIRE( reader->readNextBlock(expected.data(), numFrames) == numFrames );
+
+    FileStream stream;
+    AudioBuffer<float> buffer { 1, 4096 };
+    const auto readsLikeTheFile = [&](int64_t first, size_t count) {
+        AudioSpan<float> output = AudioSpan<float>(buffer).first(count);
+        if (!stream.read(*data, first, output))
+            return false;
+        return approxEqual<float>(output.getConstSpan(0), absl::MakeConstSpan(&expected[first], count));
+    };
+
+    stream.attach(*data);
+    stream.setPlayhead(0, 0, -1);
+    REQUIRE( stream.shouldRequestRefill() );
+    stream.clearRefillRequest();
+    stream.refill(path, *fileId, stream.getGeneration());
+    REQUIRE( readsLikeTheFile(preloadedFrames - 100, 4096) );
+    REQUIRE( readsLikeTheFile(preloadedFrames + 16384, 4096) );
+
+    // Past the end of a loop, the chunks at the loop start come next
+    const int64_t loopStart = preloadedFrames + 1000;
+    const int64_t loopEnd = static_cast<int64_t>(numFrames) - 1000;
+    stream.setPlayhead(loopEnd - 500, loopStart, loopEnd);
+    stream.refill(path, *fileId, stream.getGeneration());
+    REQUIRE( readsLikeTheFile(loopEnd - 500, 500) );
+    REQUIRE( readsLikeTheFile(loopStart, 4096) );
+
+    // A stale request does not fill the ring of a new attachment
+    const uint32_t staleGeneration = stream.getGeneration();
+    stream.attach(*data);
+    stream.refill(path, *fileId, staleGeneration);
+    REQUIRE( !readsLikeTheFile(preloadedFrames, 1024) );
+}
+
+TEST_CASE("[Files] Streamed samples render like the loaded ones")
+{
+    const std::string sfzText = R"(
+        <region> key=60 sample=kick.wav
+        <region> key=61 sample=kick.wav direction=reverse
+    )";
+
+    Synth loadedSynth;
+    loadedSynth.loadSfzString(fs::current_path() / "tests/TestFiles/disk_streaming.sfz", sfzText);
+    Synth streamedSynth;
+    streamedSynth.setDiskStreaming(true);
+    streamedSynth.loadSfzString(fs::current_path() / "tests/TestFiles/disk_streaming.sfz", sfzText);
+    REQUIRE( streamedSynth.getNumRegions() == 2 );
+
+    // Wait for the loads between the blocks, so that the loaded synth has the
+    // whole files and the rings of the streamed one never underrun
+    loadedSynth.enableFreeWheeling();
+    streamedSynth.enableFreeWheeling();
+
+    const fs::path path = fs::current_path() / "tests/TestFiles/kick.wav";
+    const auto numFrames = createAudioReader(path, false)->frames();
+    const auto blockSize = static_cast<size_t>(streamedSynth.getSamplesPerBlock());
+    AudioBuffer<float> expectedBuffer { 2, blockSize };
+    AudioBuffer<float> streamedBuffer { 2, blockSize };
+    loadedSynth.noteOn(0, 60, 100);
+    loadedSynth.noteOn(0, 61, 100);
+    streamedSynth.noteOn(0, 60, 100);
+    streamedSynth.noteOn(0, 61, 100);
+    for (int64_t frame = 0; frame < numFrames; frame += blockSize) {
+        loadedSynth.renderBlock(expectedBuffer);
+        streamedSynth.renderBlock(streamedBuffer);
+        for (size_t c = 0; c < 2; ++c) {
+            absl::Span<const float> expected = expectedBuffer.getConstSpan(c);
+            absl::Span<const float> streamed = streamedBuffer.getConstSpan(c);
+            for (size_t i = 0; i < blockSize; ++i)
+                REQUIRE( streamed[i] == Approx(expected[i]).margin(1e-6) );
+        }
+    }
+}
+
+TEST_CASE("[Files] Seeking reverse readers read like the whole file")
+{
+    const fs::path path = fs::current_path() / "tests/TestFiles/kick.wav";
+    AudioReaderPtr wholeReader = createExplicitAudioReader(path, AudioReaderType::NoSeekReverse);
+    const auto numFrames = static_cast<size_t>(wholeReader->frames());
+    const unsigned numChannels = wholeReader->channels();
+    std::vector<float> expected(numChannels * numFrames);
+    REQUIRE( wholeReader->readNextBlock(expected.data(), numFrames) == numFrames );
+
+    // The streaming loaders seek to chunks out of order
+    for (AudioReaderType type : { AudioReaderType::Reverse, AudioReaderType::NoSeekReverse }) {
+        AudioReaderPtr reader = createExplicitAudioReader(path, type);
+        const size_t chunkSize = 1000;
+        std::vector<float> chunk(numChannels * chunkSize);
+        for (size_t first : { size_t(5000), size_t(0), numFrames - 300, size_t(12345) }) {
+            REQUIRE( reader->seek(first) );
+            const size_t count = reader->readNextBlock(chunk.data(), chunkSize);
+            REQUIRE( count == std::min(chunkSize, numFrames - first) );
+            REQUIRE( approxEqual<float>(
+                absl::MakeConstSpan(chunk.data(), numChannels * count),
+                absl::MakeConstSpan(&expected[numChannels * first], numChannels * count)) );
+        }
+        REQUIRE( !reader->seek(numFrames + 1) );
+    }
+}
+
+TEST_CASE("[Files] Memory-mapped samples read like the decoded files")
+{
+    Synth synth;
+    synth.setSampleMemoryMapping(true);
+    REQUIRE( synth.isSampleMemoryMapping() );
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/memory_mapping.sfz", R"(
+        <region> key=60 sample=looped_flute.wav
+        <region> key=61 sample=stereo_sample.wav
+        <region> key=62 sample=kick.wav direction=reverse
+    )");
+    REQUIRE( synth.getNumRegions() == 3 );
+
+    FilePool& filePool = synth.getResources().getFilePool();
+    for (int i = 0; i < 3; ++i) {
+        const auto fileId = synth.getRegionView(i)->sampleId;
+        FileDataHolder data = filePool.getFilePromise(fileId);
+        REQUIRE( data );
+        REQUIRE( data->mappedData );
+
+        const fs::path path = fs::current_path() / "tests/TestFiles" / fileId->filename();
+        AudioReaderPtr reader = createAudioReader(path, fileId->isReverse());
+        const size_t numChannels = reader->channels();
+        const auto numFrames = static_cast<size_t>(reader->frames());
+        REQUIRE( data->mappedData->getNumFrames() == static_cast<int64_t>(numFrames) );
+        REQUIRE( data->mappedData->getNumChannels() == numChannels );
+
+        std::vector<float> expected(numChannels * numFrames);
+        REQUIRE( reader->readNextBlock(expected.data(), numFrames) == numFrames );
+
+        // Frames outside of the file read as zeros
+        const size_t margin = 16;
+        AudioBuffer<float> buffer { numChannels, numFrames + 2 * margin };
+        data->mappedData->read(-static_cast<int64_t>(margin), AudioSpan<float>(buffer));
+        for (size_t c = 0; c < numChannels; ++c) {
+            absl::Span<const float> channel = buffer.getConstSpan(c);
+            for (size_t f = 0; f < numFrames; ++f)
+                REQUIRE( channel[margin + f] == Approx(expected[f * numChannels + c]).margin(1e-6) );
+            for (size_t f = 0; f < margin; ++f) {
+                REQUIRE( channel[f] == 0.0f );
+                REQUIRE( channel[margin + numFrames + f] == 0.0f );
+            }
+        }
+    }
+
+    // The voices render the mapped samples like the ones loaded in memory
+    Synth loadedSynth;
+    loadedSynth.loadSfzString(fs::current_path() / "tests/TestFiles/memory_mapping.sfz", R"(
+        <control> hint_ram_based=1
+        <region> key=60 sample=looped_flute.wav
+    )");
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/memory_mapping.sfz", R"(
+        <region> key=60 sample=looped_flute.wav
+    )");
+
+    AudioBuffer<float> expectedBuffer { 2, static_cast<size_t>(synth.getSamplesPerBlock()) };
+    AudioBuffer<float> mappedBuffer { 2, static_cast<size_t>(synth.getSamplesPerBlock()) };
+    loadedSynth.noteOn(0, 60, 100);
+    synth.noteOn(0, 60, 100);
+    for (int block = 0; block < 100; ++block) {
+        loadedSynth.renderBlock(expectedBuffer);
+        synth.renderBlock(mappedBuffer);
+        REQUIRE( approxEqual(mappedBuffer.getConstSpan(0), expectedBuffer.getConstSpan(0)) );
+        REQUIRE( approxEqual(mappedBuffer.getConstSpan(1), expectedBuffer.getConstSpan(1)) );
+    }
+}
+
+TEST_CASE("[Files] Sample cache")
+{
+    const fs::path cacheDirectory = fs::temp_directory_path() / "sfizz_test_sample_cache";
+    std::error_code ec;
+    fs::remove_all(cacheDirectory, ec);
+
+    const std::string sfzText = R"(
+        <region> key=60 sample=looped_flute.wav
+        <region> key=61 sample=kick.wav offset=10000
+    )";
+
+    // The synths do not live together, so that the second one does not share
+    // the sample data of the first one and reads the cache instead
+    struct LoadedRegion {
+        Range<int64_t> loopRange;
+        absl::optional<LoopMode> loopMode;
+        int64_t sampleEnd;
+        bool hasStereoSample;
+        bool mappedFromCache;
+        std::vector<std::vector<float>> preloadedData;
+    };
+
+    const auto loadRegions = [&]() {
+        Synth synth;
+        synth.setSampleCacheDirectory(cacheDirectory);
+        synth.loadSfzString(fs::current_path() / "tests/TestFiles/sample_cache.sfz", sfzText);
+        REQUIRE( synth.getNumRegions() == 2 );
+
+        std::vector<LoadedRegion> regions;
+        for (int i = 0; i < 2; ++i) {
+            const Region* region = synth.getRegionView(i);
+            FileDataHolder data = synth.getResources().getFilePool().getFilePromise(region->sampleId);
+            REQUIRE( data );
+
+            LoadedRegion loaded { region->loopRange, region->loopMode, region->sampleEnd,
+                region->hasStereoSample, data->preloadedMapping != nullptr, {} };
+            for (size_t c = 0; c < data->getPreloadedData().getNumChannels(); ++c) {
+                absl::Span<const float> channel = data->getPreloadedData().getConstSpan(c);
+                loaded.preloadedData.emplace_back(channel.begin(), channel.end());
+                // the interpolators read the padding before the first frame
+                for (int f = 1; f <= config::excessFileFrames; ++f)
+                    REQUIRE( channel.data()[-f] == 0.0f );
+            }
+            regions.push_back(std::move(loaded));
+        }
+        return regions;
+    };
+
+    const std::vector<LoadedRegion> coldRegions = loadRegions();
+    REQUIRE( std::distance(fs::directory_iterator(cacheDirectory), fs::directory_iterator()) == 2 );
+
+    const std::vector<LoadedRegion> warmRegions = loadRegions();
+
+    for (int i = 0; i < 2; ++i) {
+        const LoadedRegion& coldRegion = coldRegions[i];
+        const LoadedRegion& warmRegion = warmRegions[i];
+        REQUIRE( coldRegion.loopRange == warmRegion.loopRange );
+        REQUIRE( coldRegion.loopMode == warmRegion.loopMode );
+        REQUIRE( coldRegion.sampleEnd == warmRegion.sampleEnd );
+        REQUIRE( coldRegion.hasStereoSample == warmRegion.hasStereoSample );
+        REQUIRE( !coldRegion.mappedFromCache );
+        REQUIRE( warmRegion.mappedFromCache );
+        REQUIRE( coldRegion.preloadedData.size() == warmRegion.preloadedData.size() );
+        for (size_t c = 0; c < coldRegion.preloadedData.size(); ++c)
+            REQUIRE( approxEqual<float>(coldRegion.preloadedData[c], warmRegion.preloadedData[c], 0.0f) );
+    }
+
+    // Only the preloaded heads are cached for the files loaded whole
+    fs::remove_all(cacheDirectory, ec);
+    {
+        Synth synth;
+        synth.setSampleCacheDirectory(cacheDirectory);
+        synth.loadSfzString(fs::current_path() / "tests/TestFiles/sample_cache.sfz", R"(
+            <control> hint_ram_based=1
+            <region> key=60 sample=looped_flute.wav
+        )");
+        REQUIRE( synth.getNumRegions() == 1 );
+
+        SampleCache cache;
+        cache.setDirectory(cacheDirectory);
+        SampleCache::Entry entry;
+        REQUIRE( cache.lookup(fs::current_path() / "tests/TestFiles/looped_flute.wav", false, entry) );
+        REQUIRE( entry.numFrames == std::min<int64_t>(synth.getPreloadSize(), entry.information.end + 1) );
+        REQUIRE( entry.numFrames < entry.information.end + 1 );
+    }
+
+    fs::remove_all(cacheDirectory, ec);
+}
+
+TEST_CASE("[Files] Synths share the sample data")
+{
+    const std::string sfzText = R"(
+        <region> key=60 sample=looped_flute.wav
+        <region> key=61 sample=kick.wav
+    )";
+    const fs::path sfzPath = fs::current_path() / "tests/TestFiles/sample_store.sfz";
+
+    // Streaming keeps the promises from loading the files in the background
+    Synth synth1;
+    synth1.setDiskStreaming(true);
+    synth1.loadSfzString(sfzPath, sfzText);
+    Synth synth2;
+    synth2.setDiskStreaming(true);
+    synth2.loadSfzString(sfzPath, sfzText);
+    REQUIRE( synth1.getNumRegions() == 2 );
+    REQUIRE( synth2.getNumRegions() == 2 );
+
+    FilePool& filePool1 = synth1.getResources().getFilePool();
+    FilePool& filePool2 = synth2.getResources().getFilePool();
+    for (int i = 0; i < 2; ++i) {
+        FileDataHolder data1 = filePool1.getFilePromise(synth1.getRegionView(i)->sampleId);
+        FileDataHolder data2 = filePool2.getFilePromise(synth2.getRegionView(i)->sampleId);
+        REQUIRE( data1 );
+        REQUIRE( data2 );
+        REQUIRE( &*data1 == &*data2 );
+    }
+
+    SampleStore::Stats stats = synth1.getSampleStoreStats();
+    REQUIRE( stats.numUsers == 2 );
+    REQUIRE( stats.numSamples == 2 );
+    REQUIRE( stats.numSharedSamples == 2 );
+    REQUIRE( stats.loadedBytes == 0 );
+    REQUIRE( stats.savedBytes == stats.preloadedBytes );
+
+    // Different preloading settings do not share the data
+    synth2.setPreloadSize(1024);
+    for (int i = 0; i < 2; ++i) {
+        FileDataHolder data1 = filePool1.getFilePromise(synth1.getRegionView(i)->sampleId);
+        FileDataHolder data2 = filePool2.getFilePromise(synth2.getRegionView(i)->sampleId);
+        REQUIRE( &*data1 != &*data2 );
+        REQUIRE( data1->getNumPreloadedFrames() == std::min<size_t>(config::preloadSize, data1->information.end + 1) );
+        REQUIRE( data2->getNumPreloadedFrames() == 1024 );
+    }
+
+    stats = synth1.getSampleStoreStats();
+    REQUIRE( stats.numSamples == 4 );
+    REQUIRE( stats.numSharedSamples == 0 );
+
+    // The data of a synth outlives the other ones
+    synth1.loadSfzString(sfzPath, "");
+    stats = synth2.getSampleStoreStats();
+    REQUIRE( stats.numSamples == 2 );
+    for (int i = 0; i < 2; ++i) {
+        FileDataHolder data2 = filePool2.getFilePromise(synth2.getRegionView(i)->sampleId);
+        REQUIRE( data2->getNumPreloadedFrames() == 1024 );
+    }
+}
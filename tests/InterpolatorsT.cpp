@@ -7,7 +7,9 @@
 #include "sfizz/Interpolators.h"
 #include "catch2/catch.hpp"
 #include <array>
+#include <cmath>
 #include <numeric>
+#include <vector>
 using namespace Catch::literals;
 
 TEST_CASE("[Interpolators] Sample at points")
@@ -127,3 +129,74 @@ TEST_CASE("[Interpolators] Windowed sinc precision")
     Check(windowedSincError(*sfz::SincInterpolatorTraits<60>::windowedSinc));
     Check(windowedSincError(*sfz::SincInterpolatorTraits<72>::windowedSinc));
 }
+
+template <sfz::InterpolatorModel M>
+static void checkBlockInterpolation(bool useAVX2 = false)
+{
+    constexpr unsigned numFrames = 61;
+    constexpr int padding = 40;
+    std::vector<float> leftSource(2 * numFrames + 2 * padding);
+    std::vector<float> rightSource(leftSource.size());
+    for (size_t i = 0; i < leftSource.size(); ++i) {
+        leftSource[i] = std::sin(0.1f * i);
+        rightSource[i] = std::cos(0.13f * i);
+    }
+
+    std::vector<int> indices(numFrames);
+    std::vector<float> coeffs(numFrames);
+    std::vector<float> gains(numFrames);
+    for (unsigned i = 0; i < numFrames; ++i) {
+        float position = padding + 1.37f * i;
+        indices[i] = static_cast<int>(position);
+        coeffs[i] = position - indices[i];
+        gains[i] = 0.5f + 0.01f * i;
+    }
+
+    std::vector<float> expectedLeft(numFrames);
+    std::vector<float> expectedRight(numFrames);
+    std::vector<float> left(numFrames);
+    std::vector<float> right(numFrames);
+    const float mod = 1.0f;
+
+    for (unsigned i = 0; i < numFrames; ++i) {
+        expectedLeft[i] = sfz::interpolate<M>(&leftSource[indices[i]], coeffs[i], mod);
+        expectedRight[i] = sfz::interpolate<M>(&rightSource[indices[i]], coeffs[i], mod);
+    }
+
+    sfz::interpolateBlock<M, false>(
+        leftSource.data(), rightSource.data(), left.data(), right.data(),
+        indices.data(), coeffs.data(), nullptr, numFrames, mod, useAVX2);
+    for (unsigned i = 0; i < numFrames; ++i) {
+        REQUIRE(left[i] == Approx(expectedLeft[i]).margin(1e-5));
+        REQUIRE(right[i] == Approx(expectedRight[i]).margin(1e-5));
+    }
+
+    std::fill(left.begin(), left.end(), 1.0f);
+    sfz::interpolateBlock<M, true>(
+        leftSource.data(), nullptr, left.data(), nullptr,
+        indices.data(), coeffs.data(), gains.data(), numFrames, mod, useAVX2);
+    for (unsigned i = 0; i < numFrames; ++i)
+        REQUIRE(left[i] == Approx(1.0f + gains[i] * expectedLeft[i]).margin(1e-5));
+}
+
+TEST_CASE("[Interpolators] Block interpolation")
+{
+    sfz::initializeInterpolators();
+
+    checkBlockInterpolation<sfz::kInterpolatorNearest>();
+    checkBlockInterpolation<sfz::kInterpolatorLinear>();
+    checkBlockInterpolation<sfz::kInterpolatorHermite3>();
+    checkBlockInterpolation<sfz::kInterpolatorBspline3>();
+
+    // windowed sincs, with and without AVX2
+    for (bool avx2 : { false, sfz::interpolatorsUseAVX2() }) {
+        checkBlockInterpolation<sfz::kInterpolatorSinc8>(avx2);
+        checkBlockInterpolation<sfz::kInterpolatorSinc12>(avx2);
+        checkBlockInterpolation<sfz::kInterpolatorSinc16>(avx2);
+        checkBlockInterpolation<sfz::kInterpolatorSinc24>(avx2);
+        checkBlockInterpolation<sfz::kInterpolatorSinc36>(avx2);
+        checkBlockInterpolation<sfz::kInterpolatorSinc48>(avx2);
+        checkBlockInterpolation<sfz::kInterpolatorSinc60>(avx2);
+        checkBlockInterpolation<sfz::kInterpolatorSinc72>(avx2);
+    }
+}
@@ -5,8 +5,10 @@
 // If not, contact the sfizz maintainers at https://github.com/sfztools/sfizz
 
 #include "sfizz/modulations/ModMatrix.h"
+#include "sfizz/modulations/ModGenerator.h"
 #include "sfizz/modulations/ModId.h"
 #include "sfizz/modulations/ModKey.h"
+#include "sfizz/SIMDHelpers.h"
 #include "sfizz/Synth.h"
 #include "TestHelpers.h"
 #include "catch2/catch.hpp"
@@ -558,3 +560,83 @@ TEST_CASE("[Modulations] Extended CCs connections")
         R"("Controller 1 {curve=1, smooth=10, step=0.1}" -> "LFOPhase {0, N=3}")",
     }, 1));
 }
+
+namespace {
+// Generates the controllers at 0.5 and the other sources at 2, and counts
+// the generated cycles
+class ConstantGenerator : public sfz::ModGenerator {
+public:
+    void init(const sfz::ModKey&, NumericId<sfz::Voice>, unsigned) override {}
+    void generate(const sfz::ModKey& sourceKey, NumericId<sfz::Voice>, absl::Span<float> buffer) override
+    {
+        sfz::fill(buffer, (sourceKey.id() == sfz::ModId::Controller) ? 0.5f : 2.0f);
+        ++numGenerated;
+    }
+    int numGenerated { 0 };
+};
+} // namespace
+
+TEST_CASE("[Modulations] Evaluation of the matrix")
+{
+    constexpr unsigned numFrames = 16;
+    const NumericId<sfz::Region> region { 0 };
+    const NumericId<sfz::Voice> voice { 0 };
+
+    ConstantGenerator gen;
+    sfz::ModMatrix mm;
+    mm.setSamplesPerBlock(numFrames);
+
+    const sfz::ModKey pitchEGKey = sfz::ModKey::createNXYZ(sfz::ModId::PitchEG, region);
+    const sfz::ModKey pitchKey = sfz::ModKey::createNXYZ(sfz::ModId::Pitch, region);
+    const sfz::ModKey depthKey = sfz::ModKey::getSourceDepthKey(pitchEGKey, pitchKey);
+    const sfz::ModKey amplitudeKey = sfz::ModKey::createNXYZ(sfz::ModId::Amplitude, region);
+    auto pitchEG = mm.registerSource(pitchEGKey, gen);
+    auto cc1 = mm.registerSource(sfz::ModKey::createCC(1, 0, 0, 0), gen);
+    auto cc2 = mm.registerSource(sfz::ModKey::createCC(2, 0, 0, 0), gen);
+    auto pitch = mm.registerTarget(pitchKey);
+    auto depth = mm.registerTarget(depthKey);
+    auto amplitude = mm.registerTarget(amplitudeKey);
+    const NumericId<sfz::Region> otherRegion { 1 };
+    auto otherPitch = mm.registerTarget(sfz::ModKey::createNXYZ(sfz::ModId::Pitch, otherRegion));
+
+    // the pitch EG depth is modulated by a controller and the velocity
+    REQUIRE( mm.connect(pitchEG, pitch, 100.0f, depthKey, 20.0f) );
+    REQUIRE( mm.connect(cc1, depth, 10.0f, {}, 0.0f) );
+    REQUIRE( mm.connect(cc2, pitch, 4.0f, {}, 0.0f) );
+    REQUIRE( mm.connect(pitchEG, amplitude, 0.5f, {}, 0.0f) );
+    REQUIRE( mm.connect(cc2, amplitude, 3.0f, {}, 0.0f) );
+    mm.init();
+
+    mm.beginCycle(numFrames);
+    mm.beginVoice(voice, region, 0.5f);
+    const float* pitchMod = mm.getModulation(pitch);
+    REQUIRE( pitchMod );
+    REQUIRE( pitchMod[0] == (100.0f + 0.5f * 20.0f + 0.5f * 10.0f) * 2.0f + 0.5f * 4.0f );
+    REQUIRE( pitchMod[numFrames - 1] == pitchMod[0] );
+    const float* amplitudeMod = mm.getModulation(amplitude);
+    REQUIRE( amplitudeMod );
+    REQUIRE( amplitudeMod[0] == 0.5f * 2.0f * 3.0f * 0.5f );
+    REQUIRE( gen.numGenerated == 3 );
+
+    // the buffers are ready until the next voice
+    REQUIRE( mm.getModulation(pitch) == pitchMod );
+    REQUIRE( gen.numGenerated == 3 );
+    mm.endVoice();
+
+    // the sources of the voice are generated again, but not the controllers
+    mm.beginVoice(voice, region, 0.5f);
+    REQUIRE( mm.getModulation(pitch)[0] == pitchMod[0] );
+    REQUIRE( gen.numGenerated == 4 );
+    mm.endVoice();
+    mm.endCycle();
+
+    mm.beginCycle(numFrames);
+    mm.beginVoice(voice, region, 0.5f);
+    REQUIRE( mm.getModulation(pitch)[0] == pitchMod[0] );
+    REQUIRE( gen.numGenerated == 7 );
+
+    // the targets of other regions are not visible
+    REQUIRE( !mm.getModulation(otherPitch) );
+    mm.endVoice();
+    mm.endCycle();
+}
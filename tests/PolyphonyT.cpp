@@ -13,6 +13,7 @@
 // Need these for the introspection of Synth
 #include "sfizz/PolyphonyGroup.h"
 #include "sfizz/RegionSet.h"
+#include "sfizz/SisterVoiceRing.h"
 
 using namespace Catch::literals;
 using namespace sfz::literals;
@@ -570,3 +571,103 @@ TEST_CASE("[Polyphony] Choke long release tails with note_polyphony")
     REQUIRE( numPlayingVoices(synth) == 1 ); // Not released, attack phase
     REQUIRE( numActiveVoices(synth) == 1 );
 }
+
+// The stealing algorithms as they were with sorted candidates, to check that
+// the ordered candidates select the same voices
+static const sfz::Voice* referenceStealer(std::vector<const sfz::Voice*> voices, bool envelopeAndAge)
+{
+    absl::c_sort(voices, sfz::voiceOrdering);
+    if (!envelopeAndAge)
+        return voices.front();
+
+    const auto sumPower = absl::c_accumulate(voices, 0.0f, [](float sum, const sfz::Voice* v) {
+        return sum + v->getAveragePower();
+    });
+    const auto powerThreshold = sumPower
+        / static_cast<float>(voices.size()) * sfz::config::stealingPowerCoeff;
+    const auto ageThreshold =
+        static_cast<int>(voices.front()->getAge() * sfz::config::stealingAgeCoeff);
+
+    unsigned idx = 0;
+    while (idx < voices.size()) {
+        const auto ref = voices[idx];
+        if (ref->getAge() <= ageThreshold)
+            break;
+
+        float maxPower { 0.0f };
+        sfz::SisterVoiceRing::applyToRing(ref, [&](const sfz::Voice* v) {
+            maxPower = std::max(maxPower, v->getAveragePower());
+        });
+        if (maxPower < powerThreshold)
+            return ref;
+
+        do { idx++; }
+        while (idx < voices.size() && sfz::sisterVoices(ref, voices[idx]));
+    }
+
+    return voices.front();
+}
+
+static void checkStealingEquivalence(sfz::Synth& synth, unsigned polyphony, bool envelopeAndAge)
+{
+    sfz::AudioBuffer<float> buffer { 2, static_cast<unsigned>(synth.getSamplesPerBlock()) };
+    const int velocities[] = { 100, 20, 70, 127, 45, 90, 10, 60, 110, 35, 80, 5 };
+
+    unsigned numSteals = 0;
+    for (int i = 0; i < 36; ++i) {
+        std::vector<const sfz::Voice*> candidates;
+        for (const sfz::Voice* voice : getActiveVoices(synth)) {
+            if (!voice->offedOrFree())
+                candidates.push_back(voice);
+        }
+
+        const sfz::Voice* expected = nullptr;
+        if (candidates.size() >= polyphony)
+            expected = referenceStealer(candidates, envelopeAndAge);
+
+        synth.noteOn(0, 36 + i, velocities[i % 12]);
+
+        for (const sfz::Voice* voice : candidates) {
+            if (voice == expected)
+                REQUIRE( voice->offedOrFree() );
+            else
+                REQUIRE( !voice->offedOrFree() );
+        }
+        numSteals += (expected != nullptr);
+
+        synth.renderBlock(buffer);
+    }
+    REQUIRE( numSteals > 0 );
+}
+
+TEST_CASE("[Polyphony] Stealing from the ordered candidates")
+{
+    sfz::Synth synth;
+    for (const char* algorithm : { "first", "oldest", "envelope_and_age" }) {
+        const bool envelopeAndAge = std::string(algorithm) == "envelope_and_age";
+        const std::string control = std::string("<control> hint_stealing=") + algorithm;
+
+        SECTION(std::string("Region polyphony, ") + algorithm) {
+            synth.loadSfzString(fs::current_path() / "tests/TestFiles/polyphony.sfz", control + R"(
+                <region> sample=*sine polyphony=4 ampeg_attack=0.05 ampeg_release=1
+            )");
+            checkStealingEquivalence(synth, 4, envelopeAndAge);
+        }
+
+        SECTION(std::string("Group polyphony, ") + algorithm) {
+            synth.loadSfzString(fs::current_path() / "tests/TestFiles/polyphony.sfz", control + R"(
+                <group> group=1 polyphony=5
+                <region> sample=*sine ampeg_attack=0.05 ampeg_release=1
+            )");
+            checkStealingEquivalence(synth, 5, envelopeAndAge);
+        }
+
+        SECTION(std::string("Set polyphony, ") + algorithm) {
+            synth.loadSfzString(fs::current_path() / "tests/TestFiles/polyphony.sfz", control + R"(
+                <master> polyphony=6
+                <region> sample=*sine ampeg_attack=0.05 ampeg_release=1
+            )");
+            checkStealingEquivalence(synth, 6, envelopeAndAge);
+        }
+    }
+}
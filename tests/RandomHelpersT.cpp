@@ -6,6 +6,7 @@
 
 #include "catch2/catch.hpp"
 #include "sfizz/MathHelpers.h"
+#include "sfizz/NoiseGenerator.h"
 #include <vector>
 
 template <class T>
@@ -142,3 +143,68 @@ TEST_CASE("[Random] Gaussian random generation")
     REQUIRE(gaussianRandomTest<4>(0.0f, 0.50f, numGenerations, numDivisions, maxAbsErr));
     REQUIRE(gaussianRandomTest<4>(0.0f, 0.75f, numGenerations, numDivisions, maxAbsErr));
 }
+
+TEST_CASE("[Random] Noise generator, uniform")
+{
+    // every size, for the partial blocks of lanes
+    for (size_t size = 1; size <= 9; ++size) {
+        sfz::NoiseGenerator generator { 1234 };
+        std::vector<float> output(size, 2.0f);
+        generator.fillUniform(absl::MakeSpan(output), 1.0f);
+        for (float x : output)
+            REQUIRE((x >= -1.0f && x <= 1.0f));
+    }
+
+    const size_t numGenerations = 4096;
+    const size_t numDivisions = 128;
+    const float bound = 0.5f;
+    sfz::NoiseGenerator generator;
+    std::vector<float> output(numGenerations);
+    generator.fillUniform(absl::MakeSpan(output), bound);
+
+    std::vector<unsigned> counts(numDivisions);
+    for (float x : output) {
+        REQUIRE((x >= -bound && x <= bound));
+        unsigned d = clamp<int>(numDivisions * (x + bound) / (2 * bound), 0, numDivisions - 1);
+        ++counts[d];
+    }
+    for (unsigned count : counts)
+        REQUIRE(count > 0);
+}
+
+TEST_CASE("[Random] Noise generator, gaussian")
+{
+    const size_t numGenerations = 65536;
+
+    for (float variance : { 0.25f, 0.5f }) {
+        sfz::NoiseGenerator generator;
+        std::vector<float> output(numGenerations);
+        generator.fillGaussian(absl::MakeSpan(output), 0.1f, variance);
+
+        double mean = 0.0;
+        for (float x : output)
+            mean += x;
+        mean /= numGenerations;
+
+        double deviation = 0.0;
+        for (float x : output)
+            deviation += squared(x - mean);
+        deviation = std::sqrt(deviation / numGenerations);
+
+        REQUIRE(mean == Approx(0.1).margin(0.01));
+        REQUIRE(deviation == Approx(variance).epsilon(0.02));
+    }
+}
+
+TEST_CASE("[Random] Noise generator, independent blocks")
+{
+    // consecutive blocks and lanes do not repeat each other
+    sfz::NoiseGenerator generator;
+    std::vector<float> first(64);
+    std::vector<float> second(64);
+    generator.fillUniform(absl::MakeSpan(first), 1.0f);
+    generator.fillUniform(absl::MakeSpan(second), 1.0f);
+    REQUIRE(first != second);
+    for (size_t i = 0; i + 1 < first.size(); ++i)
+        REQUIRE(first[i] != first[i + 1]);
+}
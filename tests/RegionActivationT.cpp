@@ -8,6 +8,7 @@
 #include "sfizz/Region.h"
 #include "sfizz/Synth.h"
 #include "sfizz/SfzHelpers.h"
+#include "TestHelpers.h"
 #include "catch2/catch.hpp"
 using namespace Catch::literals;
 using namespace sfz::literals;
@@ -655,3 +656,51 @@ TEST_CASE("[Region activation] Polyphonic aftertouch")
     }
 }
 
+
+TEST_CASE("[Region activation] Velocity layers with key switches")
+{
+    sfz::Synth synth;
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/layers.sfz", R"(
+        <global> key=60 sw_lokey=36 sw_hikey=37 sw_default=36
+        <region> sw_last=36 lovel=1 hivel=63 sample=*sine
+        <region> lovel=100 sample=*noise
+        <region> sw_last=37 lovel=64 sample=*square
+        <region> sw_last=36 lovel=64 sample=*saw
+        <region> sw_last=37 lovel=1 hivel=63 sample=*triangle
+    )");
+    synth.noteOn(0, 60, 50);
+    REQUIRE( activeSamples(synth) == std::vector<std::string> { "*sine" } );
+    synth.allSoundOff();
+    synth.noteOn(0, 60, 110);
+    REQUIRE( activeSamples(synth) == std::vector<std::string> { "*noise", "*saw" } );
+    synth.allSoundOff();
+    synth.noteOn(0, 37, 64);
+    synth.noteOn(0, 60, 110);
+    REQUIRE( activeSamples(synth) == std::vector<std::string> { "*noise", "*square" } );
+    synth.allSoundOff();
+    synth.noteOn(0, 60, 63);
+    REQUIRE( activeSamples(synth) == std::vector<std::string> { "*triangle" } );
+}
+
+TEST_CASE("[Region activation] Round robins count the notes out of their velocity range")
+{
+    sfz::Synth synth;
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/layers.sfz", R"(
+        <group> key=62 seq_length=2
+        <region> seq_position=1 hivel=63 sample=*sine
+        <region> seq_position=2 hivel=63 sample=*saw
+        <region> seq_position=1 lovel=64 sample=*triangle
+        <region> seq_position=2 lovel=64 sample=*square
+    )");
+    synth.noteOn(0, 62, 50);
+    REQUIRE( activeSamples(synth) == std::vector<std::string> { "*sine" } );
+    synth.allSoundOff();
+    synth.noteOn(0, 62, 100);
+    REQUIRE( activeSamples(synth) == std::vector<std::string> { "*square" } );
+    synth.allSoundOff();
+    synth.noteOn(0, 62, 100);
+    REQUIRE( activeSamples(synth) == std::vector<std::string> { "*triangle" } );
+    synth.allSoundOff();
+    synth.noteOn(0, 62, 50);
+    REQUIRE( activeSamples(synth) == std::vector<std::string> { "*saw" } );
+}
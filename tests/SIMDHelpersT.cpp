@@ -12,6 +12,8 @@
 #include <absl/types/span.h>
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <functional>
 #include <iostream>
 #include <jsl/allocator>
 using namespace Catch::literals;
@@ -939,6 +941,75 @@ TEST_CASE("[Helpers] Width tests")
     widthTest<10>(1.0f, 1.0f, -1.0f, 1.0f, 1.0f);
 }
 
+TEST_CASE("[Helpers] Pan and width (SIMD vs scalar)")
+{
+    std::vector<float> envelope(medBufferSize);
+    std::vector<float> left(medBufferSize);
+    std::vector<float> right(medBufferSize);
+    for (size_t i = 0; i < envelope.size(); ++i) {
+        envelope[i] = -1.2f + 2.4f * i / (medBufferSize - 1);
+        left[i] = std::sin(0.1f * i);
+        right[i] = std::cos(0.07f * i);
+    }
+
+    const auto process = [&](sfz::SIMDOps op, bool simd, unsigned offset, std::vector<float>& outLeft, std::vector<float>& outRight) {
+        outLeft = left;
+        outRight = right;
+        const unsigned size = medBufferSize - offset;
+        sfz::setSIMDOpStatus<float>(op, simd);
+        if (op == sfz::SIMDOps::pan)
+            sfz::pan(&envelope[offset], &outLeft[offset], &outRight[offset], size);
+        else
+            sfz::width(&envelope[offset], &outLeft[offset], &outRight[offset], size);
+        sfz::setSIMDOpStatus<float>(op, true);
+    };
+
+    // at all the offsets from the alignment
+    std::vector<float> leftScalar, rightScalar, leftSIMD, rightSIMD;
+    for (sfz::SIMDOps op : { sfz::SIMDOps::pan, sfz::SIMDOps::width }) {
+        for (unsigned offset = 0; offset < 8; ++offset) {
+            process(op, false, offset, leftScalar, rightScalar);
+            sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+            process(op, true, offset, leftSIMD, rightSIMD);
+            REQUIRE( approxEqualMargin<float>(leftScalar, leftSIMD) );
+            REQUIRE( approxEqualMargin<float>(rightScalar, rightSIMD) );
+            sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
+            process(op, true, offset, leftSIMD, rightSIMD);
+            REQUIRE( approxEqualMargin<float>(leftScalar, leftSIMD) );
+            REQUIRE( approxEqualMargin<float>(rightScalar, rightSIMD) );
+        }
+    }
+}
+
+TEST_CASE("[Helpers] Constant pan and width")
+{
+    std::vector<float> envelope(medBufferSize);
+    std::vector<float> left(medBufferSize);
+    std::vector<float> right(medBufferSize);
+    for (size_t i = 0; i < left.size(); ++i) {
+        left[i] = std::sin(0.1f * i);
+        right[i] = std::cos(0.07f * i);
+    }
+
+    for (float value : { -1.0f, -0.3f, 0.0f, 0.5f, 1.0f }) {
+        std::vector<float> leftEnvelope = left;
+        std::vector<float> rightEnvelope = right;
+        std::vector<float> leftConstant = left;
+        std::vector<float> rightConstant = right;
+        sfz::fill<float>(absl::MakeSpan(envelope), value);
+
+        sfz::pan(envelope, absl::MakeSpan(leftEnvelope), absl::MakeSpan(rightEnvelope));
+        sfz::pan1(value, absl::MakeSpan(leftConstant), absl::MakeSpan(rightConstant));
+        REQUIRE( approxEqualMargin<float>(leftEnvelope, leftConstant, 1e-6f) );
+        REQUIRE( approxEqualMargin<float>(rightEnvelope, rightConstant, 1e-6f) );
+
+        sfz::width(envelope, absl::MakeSpan(leftEnvelope), absl::MakeSpan(rightEnvelope));
+        sfz::width1(value, absl::MakeSpan(leftConstant), absl::MakeSpan(rightConstant));
+        REQUIRE( approxEqualMargin<float>(leftEnvelope, leftConstant, 1e-6f) );
+        REQUIRE( approxEqualMargin<float>(rightEnvelope, rightConstant, 1e-6f) );
+    }
+}
+
 TEST_CASE("[Helpers] clampAll")
 {
     std::array<float, 10> inputScalar { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f };
@@ -980,3 +1051,140 @@ TEST_CASE("[Helpers] allWithin")
     REQUIRE( !sfz::allWithin<float>(input, 0.0f, 5.0f) );
     REQUIRE( !sfz::allWithin<float>(input, -1.0f, 7.0f) );
 }
+
+TEST_CASE("[Helpers] exp2")
+{
+    std::vector<float> input(medBufferSize);
+    std::vector<float> expected(medBufferSize);
+    std::vector<float> output(medBufferSize);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = -20.0f + 40.0f * i / (medBufferSize - 1);
+        expected[i] = std::exp2(input[i]);
+    }
+
+    // the relative error of the approximations, at all the offsets from the alignment
+    const auto checkAccuracy = [&]() {
+        for (unsigned offset = 0; offset < 8; ++offset) {
+            const unsigned size = medBufferSize - offset;
+            sfz::exp2<float>(&input[offset], &output[offset], size);
+            for (unsigned i = offset; i < medBufferSize; ++i)
+                REQUIRE( std::abs(output[i] - expected[i]) <= 3e-7f * expected[i] );
+        }
+    };
+
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::exp2, false);
+    checkAccuracy();
+    sfz::setSIMDOpStatus<float>(sfz::SIMDOps::exp2, true);
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+    checkAccuracy();
+    sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
+    checkAccuracy();
+
+    // integer exponents are exact
+    const std::array<float, 6> integers { -12.0f, -1.0f, 0.0f, 1.0f, 2.0f, 12.0f };
+    std::array<float, 6> powers;
+    sfz::exp2<float>(integers, absl::MakeSpan(powers));
+    REQUIRE( powers == std::array<float, 6> { 0x1p-12f, 0.5f, 1.0f, 2.0f, 4.0f, 4096.0f } );
+}
+
+TEST_CASE("[Helpers] AVX vs SSE")
+{
+    if (!sfz::hasSIMDInstructionSet(sfz::SIMDInstructionSet::AVX)
+        || !sfz::hasSIMDInstructionSet(sfz::SIMDInstructionSet::SSE))
+        return;
+
+    // The dispatch is global, so the statuses are restored for the next
+    // tests, also when an assertion fails
+    constexpr int numOps = static_cast<int>(sfz::SIMDOps::_sentinel);
+    struct StatusGuard {
+        std::array<bool, numOps> opStatus;
+        bool avxStatus;
+        StatusGuard()
+        {
+            for (int i = 0; i < numOps; ++i)
+                opStatus[i] = sfz::getSIMDOpStatus<float>(static_cast<sfz::SIMDOps>(i));
+            avxStatus = sfz::getSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX);
+        }
+        ~StatusGuard()
+        {
+            sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, avxStatus);
+            for (int i = 0; i < numOps; ++i)
+                sfz::setSIMDOpStatus<float>(static_cast<sfz::SIMDOps>(i), opStatus[i]);
+        }
+    } statusGuard;
+
+    for (int i = 0; i < numOps; ++i)
+        sfz::setSIMDOpStatus<float>(static_cast<sfz::SIMDOps>(i), true);
+
+    aligned_vector<float> input(medBufferSize + 8);
+    aligned_vector<float> gain(medBufferSize + 8);
+    aligned_vector<float> outputSSE(2 * medBufferSize + 16);
+    aligned_vector<float> outputAVX(2 * medBufferSize + 16);
+    aligned_vector<float> otherSSE(medBufferSize + 8);
+    aligned_vector<float> otherAVX(medBufferSize + 8);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.3f * std::sin(0.1f * i);
+        gain[i] = 1.0f + 0.5f * std::cos(0.07f * i);
+    }
+
+    // Run an operation with both instruction sets, at all the offsets from the alignment
+    auto compare = [&](const std::function<void(unsigned, float*, float*)>& op) {
+        for (unsigned offset = 0; offset < 8; ++offset) {
+            sfz::fill<float>(absl::MakeSpan(outputSSE), fillValue);
+            sfz::fill<float>(absl::MakeSpan(outputAVX), fillValue);
+            sfz::fill<float>(absl::MakeSpan(otherSSE), fillValue);
+            sfz::fill<float>(absl::MakeSpan(otherAVX), fillValue);
+            sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, false);
+            op(offset, outputSSE.data() + offset, otherSSE.data() + offset);
+            sfz::setSIMDInstructionSetStatus<float>(sfz::SIMDInstructionSet::AVX, true);
+            op(offset, outputAVX.data() + offset, otherAVX.data() + offset);
+            REQUIRE( approxEqualMargin<float>(outputSSE, outputAVX) );
+            REQUIRE( approxEqualMargin<float>(otherSSE, otherAVX) );
+        }
+    };
+
+    const unsigned size = medBufferSize;
+    compare([&](unsigned o, float* out, float*) { sfz::applyGain<float>(&gain[o], &input[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::applyGain1<float>(0.7f, &input[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::divide<float>(&input[o], &gain[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::multiplyAdd<float>(&gain[o], &input[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::multiplyAdd1<float>(0.7f, &input[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::multiplyMul<float>(&gain[o], &input[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::multiplyMul1<float>(0.7f, &input[o], out, size); });
+    compare([&](unsigned, float* out, float*) { *out = sfz::linearRamp<float>(out + 1, 0.1f, 0.01f, size); });
+    compare([&](unsigned, float* out, float*) { *out = sfz::multiplicativeRamp<float>(out + 1, 0.1f, 1.01f, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::add<float>(&input[o], out, size); });
+    compare([&](unsigned, float* out, float*) { sfz::add1<float>(0.2f, out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::subtract<float>(&input[o], out, size); });
+    compare([&](unsigned, float* out, float*) { sfz::subtract1<float>(0.2f, out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::copy<float>(&input[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::cumsum<float>(&input[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { sfz::diff<float>(&input[o], out, size); });
+    compare([&](unsigned o, float* out, float*) { *out = sfz::mean<float>(&input[o], size); });
+    compare([&](unsigned o, float* out, float*) { *out = sfz::meanSquared<float>(&input[o], size); });
+    compare([&](unsigned o, float* out, float*) {
+        sfz::copy<float>(&input[o], out, size);
+        sfz::clampAll<float>(out, -0.1f, 0.2f, size);
+    });
+    compare([&](unsigned o, float* out, float*) {
+        out[0] = sfz::allWithin<float>(&input[o], -0.3f, 0.3f, size);
+        out[1] = sfz::allWithin<float>(&input[o], -0.2f, 0.2f, size);
+    });
+    compare([&](unsigned o, float* out, float*) { sfz::exp2<float>(&gain[o], out, size); });
+    compare([&](unsigned o, float* out, float* other) {
+        sfz::copy<float>(&input[o], out, size);
+        sfz::copy<float>(&gain[o], other, size);
+        sfz::pan(&input[o], out, other, size);
+    });
+    compare([&](unsigned o, float* out, float* other) {
+        sfz::copy<float>(&input[o], out, size);
+        sfz::copy<float>(&gain[o], other, size);
+        sfz::width(&input[o], out, other, size);
+    });
+    compare([&](unsigned o, float* out, float* other) {
+        sfz::readInterleaved(&input[o], out, other, size - 1);
+    });
+    compare([&](unsigned o, float* out, float*) {
+        sfz::writeInterleaved(&input[o], &gain[o], out, 2 * (size - 8));
+    });
+}
@@ -14,11 +14,13 @@
 #include "TestHelpers.h"
 #include "catch2/catch.hpp"
 #include <algorithm>
+#include <cmath>
 using namespace Catch::literals;
 using namespace sfz::literals;
 
 // Need these for the introspection of Synth
 #include "sfizz/Effects.h"
+#include "sfizz/SynthConfig.h"
 
 TEST_CASE("[Synth] Play and check active voices")
 {
@@ -398,6 +400,186 @@ TEST_CASE("[Synth] Gain to mix")
     REQUIRE( bus->gainToMix() == 0.5 );
 }
 
+TEST_CASE("[Synth] Effect sends of the regions")
+{
+    sfz::Synth synth;
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/Effects/sends.sfz", R"(
+        <region> key=60 sample=*sine effect1=100 effect2=50
+        <region> key=61 sample=*sine effect1=0
+        <effect> directtomain=0 fx1tomain=100 type=lofi bus=fx1 bitred=90 decim=10
+    )");
+
+    // the bus 2 does not exist
+    const auto& sends = synth.getRegionView(0)->effectSends;
+    REQUIRE( sends.size() == 2 );
+    REQUIRE( sends[0].bus == 0 );
+    REQUIRE( sends[0].gain == 1.0f );
+    REQUIRE( sends[1].bus == 1 );
+    REQUIRE( sends[1].gain == 1.0f );
+
+    const auto& otherSends = synth.getRegionView(1)->effectSends;
+    REQUIRE( otherSends.size() == 1 );
+    REQUIRE( otherSends[0].bus == 0 );
+}
+
+namespace {
+// An effect which passes its input through, and counts its cycles
+class CountingEffect : public sfz::Effect {
+public:
+    explicit CountingEffect(unsigned& count) : count_(count) {}
+    void setSampleRate(double) override {}
+    void setSamplesPerBlock(int) override {}
+    void clear() override {}
+    void process(const float* const inputs[], float* const outputs[], unsigned nframes) override
+    {
+        for (unsigned c = 0; c < sfz::EffectChannels; ++c)
+            std::copy(inputs[c], inputs[c] + nframes, outputs[c]);
+        ++count_;
+    }
+
+private:
+    unsigned& count_;
+};
+} // namespace
+
+TEST_CASE("[Synth] Effect bus stops after its tail")
+{
+    constexpr unsigned blockSize = 100;
+    const unsigned tailBlocks = static_cast<unsigned>(sfz::config::effectBusTailHold);
+
+    unsigned count = 0;
+    sfz::EffectBus bus;
+    bus.addEffect(std::unique_ptr<sfz::Effect>(new CountingEffect(count)));
+    bus.setSamplesPerBlock(blockSize);
+    bus.setSampleRate(blockSize); // one block per second
+    bus.setGainToMain(1.0f);
+    bus.clear();
+
+    sfz::AudioBuffer<float> input { 2, blockSize };
+    sfz::AudioSpan<float>(input).fill(0.5f);
+
+    // idle after a reset
+    bus.clearInputs(blockSize);
+    REQUIRE( bus.isSilent() );
+    bus.process(blockSize);
+    REQUIRE( count == 0 );
+
+    bus.clearInputs(blockSize);
+    bus.addToInputs(sfz::AudioSpan<float>(input), 1.0f, blockSize);
+    REQUIRE( bus.hasInput() );
+    REQUIRE( !bus.isSilent() );
+    bus.process(blockSize);
+    REQUIRE( count == 1 );
+
+    // the tail runs for a while without input
+    for (unsigned i = 0; i < 2 * tailBlocks; ++i) {
+        bus.clearInputs(blockSize);
+        bus.process(blockSize);
+    }
+    REQUIRE( count == 1 + tailBlocks );
+    REQUIRE( bus.isSilent() );
+
+    // the input resumes the processing
+    bus.clearInputs(blockSize);
+    bus.addToInputs(sfz::AudioSpan<float>(input), 0.5f, blockSize);
+    bus.process(blockSize);
+    REQUIRE( count == 2 + tailBlocks );
+}
+
+TEST_CASE("[Synth] Filter submixes of the regions")
+{
+    sfz::Synth synth;
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/filter_submix.sfz", R"(
+        <group> fil_type=lpf_2p cutoff=800 resonance=6 eq1_freq=2000 eq1_gain=6
+        <region> key=60 sample=*saw pan=-50
+        <region> key=62 sample=stereo_sample.wav
+        <region> key=64 sample=*saw oscillator_multi=3 pan_oncc10=50
+        <region> key=65 sample=*saw fil_keytrack=100
+        <region> key=66 sample=*saw cutoff_oncc20=1200
+        <region> key=67 sample=*saw eq1_vel2gain=10
+        <region> key=68 sample=*saw pan_oncc10=50
+        <region> key=69 sample=*saw cutoff=1000
+        <region> key=70 sample=*saw cutoff=1000 effect1=50
+        <region> key=71 sample=*saw fil_type=none eq1_gain=0
+    )");
+
+    // the same static filters share a submix, the stereo panning after the
+    // filters does not matter
+    REQUIRE( synth.getRegionView(0)->filterSubmix == 0u );
+    REQUIRE( synth.getRegionView(1)->filterSubmix == 0u );
+    REQUIRE( synth.getRegionView(2)->filterSubmix == 0u );
+    // the filters depend on the note or are modulated
+    REQUIRE( !synth.getRegionView(3)->filterSubmix );
+    REQUIRE( !synth.getRegionView(4)->filterSubmix );
+    REQUIRE( !synth.getRegionView(5)->filterSubmix );
+    // the mono panning after the filters is modulated
+    REQUIRE( !synth.getRegionView(6)->filterSubmix );
+    // different filters, while the sends to a missing bus do not matter
+    REQUIRE( synth.getRegionView(7)->filterSubmix == 1u );
+    REQUIRE( synth.getRegionView(8)->filterSubmix == 1u );
+    REQUIRE( synth.getRegionView(9)->filterSubmix == 2u );
+}
+
+TEST_CASE("[Synth] Filter submixes render like the voice filters")
+{
+    constexpr unsigned blockSize = 256;
+    constexpr unsigned numBlocks = 200;
+
+    sfz::Synth synthShared;
+    sfz::Synth synthPerVoice;
+    synthPerVoice.getResources().getSynthConfig().filterSubmixes = false;
+
+    for (sfz::Synth* synth : { &synthShared, &synthPerVoice }) {
+        synth->setSamplesPerBlock(blockSize);
+        synth->loadSfzString(fs::current_path() / "tests/TestFiles/filter_submix.sfz", R"(
+            <group> fil_type=lpf_2p cutoff=800 resonance=6 eq1_freq=2000 eq1_gain=6
+                    ampeg_attack=0.01 ampeg_release=0.1
+            <region> key=60 sample=*saw pan=-50
+            <region> key=62 sample=stereo_sample.wav
+            <region> key=64 sample=*saw oscillator_multi=3 pan_oncc10=50
+            <region> key=65 sample=*saw fil_keytrack=100
+        )");
+        REQUIRE( synth->getRegionView(0)->filterSubmix == 0u );
+    }
+
+    sfz::AudioBuffer<float> bufferShared { 2, blockSize };
+    sfz::AudioBuffer<float> bufferPerVoice { 2, blockSize };
+    float maxDifference = 0.0f;
+    float maxLevel = 0.0f;
+
+    for (unsigned b = 0; b < numBlocks; ++b) {
+        for (sfz::Synth* synth : { &synthShared, &synthPerVoice }) {
+            switch (b) {
+            case 0: synth->noteOn(0, 60, 100); break;
+            case 10: synth->noteOn(10, 62, 80); break;
+            case 20: synth->noteOn(20, 64, 90); synth->noteOn(30, 65, 90); break;
+            case 30: synth->cc(40, 10, 64); break;
+            case 50: synth->noteOff(0, 60, 0); break;
+            case 60: synth->noteOn(50, 60, 60); break;
+            case 100:
+                for (int note : { 60, 62, 64, 65 })
+                    synth->noteOff(0, note, 0);
+                break;
+            }
+        }
+
+        synthShared.renderBlock(bufferShared);
+        synthPerVoice.renderBlock(bufferPerVoice);
+
+        for (unsigned c = 0; c < 2; ++c) {
+            for (unsigned i = 0; i < blockSize; ++i) {
+                const float shared = bufferShared.getSpan(c)[i];
+                const float perVoice = bufferPerVoice.getSpan(c)[i];
+                maxDifference = std::max(maxDifference, std::abs(shared - perVoice));
+                maxLevel = std::max(maxLevel, std::abs(perVoice));
+            }
+        }
+    }
+
+    REQUIRE( maxLevel > 0.1f );
+    REQUIRE( maxDifference < 1e-4f );
+}
+
 TEST_CASE("[Synth] Basic curves")
 {
     sfz::Synth synth;
@@ -597,6 +779,49 @@ TEST_CASE("[Synth] Sisters and off-by")
     REQUIRE( sfz::SisterVoiceRing::countSisterVoices(synth.getVoiceView(0)) == 1 );
 }
 
+TEST_CASE("[Synth] Note-off, pedal and off-by events reach the voices they concern")
+{
+    sfz::Synth synth;
+    sfz::AudioBuffer<float> buffer { 2, static_cast<unsigned>(synth.getSamplesPerBlock()) };
+    synth.loadSfzString(fs::current_path() / "tests/TestFiles/event_indexes.sfz", R"(
+        <region> key=60 sample=*sine
+        <region> key=62 sample=*sine sustain_cc=54
+        <group> group=1 off_by=2 <region> key=64 sample=*sine
+        <group> group=3 off_by=2 <region> key=65 sample=*sine
+        <group> group=2 <region> key=66 sample=*sine
+    )");
+    for (int note : { 60, 62, 64, 65 })
+        synth.noteOn(0, note, 85);
+    synth.renderBlock(buffer);
+    REQUIRE( numPlayingVoices(synth) == 4 );
+
+    // only the voice of the note is released
+    synth.noteOff(0, 60, 85);
+    synth.renderBlock(buffer);
+    REQUIRE( numPlayingVoices(synth) == 3 );
+    REQUIRE( playingSamples(synth) == std::vector<std::string> { "*sine", "*sine", "*sine" } );
+
+    // the pedal of the region holds the note
+    synth.cc(0, 64, 127);
+    synth.cc(0, 54, 127);
+    synth.noteOff(0, 62, 85);
+    synth.renderBlock(buffer);
+    REQUIRE( numPlayingVoices(synth) == 3 );
+
+    // both voices turned off by the group
+    synth.noteOn(0, 66, 85);
+    synth.renderBlock(buffer);
+    REQUIRE( numPlayingVoices(synth) == 2 );
+
+    // the other pedal does not concern the voice
+    synth.cc(0, 64, 0);
+    synth.renderBlock(buffer);
+    REQUIRE( numPlayingVoices(synth) == 2 );
+    synth.cc(0, 54, 0);
+    synth.renderBlock(buffer);
+    REQUIRE( numPlayingVoices(synth) == 1 );
+}
+
 TEST_CASE("[Synth] Release (basic behavior with sample)")
 {
     sfz::Synth synth;
@@ -1917,3 +2142,97 @@ TEST_CASE("[Synth] Sequences also work on cc triggers")
     synth.renderBlock(buffer);
     REQUIRE( playingSamples(synth) == std::vector<std::string> { "*sine", "*saw", "*sine" } );
 }
+
+TEST_CASE("[Synth] Rendering voices on several threads matches the serial rendering")
+{
+    const std::string sfzText = R"(
+        <effect> bus=fx1 type=lofi bitred=50
+        <region> sample=*sine key=60 amplitude_oncc20=50 pan=-30
+        <region> sample=*saw key=60 lfo1_freq=3 lfo1_pitch=50 effect1=40
+        <region> sample=*triangle key=62 fil_type=lpf_2p cutoff=800 cutoff_oncc20=1200
+        <region> sample=*square key=64 egamp_attack=0.01 egamp_release=0.05
+        <region> sample=*sine lokey=65 hikey=72 width=50 position=20
+    )";
+
+    constexpr size_t blockSize { 256 };
+    sfz::Synth serialSynth;
+    sfz::Synth parallelSynth;
+    parallelSynth.setNumRenderThreads(4);
+    REQUIRE( parallelSynth.getNumRenderThreads() == 4 );
+
+    for (sfz::Synth* synth : { &serialSynth, &parallelSynth }) {
+        synth->setSamplesPerBlock(blockSize);
+        synth->loadSfzString(fs::current_path() / "tests/TestFiles/parallel_render.sfz", sfzText);
+    }
+
+    sfz::AudioBuffer<float> serialBuffer { 2, blockSize };
+    sfz::AudioBuffer<float> parallelBuffer { 2, blockSize };
+
+    for (unsigned block = 0; block < 16; ++block) {
+        for (sfz::Synth* synth : { &serialSynth, &parallelSynth }) {
+            if (block == 0) {
+                for (int note : { 60, 62, 64, 65, 67, 69, 71 })
+                    synth->noteOn(note, note, 100);
+            }
+            if (block == 4)
+                synth->cc(10, 20, 90);
+            if (block == 8) {
+                synth->noteOff(0, 64, 0);
+                synth->noteOff(5, 67, 0);
+            }
+        }
+
+        serialSynth.renderBlock(serialBuffer);
+        parallelSynth.renderBlock(parallelBuffer);
+        REQUIRE( serialSynth.getNumActiveVoices() == parallelSynth.getNumActiveVoices() );
+
+        for (size_t c = 0; c < 2; ++c) {
+            absl::Span<const float> serial = serialBuffer.getConstSpan(c);
+            absl::Span<const float> parallel = parallelBuffer.getConstSpan(c);
+            for (size_t i = 0; i < blockSize; ++i)
+                REQUIRE( parallel[i] == Approx(serial[i]).margin(1e-5) );
+        }
+    }
+}
+
+TEST_CASE("[Synth] Exact pitch ratios render the same at any sample quality")
+{
+    const std::string sfzText = R"(
+        <region> sample=kick.wav key=60
+        <region> sample=kick.wav key=72 pitch_keycenter=60
+    )";
+
+    constexpr size_t blockSize { 256 };
+    sfz::Synth linearSynth;
+    sfz::Synth sincSynth;
+    linearSynth.setSampleQuality(sfz::Synth::ProcessLive, 1);
+    sincSynth.setSampleQuality(sfz::Synth::ProcessLive, 10);
+
+    for (sfz::Synth* synth : { &linearSynth, &sincSynth }) {
+        synth->setSampleRate(44100);
+        synth->setSamplesPerBlock(blockSize);
+        synth->loadSfzString(fs::current_path() / "tests/TestFiles/exact_pitch.sfz", sfzText);
+    }
+
+    sfz::AudioBuffer<float> linearBuffer { 2, blockSize };
+    sfz::AudioBuffer<float> sincBuffer { 2, blockSize };
+
+    for (int note : { 60, 72 }) {
+        for (sfz::Synth* synth : { &linearSynth, &sincSynth })
+            synth->noteOn(0, note, 100);
+
+        for (unsigned block = 0; block < 8; ++block) {
+            linearSynth.renderBlock(linearBuffer);
+            sincSynth.renderBlock(sincBuffer);
+            for (size_t c = 0; c < 2; ++c) {
+                absl::Span<const float> linear = linearBuffer.getConstSpan(c);
+                absl::Span<const float> sinc = sincBuffer.getConstSpan(c);
+                for (size_t i = 0; i < blockSize; ++i)
+                    REQUIRE( sinc[i] == linear[i] );
+            }
+        }
+
+        for (sfz::Synth* synth : { &linearSynth, &sincSynth })
+            synth->allSoundOff();
+    }
+}
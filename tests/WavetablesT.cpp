@@ -7,9 +7,11 @@
 #include "sfizz/Wavetables.h"
 #include "sfizz/FileMetadata.h"
 #include "sfizz/MathHelpers.h"
+#include "sfizz/SfzHelpers.h"
 #include "catch2/catch.hpp"
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 TEST_CASE("[Wavetables] Frequency ranges")
 {
@@ -79,3 +81,71 @@ TEST_CASE("[Wavetables] Non-wavetable sound files")
     REQUIRE(reader.open("tests/TestFiles/snare.wav"));
     REQUIRE(!reader.extractWavetableInfo(wt));
 }
+
+TEST_CASE("[Wavetables] Unison against single oscillators")
+{
+    constexpr float sampleRate = 44100.0f;
+    constexpr unsigned numFrames = 1031;
+    constexpr unsigned unisonSize = 7;
+
+    const sfz::WavetableMulti* wave = sfz::WavetablePool::getWaveSaw();
+
+    std::vector<float> frequencies(numFrames);
+    std::vector<float> commonRatios(numFrames);
+    for (unsigned i = 0; i < numFrames; ++i) {
+        frequencies[i] = 220.0f * std::exp2(std::sin(0.003f * i));
+        commonRatios[i] = sfz::centsFactor(30.0f * std::sin(0.01f * i));
+    }
+
+    float detuneRatios[unisonSize];
+    float leftGains[unisonSize];
+    float rightGains[unisonSize];
+    for (unsigned u = 0; u < unisonSize; ++u) {
+        detuneRatios[u] = sfz::centsFactor(7.0f * u - 20.0f);
+        leftGains[u] = 1.0f - u / float(unisonSize);
+        rightGains[u] = u / float(unisonSize);
+    }
+
+    for (int quality = 0; quality <= 3; ++quality) {
+        for (bool modulated : { false, true }) {
+            sfz::WavetableUnison unison;
+            unison.init(sampleRate);
+            unison.setWavetable(wave);
+            unison.setPhase(0.25f);
+            unison.setQuality(quality);
+            unison.resize(unisonSize);
+            for (unsigned u = 0; u < unisonSize; ++u) {
+                unison.setDetuneRatio(u, detuneRatios[u]);
+                unison.setGains(u, leftGains[u], rightGains[u]);
+            }
+
+            std::vector<float> left(numFrames);
+            std::vector<float> right(numFrames);
+            unison.processModulated(frequencies.data(), modulated ? commonRatios.data() : nullptr, left.data(), right.data(), numFrames);
+
+            std::vector<float> expectedLeft(numFrames);
+            std::vector<float> expectedRight(numFrames);
+            std::vector<float> ratios(numFrames);
+            std::vector<float> output(numFrames);
+            for (unsigned u = 0; u < unisonSize; ++u) {
+                sfz::WavetableOscillator osc;
+                osc.init(sampleRate);
+                osc.setWavetable(wave);
+                osc.setPhase(0.25f);
+                osc.setQuality(quality);
+                for (unsigned i = 0; i < numFrames; ++i)
+                    ratios[i] = detuneRatios[u] * (modulated ? commonRatios[i] : 1.0f);
+                osc.processModulated(frequencies.data(), ratios.data(), output.data(), numFrames);
+                for (unsigned i = 0; i < numFrames; ++i) {
+                    expectedLeft[i] += leftGains[u] * output[i];
+                    expectedRight[i] += rightGains[u] * output[i];
+                }
+            }
+
+            for (unsigned i = 0; i < numFrames; ++i) {
+                REQUIRE( left[i] == Approx(expectedLeft[i]).margin(1e-4) );
+                REQUIRE( right[i] == Approx(expectedRight[i]).margin(1e-4) );
+            }
+        }
+    }
+}